@@ -86,6 +86,9 @@ void update_fan_speed(bool notify_smcs)
 		if (notify_smcs) {
 			/* Broadcast final speed to all SMCs for telemetry */
 			ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
+				if (chip->data.bringup_failed) {
+					continue;
+				}
 				bharc_smbus_word_data_write(&chip->config.arc, CMFW_SMBUS_FAN_SPEED,
 							    fan_speed);
 			}
@@ -251,7 +254,9 @@ void ina228_power_update(void)
 	int16_t power = sensor_val.val1 & 0xFFFF;
 
 	ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-		bh_chip_set_input_power(chip, power);
+		if (!chip->data.bringup_failed) {
+			bh_chip_set_input_power(chip, power);
+		}
 	}
 }
 
@@ -448,9 +453,16 @@ static void handle_perst(void)
 			bh_chip_cancel_bus_transfer_clear(chip);
 
 			bharc_disable_i2cbus(&chip->config.arc);
-			jtag_bootrom_reset_asic(chip);
-			jtag_bootrom_soft_reset_arc(chip);
-			jtag_bootrom_teardown(chip);
+			if (chip->data.bringup_failed) {
+				/* A chip that failed to come up has no bootcode to restart, so run
+				 * the whole sequence again. Its result sets bringup_failed.
+				 */
+				jtag_bootrom_reset_sequence(chip, true);
+			} else {
+				jtag_bootrom_reset_asic(chip);
+				jtag_bootrom_soft_reset_arc(chip);
+				jtag_bootrom_teardown(chip);
+			}
 			bharc_enable_i2cbus(&chip->config.arc);
 
 			/*
@@ -477,7 +489,7 @@ static void handle_pgood_change(void)
 static void send_init_data(void)
 {
 	ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-		if (chip->data.arc_needs_init_msg) {
+		if (chip->data.arc_needs_init_msg && !chip->data.bringup_failed) {
 			if (bh_chip_set_static_info(chip, &static_info) == 0 &&
 			    bh_chip_set_input_power_lim(chip, max_power) == 0 &&
 			    bh_chip_set_therm_trip_count(chip, chip->data.therm_trip_count) == 0 &&
@@ -507,7 +519,9 @@ static void fan_rpm_feedback(void)
 		rpm = (uint16_t)data.val1;
 
 		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-			bh_chip_set_fan_rpm(chip, rpm);
+			if (!chip->data.bringup_failed) {
+				bh_chip_set_fan_rpm(chip, rpm);
+			}
 		}
 	}
 }
@@ -515,7 +529,9 @@ static void fan_rpm_feedback(void)
 static void handle_cm2dm_messages(void)
 {
 	ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-		process_cm2dm_message(chip);
+		if (!chip->data.bringup_failed) {
+			process_cm2dm_message(chip);
+		}
 	}
 }
 
@@ -524,6 +540,11 @@ static void send_logs_to_smc(void)
 	uint8_t *log_data;
 	int ret;
 
+	/* The logs stay in the ring buffer until the chip they go to is up */
+	if (BH_CHIPS[BH_CHIP_PRIMARY_INDEX].data.bringup_failed) {
+		return;
+	}
+
 	/* Pull up to 32 bytes from the ringbuf log backend */
 	ret = log_backend_ringbuf_get_claim(&log_data, 32);
 	if (ret > 0) {
@@ -538,6 +559,23 @@ static void send_logs_to_smc(void)
 	}
 }
 
+/* Get every chip ready for its reset sequence, with the I2C bus to its ARC disabled */
+static int bootrom_init_chips(void)
+{
+	ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
+		int ret = jtag_bootrom_init(chip);
+
+		if (ret != 0) {
+			LOG_ERR("%s() failed: %d", "jtag_bootrom_init", ret);
+			return ret;
+		}
+
+		bharc_disable_i2cbus(&chip->config.arc);
+	}
+
+	return 0;
+}
+
 static void shared_20ms_expired(struct k_timer *timer)
 {
 	ARG_UNUSED(timer);
@@ -608,26 +646,36 @@ int main(void)
 	}
 
 	if (IS_ENABLED(CONFIG_JTAG_LOAD_BOOTROM)) {
-		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
-			ret = jtag_bootrom_init(chip);
-			if (ret != 0) {
-				LOG_ERR("%s() failed: %d", "jtag_bootrom_init", ret);
-				return ret;
-			}
+		ret = bootrom_init_chips();
+		if (ret != 0) {
+			return ret;
+		}
 
+		/* A chip that fails to come up is logged and marked, and the others carry on */
+		if (IS_ENABLED(CONFIG_JTAG_PARALLEL_BRINGUP)) {
+			int rets[BH_CHIP_COUNT];
 
-			bharc_disable_i2cbus(&chip->config.arc);
+			ret = jtag_bootrom_reset_sequence_all(BH_CHIPS, BH_CHIP_COUNT, false, rets);
+		} else {
+			ret = 0;
+			ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
+				int chip_ret = jtag_bootrom_reset_sequence(chip, false);
 
-			ret = jtag_bootrom_reset_sequence(chip, false);
-			/* Always enable I2C bus */
-			bharc_enable_i2cbus(&chip->config.arc);
-			if (ret != 0) {
-				LOG_ERR("%s() failed: %d", "jtag_bootrom_reset", ret);
-				return ret;
+				if (chip_ret != 0) {
+					LOG_ERR("%s() failed: %d", "jtag_bootrom_reset", chip_ret);
+					ret = (ret != 0) ? ret : chip_ret;
+				}
 			}
 		}
 
-		LOG_DBG("Bootrom workaround successfully applied");
+		/* Always enable I2C bus */
+		ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
+			bharc_enable_i2cbus(&chip->config.arc);
+		}
+
+		if (ret == 0) {
+			LOG_DBG("Bootrom workaround successfully applied");
+		}
 	}
 
 	ARRAY_FOR_EACH_PTR(BH_CHIPS, chip) {
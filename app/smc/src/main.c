@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "boot_stage.h"
 #include "cm2dm_msg.h"
 #include "dvfs.h"
 #include "fan_ctrl.h"
@@ -152,7 +153,9 @@ static int bh_arc_init_end(void)
 	} else {
 		boot_status0.f.fw_id = FW_ID_SMC_NORMAL;
 	}
-	boot_status0.f.hw_init_status = (tt_init_status == 0) ? kHwInitDone : kHwInitError;
+	/* Every other boot stage has finished, as this one depends on all of them */
+	boot_status0.f.hw_init_status =
+		(tt_init_status == 0 && GetFailedBootStages() == 0) ? kHwInitDone : kHwInitError;
 	WriteReg(STATUS_BOOT_STATUS0_REG_ADDR, boot_status0.val);
 	WriteReg(STATUS_ERROR_STATUS0_REG_ADDR, error_status0.val);
 
@@ -18,6 +18,12 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(clock_control_tt_bh);
 
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
 #define PLL_LOCK_TIMEOUT_MS 400
 
 #define PLL_CNTL_0_OFFSET             0x00
@@ -48,6 +54,15 @@ LOG_MODULE_REGISTER(clock_control_tt_bh);
 #define PLL_CNTL_WRAPPER_PLL_LOCK_REG_ADDR      0x80020040
 #define PLL_CNTL_WRAPPER_REFCLK_PERIOD_REG_ADDR 0x8002002C
 
+/* Columns of a glide-table entry */
+#define GLIDE_MAX_FBDIV      0
+#define GLIDE_MAX_STEP       1
+#define GLIDE_SETTLE_NS      2
+#define GLIDE_ENTRY_SIZE     3
+
+/* Settle time an asynchronous glide may spend before it yields to other work */
+#define GLIDE_WORK_BUDGET_NS 10000
+
 struct tt_bh_pll_cntl_wrapper_lock_fields {
 	uint32_t pll0_lock: 1;
 	uint32_t pll1_lock: 1;
@@ -153,14 +168,30 @@ struct clock_control_tt_bh_config {
 	size_t size;
 
 	struct tt_bh_pll_settings init_settings;
+
+	/* fbdiv glide characterisation, see the glide-table binding property */
+	const uint32_t *glide_table;
+	size_t glide_table_len;
 };
 
 struct clock_control_tt_bh_data {
 	struct tt_bh_pll_settings settings;
 
 	struct k_spinlock lock;
+	/* A glide is in progress with the lock released between steps */
+	bool gliding;
+	/* The glide was started by clock_control_tt_bh_set_rate_async(), which may retarget it */
+	bool glide_async;
+	uint32_t glide_target; /* fbdiv */
+	clock_control_tt_bh_rate_cb_t glide_cb;
+	void *glide_user_data;
+	struct k_work glide_work;
+	const struct device *dev;
 };
 
+/* Used without a glide-table: one fbdiv unit at a time, 100 ns apart */
+static const uint32_t clock_control_tt_bh_default_glide[GLIDE_ENTRY_SIZE] = {UINT16_MAX, 1, 100};
+
 static uint32_t clock_control_tt_bh_read_reg(const struct clock_control_tt_bh_config *config,
 					     uint32_t offset)
 {
@@ -461,6 +492,173 @@ static enum clock_control_status clock_control_tt_bh_get_status(const struct dev
 	return CLOCK_CONTROL_STATUS_UNKNOWN;
 }
 
+/* The glide-table entry covering fbdiv, which is the first one whose limit is not below it */
+static const uint32_t *
+clock_control_tt_bh_glide_entry(const struct clock_control_tt_bh_config *config, uint32_t fbdiv)
+{
+	const uint32_t *entry = clock_control_tt_bh_default_glide;
+
+	for (size_t i = 0; i < config->glide_table_len; i += GLIDE_ENTRY_SIZE) {
+		entry = &config->glide_table[i];
+		if (fbdiv <= entry[GLIDE_MAX_FBDIV]) {
+			break;
+		}
+	}
+
+	return entry;
+}
+
+/* Plan the next fbdiv on the way from fbdiv to target, as far as the characterisation allows, and
+ * how long the PLL has to settle after it. A step is limited by the entry of the higher of its
+ * two fbdivs.
+ */
+STATIC uint32_t clock_control_tt_bh_glide_step(const struct clock_control_tt_bh_config *config,
+					       uint32_t fbdiv, uint32_t target, uint32_t *settle_ns)
+{
+	const uint32_t *entry = clock_control_tt_bh_glide_entry(config, fbdiv);
+	uint32_t next;
+
+	if (target < fbdiv) {
+		next = fbdiv - MIN(entry[GLIDE_MAX_STEP], fbdiv - target);
+	} else {
+		next = fbdiv + MIN(entry[GLIDE_MAX_STEP], target - fbdiv);
+		/* Stepping up into a range with smaller steps is limited by that range */
+		for (entry = clock_control_tt_bh_glide_entry(config, next);
+		     next - fbdiv > entry[GLIDE_MAX_STEP];
+		     entry = clock_control_tt_bh_glide_entry(config, next)) {
+			next = fbdiv + entry[GLIDE_MAX_STEP];
+		}
+	}
+
+	*settle_ns = entry[GLIDE_SETTLE_NS];
+	return next;
+}
+
+/* AICLK fbdiv for rate, with the current dividers */
+static uint32_t clock_control_tt_bh_aiclk_fbdiv(const struct clock_control_tt_bh_config *config,
+						uint32_t rate)
+{
+	union tt_bh_pll_cntl_1_reg pll_cntl_1;
+	union tt_bh_pll_cntl_5_reg pll_cntl_5;
+	union tt_bh_pll_use_postdiv_reg use_postdiv;
+
+	pll_cntl_1.val = clock_control_tt_bh_read_reg(config, PLL_CNTL_1_OFFSET);
+	pll_cntl_5.val = clock_control_tt_bh_read_reg(config, PLL_CNTL_5_OFFSET);
+	use_postdiv.val = clock_control_tt_bh_read_reg(config, PLL_USE_POSTDIV_OFFSET);
+
+	return clock_control_tt_bh_calculate_fbdiv(config->refclk_rate, rate, pll_cntl_1,
+						   pll_cntl_5, use_postdiv, 0);
+}
+
+/* Glide AICLK toward data->glide_target until it is reached or budget_ns of settle time has been
+ * spent, and return whether it was reached. Called with data->lock held, which is released while
+ * the PLL settles, so the target may change along the way.
+ */
+static bool clock_control_tt_bh_glide(const struct clock_control_tt_bh_config *config,
+				      struct clock_control_tt_bh_data *data, k_spinlock_key_t *key,
+				      uint32_t budget_ns)
+{
+	union tt_bh_pll_cntl_1_reg pll_cntl_1;
+	uint32_t spent_ns = 0;
+
+	pll_cntl_1.val = clock_control_tt_bh_read_reg(config, PLL_CNTL_1_OFFSET);
+
+	while (pll_cntl_1.f.fbdiv != data->glide_target && spent_ns < budget_ns) {
+		uint32_t settle_ns;
+
+		pll_cntl_1.f.fbdiv = clock_control_tt_bh_glide_step(config, pll_cntl_1.f.fbdiv,
+								    data->glide_target, &settle_ns);
+		clock_control_tt_bh_write_reg(config, PLL_CNTL_1_OFFSET, pll_cntl_1.val);
+
+		k_spin_unlock(&data->lock, *key);
+		k_busy_wait_ns(settle_ns);
+		*key = k_spin_lock(&data->lock);
+		spent_ns += settle_ns;
+	}
+
+	return pll_cntl_1.f.fbdiv == data->glide_target;
+}
+
+static void clock_control_tt_bh_glide_work(struct k_work *work)
+{
+	struct clock_control_tt_bh_data *data =
+		CONTAINER_OF(work, struct clock_control_tt_bh_data, glide_work);
+	const struct device *dev = data->dev;
+	clock_control_tt_bh_rate_cb_t cb = NULL;
+	void *user_data = NULL;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&data->lock);
+
+	if (clock_control_tt_bh_glide(dev->config, data, &key, GLIDE_WORK_BUDGET_NS)) {
+		cb = data->glide_cb;
+		user_data = data->glide_user_data;
+		data->glide_cb = NULL;
+		data->gliding = false;
+		data->glide_async = false;
+	} else {
+		/* Let other work, which may retarget the glide, run before the next steps */
+		k_work_submit(&data->glide_work);
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	if (cb != NULL) {
+		cb(dev, 0, user_data);
+	}
+}
+
+int clock_control_tt_bh_set_rate_async(const struct device *dev, clock_control_subsys_t sys,
+				       clock_control_subsys_rate_t rate,
+				       clock_control_tt_bh_rate_cb_t cb, void *user_data)
+{
+	const struct clock_control_tt_bh_config *config =
+		(const struct clock_control_tt_bh_config *)dev->config;
+	struct clock_control_tt_bh_data *data = (struct clock_control_tt_bh_data *)dev->data;
+	enum clock_control_tt_bh_clock clock = (enum clock_control_tt_bh_clock)(uintptr_t)sys;
+	clock_control_tt_bh_rate_cb_t stale_cb;
+	void *stale_user_data;
+	uint32_t target_fbdiv;
+	k_spinlock_key_t key;
+
+	if (clock != CLOCK_CONTROL_TT_BH_CLOCK_AICLK) {
+		return -ENOTSUP;
+	}
+
+	key = k_spin_lock(&data->lock);
+
+	if (data->gliding && !data->glide_async) {
+		k_spin_unlock(&data->lock, key);
+		return -EBUSY;
+	}
+
+	target_fbdiv = clock_control_tt_bh_aiclk_fbdiv(config, (uint32_t)rate);
+	if (target_fbdiv == 0) {
+		k_spin_unlock(&data->lock, key);
+		return -EINVAL;
+	}
+
+	/* A glide in progress turns toward the new target without finishing the old one */
+	stale_cb = data->glide_cb;
+	stale_user_data = data->glide_user_data;
+	data->glide_target = target_fbdiv;
+	data->glide_cb = cb;
+	data->glide_user_data = user_data;
+	if (!data->gliding) {
+		data->gliding = true;
+		data->glide_async = true;
+		k_work_submit(&data->glide_work);
+	}
+
+	k_spin_unlock(&data->lock, key);
+
+	if (stale_cb != NULL) {
+		stale_cb(dev, -ECANCELED, stale_user_data);
+	}
+
+	return 0;
+}
+
 static int clock_control_tt_bh_set_rate(const struct device *dev, clock_control_subsys_t sys,
 					clock_control_subsys_rate_t rate)
 {
@@ -473,6 +671,11 @@ static int clock_control_tt_bh_set_rate(const struct device *dev, clock_control_
 		return -EBUSY;
 	}
 
+	if (data->gliding) {
+		k_spin_unlock(&data->lock, key);
+		return -EBUSY;
+	}
+
 	enum clock_control_tt_bh_clock clock = (enum clock_control_tt_bh_clock)(uintptr_t)sys;
 
 	if (clock == CLOCK_CONTROL_TT_BH_CLOCK_GDDRMEMCLK) {
@@ -495,28 +698,18 @@ static int clock_control_tt_bh_set_rate(const struct device *dev, clock_control_
 
 		clock_control_tt_bh_update(config, data, &settings);
 	} else if (clock == CLOCK_CONTROL_TT_BH_CLOCK_AICLK) {
-		uint32_t target_fbdiv;
-		union tt_bh_pll_cntl_1_reg pll_cntl_1;
-		union tt_bh_pll_cntl_5_reg pll_cntl_5;
-		union tt_bh_pll_use_postdiv_reg use_postdiv;
-
-		pll_cntl_1.val = clock_control_tt_bh_read_reg(config, PLL_CNTL_1_OFFSET);
-		pll_cntl_5.val = clock_control_tt_bh_read_reg(config, PLL_CNTL_5_OFFSET);
-		use_postdiv.val = clock_control_tt_bh_read_reg(config, PLL_USE_POSTDIV_OFFSET);
-		target_fbdiv =
-			clock_control_tt_bh_calculate_fbdiv(config->refclk_rate, (uint32_t)rate,
-							    pll_cntl_1, pll_cntl_5, use_postdiv, 0);
-
-		while (pll_cntl_1.f.fbdiv != target_fbdiv) {
-			if (target_fbdiv > pll_cntl_1.f.fbdiv) {
-				pll_cntl_1.f.fbdiv += 1;
-			} else {
-				pll_cntl_1.f.fbdiv -= 1;
-			}
-
-			clock_control_tt_bh_write_reg(config, PLL_CNTL_1_OFFSET, pll_cntl_1.val);
-			k_busy_wait_ns(100);
+		uint32_t target_fbdiv = clock_control_tt_bh_aiclk_fbdiv(config, (uint32_t)rate);
+
+		if (target_fbdiv == 0) {
+			k_spin_unlock(&data->lock, key);
+			return -EINVAL;
 		}
+
+		/* Settle without the lock, so that rates can be read during the glide */
+		data->gliding = true;
+		data->glide_target = target_fbdiv;
+		clock_control_tt_bh_glide(config, data, &key, UINT32_MAX);
+		data->gliding = false;
 	} else if (clock == CLOCK_CONTROL_TT_BH_INIT_STATE) {
 		struct tt_bh_pll_settings settings = config->init_settings;
 
@@ -543,6 +736,11 @@ static int clock_control_tt_bh_configure(const struct device *dev, clock_control
 		return -EBUSY;
 	}
 
+	if (data->gliding) {
+		k_spin_unlock(&data->lock, key);
+		return -EBUSY;
+	}
+
 	if ((enum clock_control_tt_bh_clock_config)option == CLOCK_CONTROL_TT_BH_CONFIG_BYPASS) {
 		/* No need to bypass refclk as it's not support */
 
@@ -575,11 +773,26 @@ static int clock_control_tt_bh_init(const struct device *dev)
 	k_spinlock_key_t key;
 	int ret;
 
+	for (size_t i = 0; i < config->glide_table_len; i += GLIDE_ENTRY_SIZE) {
+		const uint32_t *entry = &config->glide_table[i];
+		const uint32_t *prev = entry - GLIDE_ENTRY_SIZE;
+
+		/* Steps must make progress, and limits must be ascending */
+		if (entry[GLIDE_MAX_STEP] == 0 ||
+		    (i > 0 && entry[GLIDE_MAX_FBDIV] <= prev[GLIDE_MAX_FBDIV])) {
+			LOG_ERR("PLL %d has an invalid glide-table entry %zu", config->inst,
+				i / GLIDE_ENTRY_SIZE);
+			return -EINVAL;
+		}
+	}
+
 	if (k_spin_trylock(&data->lock, &key) < 0) {
 		return -EBUSY;
 	}
 
 	data->settings = config->init_settings;
+	data->dev = dev;
+	k_work_init(&data->glide_work, clock_control_tt_bh_glide_work);
 	union tt_bh_pll_cntl_0_reg pll_cntl_0;
 
 	/* Before turning off PLL, bypass PLL so glitch free mux has no chance to switch */
@@ -639,6 +852,12 @@ static const struct clock_control_driver_api clock_control_tt_bh_api = {
 #define CLOCK_CONTROL_TT_BH_INIT(_inst)                                                            \
 	static struct clock_control_tt_bh_data clock_control_tt_bh_data_##_inst;                   \
                                                                                                    \
+	BUILD_ASSERT(DT_INST_PROP_LEN_OR(_inst, glide_table, 0) % GLIDE_ENTRY_SIZE == 0,           \
+		     "glide-table entries are <max-fbdiv max-step settle-ns>");                    \
+	IF_ENABLED(DT_INST_NODE_HAS_PROP(_inst, glide_table),                                      \
+		   (static const uint32_t clock_control_tt_bh_glide_##_inst[] =                    \
+			    DT_INST_PROP(_inst, glide_table);))                                    \
+                                                                                                   \
 	static const struct clock_control_tt_bh_config clock_control_tt_bh_config_##_inst = {      \
 		.inst = _inst,                                                                     \
 		.refclk_rate = DT_PROP(DT_INST_CLOCKS_CTLR(_inst), clock_frequency),               \
@@ -661,7 +880,11 @@ static const struct clock_control_driver_api clock_control_tt_bh_api = {
 					.f.pll_use_postdiv2 =                                      \
 						DT_INST_PROP_BY_IDX(_inst, use_post_divs, 2),      \
 					.f.pll_use_postdiv3 =                                      \
-						DT_INST_PROP_BY_IDX(_inst, use_post_divs, 3)}}};   \
+						DT_INST_PROP_BY_IDX(_inst, use_post_divs, 3)}},    \
+		.glide_table = COND_CODE_1(DT_INST_NODE_HAS_PROP(_inst, glide_table),              \
+					   (clock_control_tt_bh_glide_##_inst), (NULL)),           \
+		.glide_table_len = DT_INST_PROP_LEN_OR(_inst, glide_table, 0),                     \
+	};                                                                                         \
                                                                                                    \
 	DEVICE_DT_INST_DEFINE(                                                                     \
 		_inst, clock_control_tt_bh_init, NULL, &clock_control_tt_bh_data_##_inst,          \
@@ -61,6 +61,7 @@
 /* Use the actual configured channels for this instance */
 #define ARC_DMA_CONFIGURED_CHANNELS DT_INST_PROP(0, dma_channels)
 #define ARC_DMA_ATOMIC_WORDS        ATOMIC_BITMAP_SIZE(ARC_DMA_MAX_CHANNELS)
+#define ARC_DMA_POLL_MAX_US         1000
 
 LOG_MODULE_REGISTER(dma_arc, CONFIG_DMA_LOG_LEVEL);
 
@@ -81,6 +82,10 @@ struct arc_dma_channel {
 	struct dma_block_config block_config; /* Copy of first block config */
 	uint32_t handle;
 	uint32_t block_count;      /* Total number of blocks */
+	uint32_t poll_us;          /* Completion polling interval, from the transfer size */
+	size_t active_bytes;       /* Size of the transfer in progress */
+	uint32_t start_cycles;     /* Cycle count when the transfer in progress started */
+	struct dma_arc_hs_stats stats;
 	struct k_spinlock hw_lock; /* Per-channel hardware access lock */
 };
 
@@ -88,6 +93,7 @@ struct arc_dma_config {
 	uint32_t base;
 	uint32_t channels;
 	uint32_t descriptors;
+	uint32_t chan_descriptors; /* Descriptors in the ring of each channel */
 	uint32_t max_burst_size;
 	uint32_t max_pending_transactions;
 	uint32_t buffer_size;
@@ -104,7 +110,9 @@ struct arc_dma_data {
 	struct k_work_delayable completion_work;
 	const struct device *dev;
 	bool work_initialized;
-	/* Static block array for splitting large transfers - sized by max descriptors */
+	/* Static block array for splitting large transfers - one slice of chan_descriptors blocks
+	 * per channel, so that transfers on different channels do not share block lists
+	 */
 	struct dma_block_config *transfer_blocks;
 };
 
@@ -170,6 +178,37 @@ static uint32_t dma_arc_hs_get_done_hw(uint32_t handle)
 	return state & 0x1;
 }
 
+/* Account for the transfer that has just finished or been stopped on chan */
+static void dma_arc_hs_update_stats(struct arc_dma_channel *chan)
+{
+	chan->stats.transfers++;
+	chan->stats.bytes += chan->active_bytes;
+	chan->stats.busy_cycles += k_cycle_get_32() - chan->start_cycles;
+}
+
+/* Expected duration of a len byte transfer */
+static uint32_t dma_arc_hs_expected_us(size_t len)
+{
+	return DIV_ROUND_UP(len, CONFIG_DMA_ARC_HS_BYTES_PER_US);
+}
+
+static uint32_t dma_arc_hs_poll_us(size_t len)
+{
+	return CLAMP(dma_arc_hs_expected_us(len), CONFIG_DMA_ARC_HS_POLL_MIN_US,
+		     ARC_DMA_POLL_MAX_US);
+}
+
+/* Make sure the completion work runs within poll_us, without delaying an earlier check */
+static void dma_arc_hs_schedule_completion(struct arc_dma_data *data, uint32_t poll_us)
+{
+	k_timeout_t delay = K_USEC(poll_us);
+
+	if (!k_work_delayable_is_pending(&data->completion_work) ||
+	    k_work_delayable_remaining_get(&data->completion_work) > delay.ticks) {
+		k_work_reschedule(&data->completion_work, delay);
+	}
+}
+
 static int dma_arc_hs_config(const struct device *dev, uint32_t channel, struct dma_config *config)
 {
 	const struct arc_dma_config *dev_config = dev->config;
@@ -188,9 +227,9 @@ static int dma_arc_hs_config(const struct device *dev, uint32_t channel, struct
 		return -EINVAL;
 	}
 
-	if (config->block_count > dev_config->descriptors) {
+	if (config->block_count > dev_config->chan_descriptors) {
 		LOG_ERR("block_count %u exceeds max descriptors %u", config->block_count,
-			dev_config->descriptors);
+			dev_config->chan_descriptors);
 		return -EINVAL;
 	}
 
@@ -241,6 +280,7 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 	struct dma_block_config *block;
 	uint32_t attr;
 	uint32_t block_idx = 0;
+	size_t total_size = 0;
 	k_spinlock_key_t key, hw_key;
 	uint32_t current_channel = channel;
 
@@ -301,6 +341,7 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 
 	dma_arc_hs_start_hw(current_channel, (const void *)block->source_address,
 			    (void *)block->dest_address, block->block_size, attr);
+	total_size += block->block_size;
 	block_idx++;
 	block = block->next_block;
 
@@ -312,6 +353,7 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 
 		dma_arc_hs_next_hw((const void *)block->source_address, (void *)block->dest_address,
 				   block->block_size, attr);
+		total_size += block->block_size;
 		block_idx++;
 		block = block->next_block;
 	}
@@ -320,6 +362,9 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 	chan->handle = dma_arc_hs_get_handle_hw();
 	chan->state = ARC_DMA_ACTIVE;
 	chan->block_count = chan->config.block_count;
+	chan->poll_us = dma_arc_hs_poll_us(total_size);
+	chan->active_bytes = total_size;
+	chan->start_cycles = k_cycle_get_32();
 
 	LOG_DBG("HW transfer started: ch=%u, last_handle=%u, blocks=%u", current_channel,
 		chan->handle, chan->block_count);
@@ -328,8 +373,8 @@ static int dma_arc_hs_start(const struct device *dev, uint32_t channel)
 
 	k_spin_unlock(&data->lock, key);
 
-	/* Schedule completion work to check for transfer completion */
-	k_work_schedule(&data->completion_work, K_MSEC(1));
+	/* Check for completion around the time the transfer is expected to finish */
+	dma_arc_hs_schedule_completion(data, chan->poll_us);
 
 	LOG_DBG("Started DMA transfer on channel %u, handle %u", current_channel, chan->handle);
 	return 0;
@@ -366,6 +411,7 @@ static int dma_arc_hs_stop(const struct device *dev, uint32_t channel)
 
 	chan->state = ARC_DMA_IDLE;
 	dma_arc_hs_clear_done_hw(chan->handle);
+	dma_arc_hs_update_stats(chan);
 
 	k_spin_unlock(&chan->hw_lock, hw_key);
 	k_spin_unlock(&data->lock, key);
@@ -457,6 +503,7 @@ static void dma_arc_hs_check_completion(const struct device *dev, uint32_t chann
 	dma_arc_hs_clear_done_hw(handle);
 
 	chan->state = ARC_DMA_IDLE;
+	dma_arc_hs_update_stats(chan);
 
 	k_spin_unlock(&chan->hw_lock, hw_key);
 	/* chan->hw_lock released – safe to call user callback */
@@ -495,6 +542,9 @@ static void dma_arc_hs_check_completion(const struct device *dev, uint32_t chann
 			linked_chan->handle = dma_arc_hs_get_handle_hw();
 			linked_chan->state = ARC_DMA_ACTIVE;
 			linked_chan->block_count = linked_chan->config.block_count;
+			linked_chan->poll_us = dma_arc_hs_poll_us(transfer_size);
+			linked_chan->active_bytes = transfer_size;
+			linked_chan->start_cycles = k_cycle_get_32();
 
 			LOG_DBG("Linked channel %u started (size %zu)", linked_ch, transfer_size);
 
@@ -556,6 +606,16 @@ static int dma_arc_hs_get_status(const struct device *dev, uint32_t channel,
 		/* Lock hardware access for this channel */
 		hw_key = k_spin_lock(&chan->hw_lock);
 
+		/*
+		 * The completion work or a concurrent caller may have retired this transfer
+		 * (and possibly started another) between dropping the global lock and taking
+		 * hw_lock.
+		 */
+		if ((chan->state != ARC_DMA_ACTIVE) || (chan->handle != handle)) {
+			k_spin_unlock(&chan->hw_lock, hw_key);
+			return 0;
+		}
+
 		done_status = dma_arc_hs_get_done_hw(handle);
 		LOG_DBG("Channel %u status check: handle=%u, done_status=%u", channel, handle,
 			done_status);
@@ -573,6 +633,7 @@ static int dma_arc_hs_get_status(const struct device *dev, uint32_t channel,
 
 			/* Transfer completes and goes idle */
 			chan->state = ARC_DMA_IDLE;
+			dma_arc_hs_update_stats(chan);
 
 			k_spin_unlock(&chan->hw_lock, hw_key);
 			/* hw_lock released – safe to call user callback */
@@ -624,6 +685,9 @@ static int dma_arc_hs_get_status(const struct device *dev, uint32_t channel,
 					linked_chan->handle = dma_arc_hs_get_handle_hw();
 					linked_chan->state = ARC_DMA_ACTIVE;
 					linked_chan->block_count = linked_chan->config.block_count;
+					linked_chan->poll_us = dma_arc_hs_poll_us(transfer_size);
+					linked_chan->active_bytes = transfer_size;
+					linked_chan->start_cycles = k_cycle_get_32();
 
 					LOG_DBG("Linked channel %u started (size %zu)", linked_ch,
 						transfer_size);
@@ -658,7 +722,7 @@ static int dma_arc_hs_get_attribute(const struct device *dev, uint32_t type, uin
 		*value = 4; /* 32-bit aligned */
 		break;
 	case DMA_ATTR_MAX_BLOCK_COUNT:
-		*value = dev_config->descriptors; /* Limited by descriptor count */
+		*value = dev_config->chan_descriptors; /* Limited by the channel's ring */
 		break;
 	default:
 		return -ENOTSUP;
@@ -673,34 +737,38 @@ static void dma_arc_hs_completion_work_handler(struct k_work *work)
 	struct arc_dma_data *data = CONTAINER_OF(dwork, struct arc_dma_data, completion_work);
 	const struct device *dev = data->dev;
 	const struct arc_dma_config *config = dev->config;
-	bool any_active = false;
+	uint32_t poll_us = UINT32_MAX;
 	int i;
 
 	/* Check all channels for completion */
 	for (i = 0; i < config->channels; i++) {
 		if (data->channels[i].state == ARC_DMA_ACTIVE) {
-			any_active = true;
 			dma_arc_hs_check_completion(dev, i);
 		}
 	}
 
-	/* Reschedule work if there are still active transfers */
-	if (any_active) {
-		/* Poll every 1ms when transfers are active */
-		k_work_schedule(&data->completion_work, K_MSEC(1));
+	/* Transfers that are still active, or linked transfers that have just started, are polled
+	 * at the interval of the shortest one.
+	 */
+	for (i = 0; i < config->channels; i++) {
+		if (data->channels[i].state == ARC_DMA_ACTIVE) {
+			poll_us = MIN(poll_us, data->channels[i].poll_us);
+		}
+	}
+
+	if (poll_us != UINT32_MAX) {
+		k_work_schedule(&data->completion_work, K_USEC(poll_us));
 	} else {
 		LOG_DBG("No active transfers, work handler idle");
 	}
 }
 
-int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *src, void *dst,
-			size_t len, k_timeout_t timeout)
+int dma_arc_hs_transfer_async(const struct device *dev, uint32_t channel, const void *src,
+			      void *dst, size_t len, dma_callback_t callback, void *user_data)
 {
 	const struct arc_dma_config *dev_config = dev->config;
 	struct arc_dma_data *data = dev->data;
 	struct dma_config cfg = {0};
-	struct dma_status stat;
-	k_timepoint_t end_time;
 	int rc;
 	size_t num_blocks;
 	size_t max_block_size;
@@ -711,7 +779,7 @@ int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *
 	}
 
 	if (len == 0) {
-		return 0;
+		return -EINVAL;
 	}
 
 	uint32_t required_alignment;
@@ -740,15 +808,16 @@ int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *
 	/* Calculate number of blocks needed to split the transfer */
 	num_blocks = (len + max_block_size - 1) / max_block_size;
 
-	/* Check if we exceed the maximum number of descriptors */
-	if (num_blocks > dev_config->descriptors) {
+	/* A transfer is limited to the channel's own ring of descriptors */
+	if (num_blocks > dev_config->chan_descriptors) {
 		LOG_ERR("Transfer size %zu requires %zu blocks but only %u descriptors available",
-			len, num_blocks, dev_config->descriptors);
-		return -EINVAL;
+			len, num_blocks, dev_config->chan_descriptors);
+		return -E2BIG;
 	}
 
-	/* Use statically allocated transfer_blocks array (no malloc needed) */
-	struct dma_block_config *blocks = data->transfer_blocks;
+	/* Use this channel's slice of the statically allocated transfer_blocks array */
+	struct dma_block_config *blocks =
+		&data->transfer_blocks[channel * dev_config->chan_descriptors];
 
 	/* Split the transfer into multiple blocks */
 	size_t remaining = len;
@@ -777,37 +846,86 @@ int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *
 	cfg.channel_direction = MEMORY_TO_MEMORY;
 	cfg.head_block = blocks;
 	cfg.block_count = num_blocks;
+	cfg.dma_callback = callback;
+	cfg.user_data = user_data;
 
 	rc = dma_config(dev, channel, &cfg);
 	if (rc < 0) {
 		return rc;
 	}
 
-	rc = dma_start(dev, channel);
+	return dma_start(dev, channel);
+}
+
+int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *src, void *dst,
+			size_t len, k_timeout_t timeout)
+{
+	struct dma_status stat;
+	k_timepoint_t end;
+	int rc;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	end = sys_timepoint_calc(timeout);
+
+	rc = dma_arc_hs_transfer_async(dev, channel, src, dst, len, NULL, NULL);
 	if (rc < 0) {
 		return rc;
 	}
 
-	end_time = sys_timepoint_calc(timeout);
+	/* Completion is checked here rather than waited for from the completion work, which runs
+	 * on the system workqueue: callers on that queue (telemetry, for one) would otherwise
+	 * block the work that wakes them. Short transfers are over sooner than a sleep could
+	 * end, so wait them out; longer ones are polled at the same interval the work would use.
+	 */
+	uint32_t expected_us = dma_arc_hs_expected_us(len);
+	uint32_t poll_us = dma_arc_hs_poll_us(len);
 
-	do {
-		if (dma_get_status(dev, channel, &stat) == 0 && !stat.busy) {
-			dma_stop(dev, channel);
-			return 0;
+	if (expected_us < CONFIG_DMA_ARC_HS_POLL_MIN_US) {
+		k_busy_wait(expected_us);
+	}
+
+	while (true) {
+		rc = dma_get_status(dev, channel, &stat);
+		if (rc < 0) {
+			return rc;
 		}
 
-		/* Update timeout with remaining time */
-		timeout = sys_timepoint_timeout(end_time);
+		if (!stat.busy) {
+			return 0;
+		}
 
-		/* Busy wait for a short period */
-		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-			k_busy_wait(100);
+		if (sys_timepoint_expired(end)) {
+			dma_stop(dev, channel);
+			return -ETIMEDOUT;
 		}
-	} while (!K_TIMEOUT_EQ(timeout, K_NO_WAIT));
 
-	/* Timeout expired */
-	dma_stop(dev, channel);
-	return -ETIMEDOUT;
+		k_usleep(poll_us);
+	}
+}
+
+int dma_arc_hs_get_stats(const struct device *dev, uint32_t channel,
+			 struct dma_arc_hs_stats *stats)
+{
+	const struct arc_dma_config *dev_config = dev->config;
+	struct arc_dma_data *data = dev->data;
+	struct arc_dma_channel *chan;
+	k_spinlock_key_t key;
+
+	if (channel >= dev_config->channels) {
+		return -EINVAL;
+	}
+
+	chan = &data->channels[channel];
+
+	key = k_spin_lock(&chan->hw_lock);
+	*stats = chan->stats;
+	stats->active = chan->state == ARC_DMA_ACTIVE;
+	k_spin_unlock(&chan->hw_lock, key);
+
+	return 0;
 }
 
 static const struct dma_driver_api dma_arc_hs_api = {
@@ -846,7 +964,9 @@ static int dma_arc_hs_init(const struct device *dev)
 	dma_arc_hs_config_hw();
 
 	for (i = 0; i < config->channels; i++) {
-		dma_arc_hs_init_channel_hw(i, 0, config->descriptors - 1);
+		uint32_t base = i * config->chan_descriptors;
+
+		dma_arc_hs_init_channel_hw(i, base, base + config->chan_descriptors - 1);
 	}
 
 	/* Initialize completion work queue */
@@ -863,6 +983,8 @@ static int dma_arc_hs_init(const struct device *dev)
 		.base = DMA_AUX_BASE, /*not in addressable memory*/                                \
 		.channels = DT_INST_PROP(inst, dma_channels),                                      \
 		.descriptors = DT_INST_PROP(inst, dma_descriptors),                                \
+		.chan_descriptors =                                                                \
+			DT_INST_PROP(inst, dma_descriptors) / DT_INST_PROP(inst, dma_channels),    \
 		.max_burst_size = DT_INST_PROP(inst, max_burst_size),                              \
 		.max_pending_transactions = DT_INST_PROP(inst, max_pending_transactions),          \
 		.buffer_size = DT_INST_PROP(inst, buffer_size),                                    \
@@ -872,6 +994,8 @@ static int dma_arc_hs_init(const struct device *dev)
                                                                                                    \
 	/* Allocate only the needed number of channels */                                          \
 	static struct arc_dma_channel arc_dma_channels_##inst[DT_INST_PROP(inst, dma_channels)];   \
+	BUILD_ASSERT(DT_INST_PROP(inst, dma_descriptors) >= DT_INST_PROP(inst, dma_channels),     \
+		     "Each ARC DMA channel needs at least one descriptor");                        \
 	/* Statically allocate transfer blocks - sized by max descriptors */                       \
 	static struct dma_block_config arc_dma_blocks_##inst[DT_INST_PROP(inst, dma_descriptors)]; \
 	static struct arc_dma_data arc_dma_data_##inst = {                                         \
@@ -21,10 +21,17 @@
 
 LOG_MODULE_REGISTER(dma_noc_tt_bh, CONFIG_DMA_LOG_LEVEL);
 
-#define NOC_DMA_TLB        0
+/*
+ * Each channel issues its commands through a NOC 0 TLB of its own, starting at NOC_DMA_TLB_BASE,
+ * and tags them with a transaction ID of its own, so that channels never wait on each other's
+ * commands.
+ */
+#define NOC_DMA_TLB_BASE   8
+#define NOC_DMA_NUM_TLBS   12 /* TLBs from 12 up are used directly by bh_arc */
+#define NOC_DMA_TRID_BASE  1
+#define NOC_DMA_MAX_TRID   15
 #define NOC_DMA_NOC_ID     0
 #define NOC_DMA_TIMEOUT_MS 50
-#define NOC_MAX_BURST_SIZE 16384
 
 #define DMA_MAX_TRANSFER_BLOCKS 4
 
@@ -38,31 +45,35 @@ LOG_MODULE_REGISTER(dma_noc_tt_bh, CONFIG_DMA_LOG_LEVEL);
 #define NOC_CMD_BRCST_SRC_INCLUDE (1 << 17)
 
 /* NOC0 RISC0 DMA registers */
-#define TARGET_ADDR_LO           0xFFB20000
-#define TARGET_ADDR_MID          0xFFB20004
-#define TARGET_ADDR_HI           0xFFB20008
-#define RET_ADDR_LO              0xFFB2000C
-#define RET_ADDR_MID             0xFFB20010
-#define RET_ADDR_HI              0xFFB20014
-#define PACKET_TAG               0xFFB20018
-#define CMD_BRCST                0xFFB2001C
-#define AT_LEN                   0xFFB20020
-#define AT_LEN_1                 0xFFB20024
-#define AT_DATA                  0xFFB20028
-#define BRCST_EXCLUDE            0xFFB2002C
-#define CMD_CTRL                 0xFFB20040
-#define NIU_MST_WR_ACK_RECEIVED  0xFFB20204
-#define NIU_MST_RD_RESP_RECEIVED 0xFFB20208
+#define TARGET_ADDR_LO                  0xFFB20000
+#define TARGET_ADDR_MID                 0xFFB20004
+#define TARGET_ADDR_HI                  0xFFB20008
+#define RET_ADDR_LO                     0xFFB2000C
+#define RET_ADDR_MID                    0xFFB20010
+#define RET_ADDR_HI                     0xFFB20014
+#define PACKET_TAG                      0xFFB20018
+#define CMD_BRCST                       0xFFB2001C
+#define AT_LEN                          0xFFB20020
+#define AT_LEN_1                        0xFFB20024
+#define AT_DATA                         0xFFB20028
+#define BRCST_EXCLUDE                   0xFFB2002C
+#define CMD_CTRL                        0xFFB20040
+#define NIU_MST_REQS_OUTSTANDING_ID(id) (0xFFB20240 + (id) * 4)
 
 /* Define invalid channel constant - using a high value that's unlikely to be used */
 #define DMA_CHANNEL_INVALID 0xFFFFFFFF
 
+enum tt_bh_dma_noc_phase {
+	NOC_DMA_PHASE_IDLE,
+	NOC_DMA_PHASE_ISSUE, /* Commands being issued, the transaction counter may lag */
+	NOC_DMA_PHASE_READ,  /* Reads in flight; MEMORY_TO_MEMORY writes follow */
+	NOC_DMA_PHASE_WRITE, /* Last commands of the transfer in flight */
+};
+
 struct tt_bh_dma_channel_resettable_data {
-	/* Hardware completion tracking for get_status() */
-	uint32_t last_noc_cmd;
-	uint32_t last_expected_acks;
-	uint16_t block_index;
+	k_timepoint_t timeout;
 	uint16_t block_count;
+	uint8_t phase;
 	bool configured: 1;
 };
 
@@ -89,49 +100,34 @@ struct tt_bh_dma_noc_config {
  */
 struct tt_bh_dma_noc_data {
 	struct k_spinlock lock;
+	/* Serializes command issue, as channels may issue through the same tile's NIU */
+	struct k_mutex issue_lock;
+	struct k_work_delayable completion_work;
+	const struct device *dev;
 };
 
-static bool noc_wait_cmd_ready(void)
+static inline uint8_t noc_dma_tlb(uint32_t channel)
+{
+	return NOC_DMA_TLB_BASE + channel;
+}
+
+static inline uint8_t noc_dma_trid(uint32_t channel)
+{
+	return NOC_DMA_TRID_BASE + channel;
+}
+
+static bool noc_wait_cmd_ready(uint8_t tlb)
 {
 	uint32_t cmd_ctrl;
 	k_timepoint_t timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
 
 	do {
-		cmd_ctrl = NOC2AXIRead32(NOC_DMA_NOC_ID, NOC_DMA_TLB, CMD_CTRL);
+		cmd_ctrl = NOC2AXIRead32(NOC_DMA_NOC_ID, tlb, CMD_CTRL);
 	} while (cmd_ctrl != 0 && !sys_timepoint_expired(timeout));
 
 	return cmd_ctrl == 0;
 }
 
-static uint32_t get_expected_acks(uint32_t noc_cmd, uint64_t size)
-{
-	uint32_t ack_reg_addr =
-		(noc_cmd & NOC_CMD_WR) ? NIU_MST_WR_ACK_RECEIVED : NIU_MST_RD_RESP_RECEIVED;
-	uint32_t packet_received = NOC2AXIRead32(NOC_DMA_NOC_ID, NOC_DMA_TLB, ack_reg_addr);
-	uint32_t expected_acks = packet_received + DIV_ROUND_UP(size, NOC_MAX_BURST_SIZE);
-
-	return expected_acks;
-}
-
-/* wrap around aware comparison for half-range rule */
-static inline bool is_behind(uint32_t current, uint32_t target)
-{
-	/*
-	 * "target" and "current" are NOC transaction counters, and may wrap around, so we must
-	 * consider the case where target and current have wrapped a different number of times.
-	 * There's no way to know how many times they have wrapped, instead we assume that they are
-	 * within 2**31 of each other as that gives an unambiguous ordering.
-	 *
-	 * We deal with this by considering
-	 * target - 2**31 <  current < target         MOD 2**32 as before target and
-	 * target         <= current < target + 2**31 MOD 2**32 as after target.
-	 *
-	 * We can't just check target == current because just one spurious NOC transaction could
-	 * result in the loop hanging with current = target+1.
-	 */
-	return (int32_t)(current - target) < 0;
-}
-
 static inline uint32_t noc_coord_encode(uint32_t x, uint32_t y)
 {
 	return (y << 6) | x;
@@ -140,7 +136,21 @@ static inline uint32_t noc_coord_encode(uint32_t x, uint32_t y)
 static inline uint32_t noc_coord_encode_range(uint32_t start_x, uint32_t start_y, uint32_t end_x,
 					      uint32_t end_y)
 {
-	return (start_y << 18) | (start_y << 12) | (end_y << 6) | end_x;
+	return (start_y << 18) | (start_x << 12) | (end_y << 6) | end_x;
+}
+
+/* Every Tensix row and column, used when the caller gives no rectangle. Harvested columns are
+ * skipped by the router broadcast disables that NocInit programs.
+ */
+static uint32_t noc_dma_mcast_range(const struct tt_bh_dma_noc_coords *coords)
+{
+	if ((coords->mcast_start_x | coords->mcast_start_y | coords->mcast_end_x |
+	     coords->mcast_end_y) == 0) {
+		return noc_coord_encode_range(2, 2, 1, 11);
+	}
+
+	return noc_coord_encode_range(coords->mcast_start_x, coords->mcast_start_y,
+				      coords->mcast_end_x, coords->mcast_end_y);
 }
 
 static void handle_transfer_callbacks(const struct device *dev,
@@ -170,10 +180,9 @@ static void handle_transfer_callbacks(const struct device *dev,
 	}
 }
 
-static int noc_dma_transfer(uint32_t cmd, uint32_t ret_coord, uint64_t ret_addr,
+static int noc_dma_transfer(uint8_t tlb, uint32_t cmd, uint32_t ret_coord, uint64_t ret_addr,
 			    uint32_t targ_coord, uint64_t targ_addr, uint32_t size, bool multicast,
-			    uint8_t transaction_id, bool include_self, uint32_t *noc_cmd_out,
-			    uint32_t *expected_acks_out)
+			    uint16_t exclude, uint8_t transaction_id, bool include_self)
 {
 	uint32_t ret_addr_lo = low32(ret_addr);
 	uint32_t ret_addr_mid = high32(ret_addr);
@@ -198,34 +207,25 @@ static int noc_dma_transfer(uint32_t cmd, uint32_t ret_coord, uint64_t ret_addr,
 
 	/* Always enable response marking for completion tracking */
 	noc_ctrl |= NOC_CMD_RESP_MARKED;
-	uint32_t expected_acks = get_expected_acks(noc_ctrl, size);
 
-	/* Return tracking info to caller */
-	if (noc_cmd_out) {
-		*noc_cmd_out = noc_ctrl;
-	}
-	if (expected_acks_out) {
-		*expected_acks_out = expected_acks;
-	}
-
-	if (!noc_wait_cmd_ready()) {
+	if (!noc_wait_cmd_ready(tlb)) {
 		LOG_ERR("Waiting for transfer command timed out");
 		return -ETIMEDOUT;
 	}
 
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, TARGET_ADDR_LO, targ_addr_lo);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, TARGET_ADDR_MID, targ_addr_mid);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, TARGET_ADDR_HI, targ_addr_hi);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, RET_ADDR_LO, ret_addr_lo);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, RET_ADDR_MID, ret_addr_mid);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, RET_ADDR_HI, ret_addr_hi);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, PACKET_TAG, noc_packet_tag);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, AT_LEN, noc_at_len_be);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, AT_LEN_1, 0);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, AT_DATA, 0);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, BRCST_EXCLUDE, 0);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, CMD_BRCST, noc_ctrl);
-	NOC2AXIWrite32(NOC_DMA_NOC_ID, NOC_DMA_TLB, CMD_CTRL, 1);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, TARGET_ADDR_LO, targ_addr_lo);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, TARGET_ADDR_MID, targ_addr_mid);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, TARGET_ADDR_HI, targ_addr_hi);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, RET_ADDR_LO, ret_addr_lo);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, RET_ADDR_MID, ret_addr_mid);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, RET_ADDR_HI, ret_addr_hi);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, PACKET_TAG, noc_packet_tag);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, AT_LEN, noc_at_len_be);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, AT_LEN_1, 0);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, AT_DATA, 0);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, BRCST_EXCLUDE, exclude);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, CMD_BRCST, noc_ctrl);
+	NOC2AXIWrite32(NOC_DMA_NOC_ID, tlb, CMD_CTRL, 1);
 
 	return 0;
 }
@@ -249,7 +249,7 @@ static int tt_bh_dma_noc_config(const struct device *dev, uint32_t channel,
 		LOG_ERR("Too many blocks: %u > %u", config->block_count, DMA_MAX_TRANSFER_BLOCKS);
 		return -EINVAL;
 	}
-	if (channel > dma_cfg->num_channels) {
+	if (channel >= dma_cfg->num_channels) {
 		LOG_ERR("Invalid channel %u", channel);
 		return -EINVAL;
 	}
@@ -258,6 +258,12 @@ static int tt_bh_dma_noc_config(const struct device *dev, uint32_t channel,
 
 	k_spinlock_key_t key = k_spin_lock(&dma_data->lock);
 
+	if (chan_data->state.phase != NOC_DMA_PHASE_IDLE) {
+		k_spin_unlock(&dma_data->lock, key);
+		LOG_ERR("Channel %u busy", channel);
+		return -EBUSY;
+	}
+
 	/* Deep copy all blocks from the linked list */
 	struct dma_block_config *src_block = config->head_block;
 
@@ -269,14 +275,11 @@ static int tt_bh_dma_noc_config(const struct device *dev, uint32_t channel,
 		src_block = src_block->next_block;
 	}
 
-	chan_data->state.block_index = 0;
 	chan_data->state.block_count = config->block_count;
 	chan_data->config = *config;
 	/* Update the config to point to our copied blocks */
 	chan_data->config.head_block = &chan_data->blocks[0];
 	chan_data->state.configured = true;
-	chan_data->state.last_noc_cmd = 0;
-	chan_data->state.last_expected_acks = 0;
 
 	if (config->user_data) {
 		chan_data->coords = *(struct tt_bh_dma_noc_coords *)config->user_data;
@@ -291,72 +294,95 @@ static int tt_bh_dma_noc_config(const struct device *dev, uint32_t channel,
 	return 0;
 }
 
-static int noc_dma_write_multicast(uint8_t local_x, uint8_t local_y, uint64_t local_addr,
-				   uint8_t remote_start_x, uint8_t remote_start_y,
-				   uint8_t remote_end_x, uint8_t remote_end_y, uint64_t remote_addr,
-				   uint32_t size, bool include_self, uint32_t *noc_cmd_out,
-				   uint32_t *expected_acks_out)
-{
-	uint32_t ret_coord =
-		noc_coord_encode_range(remote_start_x, remote_start_y, remote_end_x, remote_end_y);
-	uint64_t ret_addr = remote_addr;
-
-	uint32_t targ_coord = noc_coord_encode(local_x, local_y);
-	uint64_t targ_addr = local_addr;
-
-	NOC2AXITlbSetup(NOC_DMA_NOC_ID, NOC_DMA_TLB, local_x, local_y, TARGET_ADDR_LO);
-
-	return noc_dma_transfer(NOC_CMD_WR, ret_coord, ret_addr, targ_coord, targ_addr, size, true,
-				0, include_self, noc_cmd_out, expected_acks_out);
-}
-
-static int tt_bh_dma_noc_start_mem_to_per(const struct device *dev, uint32_t channel)
+/*
+ * Issue one command per block for the given phase. MEMORY_TO_MEMORY copies within the dest tile,
+ * bouncing each block through the source tile's memory from address 0 up.
+ */
+static int tt_bh_dma_noc_issue(const struct device *dev, uint32_t channel,
+			       enum tt_bh_dma_noc_phase phase)
 {
 	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *dma_data = (struct tt_bh_dma_noc_data *)dev->data;
 	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
 	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
-	struct dma_block_config *current_block = &chan_data->blocks[chan_data->state.block_index];
+	uint32_t direction = chan_data->config.channel_direction;
+	uint32_t source = noc_coord_encode(coords->source_x, coords->source_y);
+	uint32_t dest = noc_coord_encode(coords->dest_x, coords->dest_y);
+	uint8_t tlb = noc_dma_tlb(channel);
+	uint8_t trid = noc_dma_trid(channel);
+	uint64_t bounce_addr = 0;
+	int ret = 0;
+
+	k_mutex_lock(&dma_data->issue_lock, K_FOREVER);
+
+	if (direction == TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST) {
+		/* Issued by the dest tile, which is the multicast source */
+		NOC2AXITlbSetup(NOC_DMA_NOC_ID, tlb, coords->dest_x, coords->dest_y,
+				TARGET_ADDR_LO);
+	} else {
+		NOC2AXITlbSetup(NOC_DMA_NOC_ID, tlb, coords->source_x, coords->source_y,
+				TARGET_ADDR_LO);
+	}
 
-	uint32_t ret_coord = noc_coord_encode(coords->source_x, coords->source_y);
-	uint64_t ret_addr = current_block->source_address;
+	for (uint16_t i = 0; i < chan_data->state.block_count && ret == 0; i++) {
+		struct dma_block_config *block = &chan_data->blocks[i];
+
+		switch (direction) {
+		case MEMORY_TO_MEMORY:
+			if (phase == NOC_DMA_PHASE_READ) {
+				ret = noc_dma_transfer(tlb, NOC_CMD_RD, source, bounce_addr, dest,
+						       block->source_address, block->block_size,
+						       false, 0, trid, false);
+			} else {
+				ret = noc_dma_transfer(tlb, NOC_CMD_WR, dest, block->dest_address,
+						       source, bounce_addr, block->block_size,
+						       false, 0, trid, false);
+			}
+			bounce_addr += block->block_size;
+			break;
+		case MEMORY_TO_PERIPHERAL:
+			ret = noc_dma_transfer(tlb, NOC_CMD_RD, source, block->source_address, dest,
+					       block->dest_address, block->block_size, false, 0,
+					       trid, false);
+			break;
+		case PERIPHERAL_TO_MEMORY:
+			ret = noc_dma_transfer(tlb, NOC_CMD_WR, dest, block->dest_address, source,
+					       block->source_address, block->block_size, false, 0,
+					       trid, false);
+			break;
+		case TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST:
+			ret = noc_dma_transfer(tlb, NOC_CMD_WR, noc_dma_mcast_range(coords),
+					       block->dest_address, dest, block->source_address,
+					       block->block_size, true, coords->mcast_exclude, trid,
+					       false);
+			break;
+		default:
+			LOG_ERR("Invalid channel direction %d", direction);
+			ret = -EINVAL;
+			break;
+		}
+	}
 
-	uint32_t targ_coord = noc_coord_encode(coords->dest_x, coords->dest_y);
-	uint64_t targ_addr = current_block->dest_address;
+	/* Once the last command has been accepted, the transaction counter accounts for it */
+	if (ret == 0 && !noc_wait_cmd_ready(tlb)) {
+		ret = -ETIMEDOUT;
+	}
 
-	NOC2AXITlbSetup(NOC_DMA_NOC_ID, NOC_DMA_TLB, coords->source_x, coords->source_y,
-			TARGET_ADDR_LO);
+	k_mutex_unlock(&dma_data->issue_lock);
 
-	return noc_dma_transfer(NOC_CMD_RD, ret_coord, ret_addr, targ_coord, targ_addr,
-				current_block->block_size, false, 0, false,
-				&chan_data->state.last_noc_cmd,
-				&chan_data->state.last_expected_acks);
+	return ret;
 }
 
-static int tt_bh_dma_noc_start_per_to_mem(const struct device *dev, uint32_t channel)
+static bool tt_bh_dma_noc_outstanding(uint32_t channel)
 {
-	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
-	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
-	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
-	struct dma_block_config *current_block = &chan_data->blocks[chan_data->state.block_index];
-
-	uint32_t ret_coord = noc_coord_encode(coords->dest_x, coords->dest_y);
-	uint64_t ret_addr = current_block->dest_address;
-
-	uint32_t targ_coord = noc_coord_encode(coords->source_x, coords->source_y);
-	uint64_t targ_addr = current_block->source_address;
-
-	NOC2AXITlbSetup(NOC_DMA_NOC_ID, NOC_DMA_TLB, coords->source_x, coords->source_y,
-			TARGET_ADDR_LO);
-
-	return noc_dma_transfer(NOC_CMD_WR, ret_coord, ret_addr, targ_coord, targ_addr,
-				current_block->block_size, false, 0, false,
-				&chan_data->state.last_noc_cmd,
-				&chan_data->state.last_expected_acks);
+	return NOC2AXIRead32(NOC_DMA_NOC_ID, noc_dma_tlb(channel),
+			     NIU_MST_REQS_OUTSTANDING_ID(noc_dma_trid(channel))) != 0;
 }
 
 static int tt_bh_dma_noc_start(const struct device *dev, uint32_t channel)
 {
 	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *dma_data = (struct tt_bh_dma_noc_data *)dev->data;
 
 	if (channel >= cfg->num_channels) {
 		LOG_ERR("Invalid channel %u", channel);
@@ -364,128 +390,143 @@ static int tt_bh_dma_noc_start(const struct device *dev, uint32_t channel)
 	}
 
 	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
+	k_spinlock_key_t key = k_spin_lock(&dma_data->lock);
 
 	if (!chan_data->state.configured) {
+		k_spin_unlock(&dma_data->lock, key);
 		LOG_ERR("Channel %u not configured", channel);
 		return -EINVAL;
 	}
 
-	chan_data->state.block_index = 0;
-
-	struct tt_bh_dma_noc_coords *coords = &chan_data->coords;
-	struct dma_block_config *current_block = &chan_data->blocks[chan_data->state.block_index];
-
-	if (!current_block) {
-		LOG_ERR("No valid block configuration");
-		return -EINVAL;
+	if (chan_data->state.phase != NOC_DMA_PHASE_IDLE) {
+		k_spin_unlock(&dma_data->lock, key);
+		LOG_ERR("Channel %u busy", channel);
+		return -EBUSY;
 	}
 
-	int ret;
+	/* Reads come first for both directions that read; everything else is a write */
+	uint32_t direction = chan_data->config.channel_direction;
+	enum tt_bh_dma_noc_phase phase =
+		(direction == MEMORY_TO_MEMORY || direction == MEMORY_TO_PERIPHERAL)
+			? NOC_DMA_PHASE_READ
+			: NOC_DMA_PHASE_WRITE;
 
-	/* Handle different transfer types - all asynchronous except for MEMORY to MEMORY */
-	for (; chan_data->state.block_index < chan_data->state.block_count;
-	     chan_data->state.block_index++) {
-		current_block = &chan_data->blocks[chan_data->state.block_index];
-		if (!current_block) {
-			LOG_ERR("No valid block configuration");
-			return -EINVAL;
-		}
+	chan_data->state.phase = NOC_DMA_PHASE_ISSUE;
+	chan_data->state.timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
+	k_spin_unlock(&dma_data->lock, key);
 
-		switch (chan_data->config.channel_direction) {
-		case MEMORY_TO_MEMORY: {
-			int dest_address_ = current_block->dest_address;
+	int ret = tt_bh_dma_noc_issue(dev, channel, phase);
 
-			current_block->dest_address = current_block->source_address;
-			current_block->source_address = 0;
+	K_SPINLOCK(&dma_data->lock) {
+		chan_data->state.phase = (ret == 0) ? phase : NOC_DMA_PHASE_IDLE;
+	}
 
-			ret = tt_bh_dma_noc_start_mem_to_per(dev, channel);
-			if (ret != 0) {
-				return ret;
-			}
+	if (ret != 0) {
+		return ret;
+	}
 
-			current_block->dest_address = dest_address_;
+	k_work_schedule(&dma_data->completion_work, K_USEC(CONFIG_DMA_TT_BH_NOC_POLL_US));
 
-			/* Wait for read operation to complete */
-			k_timepoint_t timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
-			struct dma_status status;
+	return 0;
+}
 
-			do {
-				dma_get_status(dev, channel, &status);
-			} while (status.busy && !sys_timepoint_expired(timeout));
+/*
+ * Move a channel on once all of its transactions have finished: MEMORY_TO_MEMORY reads are
+ * followed by their writes, and anything else completes. Returns true while the channel is
+ * still active.
+ */
+static bool tt_bh_dma_noc_check_completion(const struct device *dev, uint32_t channel)
+{
+	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *dma_data = (struct tt_bh_dma_noc_data *)dev->data;
+	struct tt_bh_dma_channel_data *chan_data = &cfg->channels[channel];
+	int ret = 0;
 
-			if (sys_timepoint_expired(timeout)) {
-				return -ETIMEDOUT;
-			}
+	k_spinlock_key_t key = k_spin_lock(&dma_data->lock);
 
-			ret = tt_bh_dma_noc_start_per_to_mem(dev, channel);
-			if (ret != 0) {
-				return ret;
-			}
+	if (chan_data->state.phase == NOC_DMA_PHASE_IDLE) {
+		k_spin_unlock(&dma_data->lock, key);
+		return false;
+	}
 
-			/* Wait for write operation to complete */
-			timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
+	if (chan_data->state.phase == NOC_DMA_PHASE_ISSUE) {
+		k_spin_unlock(&dma_data->lock, key);
+		return true;
+	}
 
-			do {
-				dma_get_status(dev, channel, &status);
-			} while (status.busy && !sys_timepoint_expired(timeout));
+	if (tt_bh_dma_noc_outstanding(channel)) {
+		if (!sys_timepoint_expired(chan_data->state.timeout)) {
+			k_spin_unlock(&dma_data->lock, key);
+			return true;
+		}
+		LOG_ERR("Channel %u transfer timed out", channel);
+		ret = -ETIMEDOUT;
+	} else if (chan_data->state.phase == NOC_DMA_PHASE_READ &&
+		   chan_data->config.channel_direction == MEMORY_TO_MEMORY) {
+		chan_data->state.phase = NOC_DMA_PHASE_ISSUE;
+		chan_data->state.timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_TIMEOUT_MS));
+		k_spin_unlock(&dma_data->lock, key);
+
+		ret = tt_bh_dma_noc_issue(dev, channel, NOC_DMA_PHASE_WRITE);
+
+		key = k_spin_lock(&dma_data->lock);
+		if (ret == 0) {
+			chan_data->state.phase = NOC_DMA_PHASE_WRITE;
+			k_spin_unlock(&dma_data->lock, key);
+			return true;
+		}
+	}
 
-			if (sys_timepoint_expired(timeout)) {
-				return -ETIMEDOUT;
-			}
+	chan_data->state.phase = NOC_DMA_PHASE_IDLE;
+	k_spin_unlock(&dma_data->lock, key);
 
-			/* Invoke callback function at transfer or block completion */
-			handle_transfer_callbacks(dev, chan_data, channel, 0,
-						  chan_data->state.block_index + 1 ==
-							  chan_data->state.block_count);
+	/* Invoke callback function at transfer or block completion */
+	for (uint16_t i = 0; i < chan_data->state.block_count; i++) {
+		bool is_final_block = i + 1 == chan_data->state.block_count;
 
-			break;
-		}
-		case MEMORY_TO_PERIPHERAL: {
-			return tt_bh_dma_noc_start_mem_to_per(dev, channel);
-		}
-		case PERIPHERAL_TO_MEMORY: {
-			return tt_bh_dma_noc_start_per_to_mem(dev, channel);
-		}
-		case TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST: {
-			/* Use pre translation coords as NOC translation has enabled. */
-			uint8_t remote_start_x = 2;
-			uint8_t remote_start_y = 2;
-			uint8_t remote_end_x = 1;
-			uint8_t remote_end_y = 11;
-			uint64_t local_addr = current_block->source_address;
-			uint64_t remote_addr = current_block->dest_address;
-
-			ret = noc_dma_write_multicast(
-				coords->dest_x, coords->dest_y, local_addr, remote_start_x,
-				remote_start_y, remote_end_x, remote_end_y, remote_addr,
-				current_block->block_size, false, &chan_data->state.last_noc_cmd,
-				&chan_data->state.last_expected_acks);
-
-			return ret;
-		}
-		default:
-			LOG_ERR("Invalid channel direction %d",
-				chan_data->config.channel_direction);
-			return -EINVAL;
+		if (ret == 0 || is_final_block) {
+			handle_transfer_callbacks(dev, chan_data, channel, ret, is_final_block);
 		}
+	}
 
-		if (chan_data->config.linked_channel != DMA_CHANNEL_INVALID) {
-			uint32_t linked_chan = chan_data->config.linked_channel;
-			if (linked_chan < cfg->num_channels &&
-			    cfg->channels[linked_chan].state.configured) {
-				if (chan_data->config.dest_chaining_en ||
-				    chan_data->config.source_chaining_en) {
-					tt_bh_dma_noc_start(dev, linked_chan);
-				}
-			}
+	if (ret == 0 && chan_data->config.linked_channel != DMA_CHANNEL_INVALID &&
+	    (chan_data->config.dest_chaining_en || chan_data->config.source_chaining_en)) {
+		uint32_t linked_chan = chan_data->config.linked_channel;
+
+		if (linked_chan < cfg->num_channels) {
+			tt_bh_dma_noc_start(dev, linked_chan);
 		}
 	}
 
-	return 0;
+	return false;
+}
+
+static void tt_bh_dma_noc_completion_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tt_bh_dma_noc_data *dma_data =
+		CONTAINER_OF(dwork, struct tt_bh_dma_noc_data, completion_work);
+	const struct device *dev = dma_data->dev;
+	const struct tt_bh_dma_noc_config *cfg = (const struct tt_bh_dma_noc_config *)dev->config;
+	bool any_active = false;
+
+	for (uint32_t channel = 0; channel < cfg->num_channels; channel++) {
+		any_active |= tt_bh_dma_noc_check_completion(dev, channel);
+	}
+
+	if (any_active) {
+		k_work_schedule(&dma_data->completion_work, K_USEC(CONFIG_DMA_TT_BH_NOC_POLL_US));
+	}
 }
 
 static int tt_bh_dma_noc_init(const struct device *dev)
 {
+	struct tt_bh_dma_noc_data *dma_data = (struct tt_bh_dma_noc_data *)dev->data;
+
+	dma_data->dev = dev;
+	k_mutex_init(&dma_data->issue_lock);
+	k_work_init_delayable(&dma_data->completion_work, tt_bh_dma_noc_completion_work_handler);
+
 	return 0;
 }
 
@@ -501,18 +542,28 @@ static int tt_bh_dma_noc_get_status(const struct device *dev, uint32_t channel,
 
 	struct tt_bh_dma_channel_data *chan_data = &dma_cfg->channels[channel];
 
-	uint32_t ack_reg_addr = (chan_data->state.last_noc_cmd & NOC_CMD_WR)
-					? NIU_MST_WR_ACK_RECEIVED
-					: NIU_MST_RD_RESP_RECEIVED;
-	uint32_t ack_received = NOC2AXIRead32(NOC_DMA_NOC_ID, NOC_DMA_TLB, ack_reg_addr);
-
-	status->busy = is_behind(ack_received, chan_data->state.last_expected_acks);
+	status->busy = tt_bh_dma_noc_check_completion(dev, channel);
+	status->dir = chan_data->config.channel_direction;
+	status->pending_length = 0;
 
 	return 0;
 }
 
 static int tt_bh_dma_noc_stop(const struct device *dev, uint32_t channel)
 {
+	const struct tt_bh_dma_noc_config *dma_cfg =
+		(const struct tt_bh_dma_noc_config *)dev->config;
+	struct tt_bh_dma_noc_data *dma_data = (struct tt_bh_dma_noc_data *)dev->data;
+
+	if (channel >= dma_cfg->num_channels) {
+		return -EINVAL;
+	}
+
+	/* Commands already issued cannot be recalled; stop tracking them */
+	K_SPINLOCK(&dma_data->lock) {
+		dma_cfg->channels[channel].state.phase = NOC_DMA_PHASE_IDLE;
+	}
+
 	return 0;
 }
 
@@ -530,6 +581,10 @@ static const struct dma_driver_api tt_bh_dma_noc_api = {
 };
 
 #define TT_BH_DMA_NOC_INIT(inst)                                                                   \
+	BUILD_ASSERT(NOC_DMA_TRID_BASE + DT_INST_PROP(inst, dma_channels) - 1 <= NOC_DMA_MAX_TRID, \
+		     "Not enough NOC transaction IDs for all NOC DMA channels");                   \
+	BUILD_ASSERT(NOC_DMA_TLB_BASE + DT_INST_PROP(inst, dma_channels) <= NOC_DMA_NUM_TLBS,      \
+		     "Not enough NOC2AXI TLBs for all NOC DMA channels");                          \
 	static struct tt_bh_dma_channel_data                                                       \
 		tt_bh_dma_noc_channels_##inst[DT_INST_PROP(inst, dma_channels)];                   \
                                                                                                    \
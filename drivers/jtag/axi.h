@@ -11,6 +11,10 @@
 #define AXI_CNTL_READ  BIT(31)
 #define AXI_CNTL_WRITE (BIT(31) | BIT(8) | BIT_MASK(4))
 
+/* Bits of the control/status TDR when it is read back */
+#define AXI_STATUS_DONE      BIT_MASK(4)
+#define AXI_STATUS_WRITE_ERR BIT(16)
+
 #define ARC_AXI_ADDR_TDR           (2)
 #define ARC_AXI_DATA_TDR           (3)
 #define ARC_AXI_CONTROL_STATUS_TDR (4)
@@ -6,7 +6,6 @@
 
 #include "axi.h"
 #include "jtag_profile_functions.h"
-#include "tenstorrent/bitrev.h"
 
 #include "jtag_priv.h"
 
@@ -56,6 +55,16 @@ typedef union {
 static uint32_t io_ops;
 #endif
 
+#ifdef CONFIG_JTAG_EMUL
+/* Writes to the TCK, TDI and TMS GPIOs. Unlike io_ops, these are counted with the GPIOs driven, so
+ * tests can check how many writes clocking a bit takes.
+ */
+static uint32_t gpio_writes;
+#define GPIO_WRITES_INC() gpio_writes++
+#else
+#define GPIO_WRITES_INC()
+#endif
+
 LOG_MODULE_REGISTER(jtag_bitbang, CONFIG_JTAG_LOG_LEVEL);
 
 #ifdef CONFIG_JTAG_USE_MMAPPED_IO
@@ -94,7 +103,7 @@ LOG_MODULE_REGISTER(jtag_bitbang, CONFIG_JTAG_LOG_LEVEL);
 #define CLR_TCK(x) IO_OPS_INC()
 
 #define SET_TDI(x) IO_OPS_INC()
-#define CLR_CLR(x) IO_OPS_INC()
+#define CLR_TDI(x) IO_OPS_INC()
 
 static bool GET_TDO(const struct jtag_config *config)
 {
@@ -109,19 +118,23 @@ static bool GET_TDO(const struct jtag_config *config)
 
 static void SET_TCK(const struct jtag_config *config)
 {
+	GPIO_WRITES_INC();
 	gpio_pin_set_dt(&config->tck, 1);
 }
 static void CLR_TCK(const struct jtag_config *config)
 {
+	GPIO_WRITES_INC();
 	gpio_pin_set_dt(&config->tck, 0);
 }
 
 static void SET_TDI(const struct jtag_config *config)
 {
+	GPIO_WRITES_INC();
 	gpio_pin_set_dt(&config->tdi, 1);
 }
 static void CLR_TDI(const struct jtag_config *config)
 {
+	GPIO_WRITES_INC();
 	gpio_pin_set_dt(&config->tdi, 0);
 }
 
@@ -132,10 +145,12 @@ static bool GET_TDO(const struct jtag_config *config)
 
 static void SET_TMS(const struct jtag_config *config)
 {
+	GPIO_WRITES_INC();
 	gpio_pin_set_dt(&config->tms, 1);
 }
 static void CLR_TMS(const struct jtag_config *config)
 {
+	GPIO_WRITES_INC();
 	gpio_pin_set_dt(&config->tms, 0);
 }
 
@@ -152,159 +167,267 @@ static void CLR_TMS(const struct jtag_config *config)
 
 #endif /* CONFIG_JTAG_USE_MMAPPED_IO */
 
-static ALWAYS_INLINE void jtag_bitbang_tick(const struct device *dev, uint32_t count)
+/* Write word to the GPIO port of TCK, TDI and TMS. With memory-mapped I/O, word is for the bit
+ * set/reset register and mask is implied by it.
+ */
+static ALWAYS_INLINE void jtag_bitbang_port_write(const struct jtag_config *config,
+						  gpio_port_pins_t mask, uint32_t word)
 {
-	const struct jtag_config *config = dev->config;
+#if defined(CONFIG_JTAG_USE_MMAPPED_IO)
+	ARG_UNUSED(mask);
+	*TCK_BSSR(config) = word;
+#elif defined(CONFIG_JTAG_PROFILE_FUNCTIONS)
+	ARG_UNUSED(config);
+	ARG_UNUSED(mask);
+	ARG_UNUSED(word);
+	IO_OPS_INC();
+#else
+	GPIO_WRITES_INC();
+	gpio_port_set_masked_raw(config->tck.port, mask, word);
+#endif
+}
 
-	for (; count > 0; --count) {
-		CLR_TCK(config);
-		SET_TCK(config);
+/* Return true if any of the TDO pins in mask is high. The pins must share a GPIO port. */
+static ALWAYS_INLINE bool jtag_bitbang_tdo_any(const struct jtag_config *config,
+					       gpio_port_pins_t mask)
+{
+#if defined(CONFIG_JTAG_USE_MMAPPED_IO)
+	return (*TDO_IN(config) & mask) != 0;
+#elif defined(CONFIG_JTAG_PROFILE_FUNCTIONS)
+	ARG_UNUSED(mask);
+	return GET_TDO(config);
+#else
+	gpio_port_value_t value = 0;
+
+	(void)gpio_port_get_raw(config->tdo.port, &value);
+
+	return (value & mask) != 0;
+#endif
+}
+
+/* Clock one bit through the TAP and return TDO if capture is set. Batched, the falling edge of TCK
+ * is driven together with TMS and TDI, and TCK is left high until jtag_bitbang_tck_low().
+ */
+static ALWAYS_INLINE bool jtag_bitbang_clock(const struct jtag_config *config,
+					     const struct jtag_data *data, bool tms, bool tdi,
+					     bool capture)
+{
+	bool tdo = false;
+
+	if (data->batched) {
+		jtag_bitbang_port_write(config, data->port_mask, data->bit_word[tms][tdi]);
+		jtag_bitbang_port_write(config, data->tck_mask, data->tck_high_word);
+		if (capture) {
+			tdo = (data->tdo_mask != 0) ? jtag_bitbang_tdo_any(config, data->tdo_mask)
+						    : GET_TDO(config);
+		}
+
+		return tdo;
+	}
+
+	if (tms) {
+		SET_TMS(config);
+	} else {
+		CLR_TMS(config);
 	}
+	IF_TDI(config, tdi);
+	if (capture) {
+		tdo = GET_TDO(config);
+	}
+	SET_TCK(config);
 	CLR_TCK(config);
+
+	return tdo;
+}
+
+static ALWAYS_INLINE void jtag_bitbang_tck_low(const struct jtag_config *config,
+					       const struct jtag_data *data)
+{
+	if (data->batched) {
+		jtag_bitbang_port_write(config, data->tck_mask, data->tck_low_word);
+	} else {
+		CLR_TCK(config);
+	}
+}
+
+/* Clock count TMS bits, LSB first, to move between TAP states */
+static ALWAYS_INLINE void jtag_bitbang_tms(const struct jtag_config *config,
+					   const struct jtag_data *data, uint32_t count,
+					   uint32_t tms_bits)
+{
+	for (; count > 0; --count, tms_bits >>= 1) {
+		jtag_bitbang_clock(config, data, tms_bits & 0x1, false, false);
+	}
+}
+
+/* Shift count bits of data in, LSB first, raising TMS with the last one to exit the shift state */
+static ALWAYS_INLINE uint64_t jtag_bitbang_shift(const struct jtag_config *config,
+						 const struct jtag_data *data, uint32_t count,
+						 uint64_t data_in, bool capture)
+{
+	uint64_t data_out = 0;
+
+	for (uint32_t i = 0; i < count; ++i, data_in >>= 1) {
+		if (jtag_bitbang_clock(config, data, i == count - 1, data_in & 0x1, capture)) {
+			data_out |= BIT64(i);
+		}
+	}
+
+	return data_out;
 }
 
 int jtag_bitbang_reset(const struct device *dev)
 {
 	const struct jtag_config *config = dev->config;
+	const struct jtag_data *data = dev->data;
 
 	if (config->trst.port != NULL) {
 		gpio_pin_set_dt(&config->trst, 1);
 		k_busy_wait(100);
 		gpio_pin_set_dt(&config->trst, 0);
 	}
-	CLR_TDI(config);
-	SET_TMS(config);
-
-	jtag_bitbang_tick(dev, 5);
 
-	CLR_TMS(config);
+	/* TCK is high after setup, so start low for the first bit to get a rising edge */
+	jtag_bitbang_tck_low(config, data);
 
-	jtag_bitbang_tick(dev, 1);
+	/* Test-logic reset, then idle */
+	jtag_bitbang_tms(config, data, 6, 0b011111);
+	jtag_bitbang_tck_low(config, data);
 
 	return 0;
 }
 
-static ALWAYS_INLINE void jtag_bitbang_update_ir(const struct device *dev, uint32_t count,
-						 uint64_t data)
+static ALWAYS_INLINE void jtag_bitbang_update_ir(const struct jtag_config *config,
+						 const struct jtag_data *data, uint32_t count,
+						 uint64_t data_in)
 {
-	const struct jtag_config *config = dev->config;
-
-	/* Select IR scan */
-	SET_TMS(config);
-	jtag_bitbang_tick(dev, 2);
+	/* Select DR scan, select IR scan, capture IR */
+	jtag_bitbang_tms(config, data, 3, 0b011);
 
-	/* Capture IR */
-	CLR_TMS(config);
-	jtag_bitbang_tick(dev, 1);
+	/* Shift IR, exit IR */
+	jtag_bitbang_shift(config, data, count, data_in, false);
 
-	/* Shift IR */
-	for (; count > 1; --count, data >>= 1) {
-		IF_TDI(config, data & 0x1);
-		jtag_bitbang_tick(dev, 1);
-	}
-
-	/* Exit IR */
-	SET_TMS(config);
-	IF_TDI(config, data & 0x1);
-	jtag_bitbang_tick(dev, 1);
-
-	/* Select DR scan */
-	SET_TMS(config);
-	jtag_bitbang_tick(dev, 2);
+	/* Update IR, select DR scan */
+	jtag_bitbang_tms(config, data, 2, 0b11);
+	jtag_bitbang_tck_low(config, data);
 }
 
-static ALWAYS_INLINE uint64_t jtag_bitbang_xfer_dr(const struct device *dev, uint32_t count,
+static ALWAYS_INLINE uint64_t jtag_bitbang_xfer_dr(const struct jtag_config *config,
+						   const struct jtag_data *data, uint32_t count,
 						   uint64_t data_in, bool idle, bool capture)
 {
 	if (count == 0) {
 		return 0;
 	}
 
-	const struct jtag_config *config = dev->config;
-
-	uint64_t starting_count = count;
-	uint64_t data_out = 0;
-
-	/* DR Scan */
-	CLR_TMS(config);
-	jtag_bitbang_tick(dev, 1);
+	uint64_t data_out;
 
 	/* Capture DR */
-	jtag_bitbang_tick(dev, 1);
-
-	/* Shift DR */
-	for (; count > 1; --count, data_in >>= 1) {
-		IF_TDI(config, data_in & 0x1);
-		if (capture) {
-			data_out |= GET_TDO(config);
-			data_out <<= 1;
-		}
-		jtag_bitbang_tick(dev, 1);
-	}
-	SET_TMS(config);
-	IF_TDI(config, data_in & 0x1);
-	if (capture) {
-		data_out |= GET_TDO(config);
-	}
-	jtag_bitbang_tick(dev, 1);
+	jtag_bitbang_tms(config, data, 2, 0b00);
 
-	/* Exit DR */
-	jtag_bitbang_tick(dev, 1);
+	/* Shift DR, exit DR */
+	data_out = jtag_bitbang_shift(config, data, count, data_in, capture);
 
-	if (idle) {
-		/* Update DR */
-		CLR_TMS(config);
-		jtag_bitbang_tick(dev, 1);
-
-		/* Idle */
-	} else {
-		/* Update DR */
-		jtag_bitbang_tick(dev, 1);
-
-		/* DR scan */
-	}
-
-	if (capture) {
-		data_out <<= 64 - starting_count;
-		data_out = bitrev64(data_out);
-	}
+	/* Update DR, then idle or select DR scan */
+	jtag_bitbang_tms(config, data, 2, idle ? 0b01 : 0b11);
+	jtag_bitbang_tck_low(config, data);
 
 	return data_out;
 }
 
-static ALWAYS_INLINE uint64_t jtag_bitbang_capture_dr_idle(const struct device *dev, uint32_t count,
-							   uint64_t data_in)
+static ALWAYS_INLINE uint64_t jtag_bitbang_capture_dr_idle(const struct jtag_config *config,
+							   const struct jtag_data *data,
+							   uint32_t count, uint64_t data_in)
 {
-	return jtag_bitbang_xfer_dr(dev, count, data_in, true, true);
+	return jtag_bitbang_xfer_dr(config, data, count, data_in, true, true);
 }
 
-static ALWAYS_INLINE uint64_t jtag_bitbang_capture_dr(const struct device *dev, uint32_t count,
+static ALWAYS_INLINE uint64_t jtag_bitbang_capture_dr(const struct jtag_config *config,
+						      const struct jtag_data *data, uint32_t count,
 						      uint64_t data_in)
 {
-	return jtag_bitbang_xfer_dr(dev, count, data_in, false, true);
+	return jtag_bitbang_xfer_dr(config, data, count, data_in, false, true);
 }
 
-static ALWAYS_INLINE void jtag_bitbang_update_dr_idle(const struct device *dev, uint32_t count,
+static ALWAYS_INLINE void jtag_bitbang_update_dr_idle(const struct jtag_config *config,
+						      const struct jtag_data *data, uint32_t count,
 						      uint64_t data_in)
 {
-	(void)jtag_bitbang_xfer_dr(dev, count, data_in, true, false);
+	(void)jtag_bitbang_xfer_dr(config, data, count, data_in, true, false);
 }
 
-static ALWAYS_INLINE void jtag_bitbang_update_dr(const struct device *dev, uint32_t count,
+static ALWAYS_INLINE void jtag_bitbang_update_dr(const struct jtag_config *config,
+						 const struct jtag_data *data, uint32_t count,
 						 uint64_t data_in)
 {
-	(void)jtag_bitbang_xfer_dr(dev, count, data_in, false, false);
+	(void)jtag_bitbang_xfer_dr(config, data, count, data_in, false, false);
 }
 
 int jtag_bitbang_read_id(const struct device *dev, uint32_t *id)
 {
+	const struct jtag_config *config = dev->config;
+	const struct jtag_data *data = dev->data;
 	uint32_t tap_addr = 6;
 
-	jtag_bitbang_update_ir(dev, 24, tap_addr);
-	*id = jtag_bitbang_capture_dr_idle(dev, 32, 0);
+	jtag_bitbang_update_ir(config, data, 24, tap_addr);
+	*id = jtag_bitbang_capture_dr_idle(config, data, 32, 0);
 	return 0;
 }
 
+#ifndef CONFIG_JTAG_USE_MMAPPED_IO
+/* Raw port value that drives a pin to a logical value */
+static uint32_t jtag_bitbang_raw(const struct gpio_dt_spec *spec, bool value)
+{
+	return (value ^ ((spec->dt_flags & GPIO_ACTIVE_LOW) != 0)) ? BIT(spec->pin) : 0;
+}
+#endif
+
+/* Precompute the port writes that clock one bit, if TCK, TDI and TMS share a GPIO port */
+static void jtag_bitbang_setup_batch(const struct device *dev)
+{
+	const struct jtag_config *config = dev->config;
+	struct jtag_data *data = dev->data;
+
+	data->batched = false;
+	if (!IS_ENABLED(CONFIG_JTAG_BITBANG_BATCHED)) {
+		return;
+	}
+
+#ifdef CONFIG_JTAG_USE_MMAPPED_IO
+	if (config->tdi_reg != config->tck_reg || config->tms_reg != config->tck_reg) {
+		return;
+	}
+
+	for (int tms = 0; tms <= 1; ++tms) {
+		for (int tdi = 0; tdi <= 1; ++tdi) {
+			data->bit_word[tms][tdi] = (tms ? TMS_HIGH(config) : TMS_LOW(config)) |
+						   (tdi ? TDI_HIGH(config) : TDI_LOW(config)) |
+						   TCK_LOW(config);
+		}
+	}
+	data->tck_high_word = TCK_HIGH(config);
+	data->tck_low_word = TCK_LOW(config);
+#else
+	if (config->tdi.port != config->tck.port || config->tms.port != config->tck.port) {
+		return;
+	}
+
+	data->port_mask = BIT(config->tck.pin) | BIT(config->tdi.pin) | BIT(config->tms.pin);
+	data->tck_mask = BIT(config->tck.pin);
+	for (int tms = 0; tms <= 1; ++tms) {
+		for (int tdi = 0; tdi <= 1; ++tdi) {
+			data->bit_word[tms][tdi] = jtag_bitbang_raw(&config->tms, tms) |
+						   jtag_bitbang_raw(&config->tdi, tdi) |
+						   jtag_bitbang_raw(&config->tck, false);
+		}
+	}
+	data->tck_high_word = jtag_bitbang_raw(&config->tck, true);
+	data->tck_low_word = jtag_bitbang_raw(&config->tck, false);
+#endif
+
+	data->batched = true;
+}
+
 int jtag_bitbang_setup(const struct device *dev)
 {
 	const struct jtag_config *config = dev->config;
@@ -320,6 +443,8 @@ int jtag_bitbang_setup(const struct device *dev)
 		return ret;
 	}
 
+	jtag_bitbang_setup_batch(dev);
+
 #ifdef CONFIG_JTAG_USE_MMAPPED_IO
 	volatile uint32_t *TCK_SPEED = (volatile uint32_t *)config->tck_reg + 2;
 	volatile uint32_t *TDI_SPEED = (volatile uint32_t *)config->tdi_reg + 2;
@@ -364,7 +489,8 @@ static int jtag_bitbang_teardown(const struct device *dev)
 	return 0;
 }
 
-static ALWAYS_INLINE void jtag_setup_access(const struct device *dev, uint32_t rtap_addr)
+static ALWAYS_INLINE void jtag_setup_access(const struct jtag_config *config,
+					    const struct jtag_data *data, uint32_t rtap_addr)
 {
 	jtag_instr_u instrn;
 
@@ -375,123 +501,282 @@ static ALWAYS_INLINE void jtag_setup_access(const struct device *dev, uint32_t r
 		(rtap_addr >> (INSTR_REG_BISTEN_SEL_END_0 - INSTR_REG_BISTEN_SEL_START_0 + 1)) &
 		INSTR_REG_BISTEN_SEL_MASK_1;
 
-	jtag_bitbang_update_ir(dev, 24, instrn.val);
+	jtag_bitbang_update_ir(config, data, 24, instrn.val);
 }
 
-static ALWAYS_INLINE uint32_t jtag_access_rtap_tdr_idle(const struct device *dev,
+static ALWAYS_INLINE uint32_t jtag_access_rtap_tdr_idle(const struct jtag_config *config,
+							const struct jtag_data *data,
 							uint32_t rtap_addr, uint32_t tdr_addr,
 							uint32_t wrdata)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr_idle(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1,
+	jtag_bitbang_update_dr(config, data, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
+	return SIBSHIFT(jtag_bitbang_capture_dr_idle(config, data, TENSIX_TDRLEN_SIBLEN_PLUS_1,
 						     SIBSHIFTUP((uint64_t)wrdata)));
 }
 
-static ALWAYS_INLINE uint32_t jtag_access_rtap_tdr(const struct device *dev, uint32_t rtap_addr,
+static ALWAYS_INLINE uint32_t jtag_access_rtap_tdr(const struct jtag_config *config,
+						   const struct jtag_data *data, uint32_t rtap_addr,
 						   uint32_t tdr_addr, uint32_t wrdata)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1,
+	jtag_bitbang_update_dr(config, data, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
+	return SIBSHIFT(jtag_bitbang_capture_dr(config, data, TENSIX_TDRLEN_SIBLEN_PLUS_1,
 						SIBSHIFTUP((uint64_t)wrdata)));
 }
 
-static ALWAYS_INLINE void jtag_wr_tensix_sm_rtap_tdr_idle(const struct device *dev,
+static ALWAYS_INLINE void jtag_wr_tensix_sm_rtap_tdr_idle(const struct jtag_config *config,
+							  const struct jtag_data *data,
 							  uint32_t tdr_addr, uint32_t wrvalue)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	jtag_bitbang_update_dr_idle(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1,
+	jtag_bitbang_update_dr(config, data, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
+	jtag_bitbang_update_dr_idle(config, data, TENSIX_TDRLEN_SIBLEN_PLUS_1,
 				    SIBSHIFTUP((uint64_t)wrvalue));
 }
 
-static ALWAYS_INLINE void jtag_wr_tensix_sm_rtap_tdr(const struct device *dev, uint32_t tdr_addr,
-						     uint32_t wrvalue)
+static ALWAYS_INLINE void jtag_wr_tensix_sm_rtap_tdr(const struct jtag_config *config,
+						     const struct jtag_data *data,
+						     uint32_t tdr_addr, uint32_t wrvalue)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	jtag_bitbang_update_dr(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1, SIBSHIFTUP((uint64_t)wrvalue));
+	jtag_bitbang_update_dr(config, data, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
+	jtag_bitbang_update_dr(config, data, TENSIX_TDRLEN_SIBLEN_PLUS_1,
+			       SIBSHIFTUP((uint64_t)wrvalue));
 }
 
-static ALWAYS_INLINE uint32_t jtag_rd_tensix_sm_rtap_tdr_idle(const struct device *dev,
+static ALWAYS_INLINE uint32_t jtag_rd_tensix_sm_rtap_tdr_idle(const struct jtag_config *config,
+							      const struct jtag_data *data,
 							      uint32_t tdr_addr)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr_idle(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1, 0));
+	jtag_bitbang_update_dr(config, data, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
+	return SIBSHIFT(jtag_bitbang_capture_dr_idle(config, data, TENSIX_TDRLEN_SIBLEN_PLUS_1, 0));
 }
 
-static ALWAYS_INLINE uint32_t jtag_rd_tensix_sm_rtap_tdr(const struct device *dev,
+static ALWAYS_INLINE uint32_t jtag_rd_tensix_sm_rtap_tdr(const struct jtag_config *config,
+							 const struct jtag_data *data,
 							 uint32_t tdr_addr)
 {
-	jtag_bitbang_update_dr(dev, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
-	return SIBSHIFT(jtag_bitbang_capture_dr(dev, TENSIX_TDRLEN_SIBLEN_PLUS_1, 0));
+	jtag_bitbang_update_dr(config, data, TENSIX_SIBLEN_PLUS_1_OR_0, (uint64_t)tdr_addr + 1);
+	return SIBSHIFT(jtag_bitbang_capture_dr(config, data, TENSIX_TDRLEN_SIBLEN_PLUS_1, 0));
 }
 
 void jtag_req_clear(const struct device *dev)
 {
-	jtag_setup_access(dev, TENSIX_SM_RTAP);
+	const struct jtag_config *config = dev->config;
+	const struct jtag_data *data = dev->data;
+
+	jtag_setup_access(config, data, TENSIX_SM_RTAP);
 
-	jtag_wr_tensix_sm_rtap_tdr_idle(dev, 2, AXI_CNTL_CLEAR);
+	jtag_wr_tensix_sm_rtap_tdr_idle(config, data, 2, AXI_CNTL_CLEAR);
 }
 
 int jtag_axiread(const struct device *dev, uint32_t addr, uint32_t *result)
 {
-	jtag_setup_access(dev, TENSIX_SM_RTAP);
+	const struct jtag_config *config = dev->config;
+	const struct jtag_data *data = dev->data;
+
+	jtag_setup_access(config, data, TENSIX_SM_RTAP);
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr);
+	jtag_wr_tensix_sm_rtap_tdr(config, data, ARC_AXI_ADDR_TDR, addr);
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_READ);
+	jtag_wr_tensix_sm_rtap_tdr(config, data, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_READ);
 
 	uint32_t axi_status = 1;
 
 	for (int i = 0; i < 1000; ++i) {
-		axi_status = jtag_rd_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR);
+		axi_status = jtag_rd_tensix_sm_rtap_tdr(config, data, ARC_AXI_CONTROL_STATUS_TDR);
 		if ((axi_status & 0xF) != 0) {
 			break;
 		}
 	}
 
 	/* Read data */
-	uint32_t axi_rddata = jtag_rd_tensix_sm_rtap_tdr_idle(dev, ARC_AXI_DATA_TDR);
+	uint32_t axi_rddata = jtag_rd_tensix_sm_rtap_tdr_idle(config, data, ARC_AXI_DATA_TDR);
 
 	*result = axi_rddata;
 	return (axi_status & 0xF) != 0 ? 0 : -1;
 }
 
+/* Upper 16 bits of the control/status TDR contain the write status; bit 16 set means failure */
+static ALWAYS_INLINE int jtag_axiwrite_result(uint32_t axi_status)
+{
+	return ((axi_status >> 16) & 1) != 1 ? 0 : -1;
+}
+
+/*
+ * Start an AXI write. The TAP must have been selected with jtag_setup_access().
+ *
+ * Returns the control/status TDR as it was before this write was started, which holds the
+ * status of the previous write.
+ */
+static ALWAYS_INLINE uint32_t jtag_axiwrite_start(const struct jtag_config *config,
+						  const struct jtag_data *data, uint32_t addr,
+						  uint32_t value)
+{
+	jtag_wr_tensix_sm_rtap_tdr(config, data, ARC_AXI_ADDR_TDR, addr);
+	jtag_wr_tensix_sm_rtap_tdr(config, data, ARC_AXI_DATA_TDR, value);
+
+	return jtag_access_rtap_tdr(config, data, TENSIX_SM_RTAP, ARC_AXI_CONTROL_STATUS_TDR,
+				    AXI_CNTL_WRITE);
+}
+
+static ALWAYS_INLINE int jtag_axiwrite_status(const struct jtag_config *config,
+					      const struct jtag_data *data)
+{
+	return jtag_axiwrite_result(
+		jtag_rd_tensix_sm_rtap_tdr_idle(config, data, ARC_AXI_CONTROL_STATUS_TDR));
+}
+
 int jtag_axiwrite(const struct device *dev, uint32_t addr, uint32_t value)
 {
-	jtag_setup_access(dev, TENSIX_SM_RTAP);
+	const struct jtag_config *config = dev->config;
+	const struct jtag_data *data = dev->data;
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_ADDR_TDR, addr);
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_DATA_TDR, value);
+	jtag_setup_access(config, data, TENSIX_SM_RTAP);
 
-	jtag_wr_tensix_sm_rtap_tdr(dev, ARC_AXI_CONTROL_STATUS_TDR, AXI_CNTL_WRITE);
+	jtag_axiwrite_start(config, data, addr, value);
 
-	/* Upper 16 bits contain write status; if first bit 1 then we passed otherwsie */
-	/* fail */
-	return ((jtag_rd_tensix_sm_rtap_tdr_idle(dev, ARC_AXI_CONTROL_STATUS_TDR) >> 16) & 1) != 1
-		       ? 0
-		       : -1;
+	return jtag_axiwrite_status(config, data);
+}
+
+static int jtag_bitbang_blockwrite(const struct jtag_config *config,
+				   const struct jtag_data *data, uint32_t addr,
+				   const uint32_t *value, uint32_t len)
+{
+	int result = 0;
+
+	/* The TAP stays selected for the whole block, and each write only shifts in its address,
+	 * data and control. An AXI write finishes long before the next one has been shifted in, so
+	 * the status of each write is captured while the control of the next one is shifted in, at
+	 * no extra TCK cost. Only the last write needs a separate status read.
+	 */
+	jtag_setup_access(config, data, TENSIX_SM_RTAP);
+	for (uint32_t i = 0; i < len; ++i) {
+		uint32_t prev_status = jtag_axiwrite_start(config, data, addr + (4 * i), value[i]);
+
+		if (i > 0 && jtag_axiwrite_result(prev_status) != 0) {
+			result = -1;
+			break;
+		}
+	}
+
+	/* Reading the last status also returns the TAP to Run-Test/Idle, which the next access
+	 * starts from, even when the block has stopped at a failed write
+	 */
+	if (jtag_axiwrite_status(config, data) != 0) {
+		result = -1;
+	}
+
+	return result;
 }
 
 int jtag_axi_blockwrite(const struct device *dev, uint32_t addr, const uint32_t *value,
 			uint32_t len)
 {
-	int result = 0;
+	int result;
 
-	CYCLES_ENTRY();
-	for (int i = 0; i < len; ++i) {
-		result |= jtag_axiwrite(dev, addr + (4 * i), value[i]);
+	if (len == 0) {
+		return 0;
 	}
+
+	CYCLES_ENTRY();
+	result = jtag_bitbang_blockwrite(dev->config, dev->data, addr, value, len);
 	CYCLES_EXIT();
 
 	return result;
 }
 
+/* Devices can be clocked together if each batches its bits on the same port, with TDO on a shared
+ * port too
+ */
+static bool jtag_bitbang_can_gang(const struct device *const *devs, size_t count)
+{
+	const struct jtag_config *first = devs[0]->config;
+
+	for (size_t i = 0; i < count; ++i) {
+		const struct jtag_config *config = devs[i]->config;
+		const struct jtag_data *data = devs[i]->data;
+
+		if (devs[i]->api != devs[0]->api || !data->batched) {
+			return false;
+		}
+#ifdef CONFIG_JTAG_USE_MMAPPED_IO
+		if (config->tck_reg != first->tck_reg || config->tdo_reg != first->tdo_reg) {
+			return false;
+		}
+#else
+		if (config->tck.port != first->tck.port || config->tdo.port != first->tdo.port ||
+		    (config->tdo.dt_flags & GPIO_ACTIVE_LOW) != 0) {
+			return false;
+		}
+#endif
+	}
+
+	return true;
+}
+
+int jtag_axi_blockwrite_multi(const struct device *const *devs, size_t count, uint32_t addr,
+			      const uint32_t *value, uint32_t len, int *rets)
+{
+	int result = 0;
+
+	if (len > 0 && count > 1 && jtag_bitbang_can_gang(devs, count)) {
+		/* The pins of every device are on one port, so OR-ing their port writes clocks all
+		 * of the TAPs in lockstep, for the cost of one. Captured status bits are OR-ed too,
+		 * so a failure is only known to be somewhere in the gang.
+		 */
+		struct jtag_data gang_data = {.batched = true};
+
+		for (size_t i = 0; i < count; ++i) {
+			const struct jtag_config *config = devs[i]->config;
+			const struct jtag_data *data = devs[i]->data;
+
+			gang_data.port_mask |= data->port_mask;
+			gang_data.tck_mask |= data->tck_mask;
+			for (int tms = 0; tms <= 1; ++tms) {
+				for (int tdi = 0; tdi <= 1; ++tdi) {
+					gang_data.bit_word[tms][tdi] |= data->bit_word[tms][tdi];
+				}
+			}
+			gang_data.tck_high_word |= data->tck_high_word;
+			gang_data.tck_low_word |= data->tck_low_word;
+			gang_data.tdo_mask |= BIT(config->tdo.pin);
+		}
+
+		if (jtag_bitbang_blockwrite(devs[0]->config, &gang_data, addr, value, len) == 0) {
+			for (size_t i = 0; i < count; ++i) {
+				rets[i] = 0;
+			}
+
+			return 0;
+		}
+
+		LOG_WRN("Ganged block write failed, retrying each device");
+	}
+
+	/* Writing each device in turn tells which of them failed */
+	for (size_t i = 0; i < count; ++i) {
+		rets[i] = jtag_axi_block_write(devs[i], addr, value, len);
+		if (result == 0) {
+			result = rets[i];
+		}
+	}
+
+	return result;
+}
+
+#ifdef CONFIG_JTAG_EMUL
+uint32_t jtag_emul_gpio_writes(void)
+{
+	return gpio_writes;
+}
+#endif
+
 static struct jtag_api jtag_bitbang_api = {.setup = jtag_bitbang_setup,
 					   .teardown = jtag_bitbang_teardown,
 					   .read_id = jtag_bitbang_read_id,
 					   .reset = jtag_bitbang_reset,
 					   .axi_read32 = jtag_axiread,
 					   .axi_write32 = jtag_axiwrite,
-					   .axi_block_write = jtag_axi_blockwrite};
+					   .axi_block_write = jtag_axi_blockwrite,
+					   .axi_block_write_multi = jtag_axi_blockwrite_multi};
 
 static int jtag_bitbang_init(const struct device *dev)
 {
@@ -18,6 +18,8 @@
 #include <zephyr/sys/byteorder.h>
 
 #define REG_BITS 32
+/* TDR scans shift the segment insertion bits first, TENSIX_SM_SIBLEN in jtag_bitbang.c */
+#define SIB_BITS 4
 
 LOG_MODULE_REGISTER(jtag_emul, CONFIG_JTAG_LOG_LEVEL);
 
@@ -69,12 +71,13 @@ __maybe_unused static const char *const jtag_state_to_str[] = {
 	"EXT1_DR", "EXT1_IR", "PAUS_DR", "PAUSE_IR", "EXT2_DR",  "EXT2_IR", "UPDT_DR", "UPDT_IR",
 };
 
-static void on_tck_falling(struct jtag_data *data, bool tdi);
+static void on_tck_rising(struct jtag_data *data, bool tdi);
 
 static inline bool tck(struct jtag_data *data);
 static inline bool tdi(struct jtag_data *data);
 static inline bool tms(struct jtag_data *data);
 static inline bool trst(struct jtag_data *data);
+static void on_tck_falling(struct jtag_data *data);
 
 static void gpio_emul_callback(const struct device *port, struct gpio_callback *cb,
 			       gpio_port_pins_t pins)
@@ -92,8 +95,9 @@ static void gpio_emul_callback(const struct device *port, struct gpio_callback *
 	if (_tck != edata->tck_old) {
 		edata->tck_old = _tck;
 
-		if (!_tck) {
-			on_tck_falling(data, _tdi);
+		/* Like a real TAP, sample TMS and TDI on the rising edge of TCK */
+		if (_tck) {
+			on_tck_rising(data, _tdi);
 			edata->state = next_state[_tms][edata->state];
 
 			/*
@@ -105,10 +109,61 @@ static void gpio_emul_callback(const struct device *port, struct gpio_callback *
 			 */
 
 			++edata->tck_count;
+		} else {
+			on_tck_falling(data);
 		}
 	}
 }
 
+static void on_axi_control(struct jtag_data *data, uint32_t control)
+{
+	struct jtag_emul_data *edata = &data->emul_data;
+	size_t i = edata->axi_addr_tdr >> LOG2(sizeof(uint32_t));
+
+	switch (control) {
+	case AXI_CNTL_WRITE:
+		if (edata->fail_axi_write && edata->axi_addr_tdr == edata->fail_axi_addr) {
+			edata->axi_status = AXI_STATUS_DONE | AXI_STATUS_WRITE_ERR;
+			break;
+		}
+		if (i < data->buf_len) {
+			data->buf[i] = edata->axi_data_tdr;
+			LOG_DBG("W: addr: %03x data: %08x", edata->axi_addr_tdr,
+				edata->axi_data_tdr);
+		}
+		edata->axi_status = AXI_STATUS_DONE;
+		break;
+	case AXI_CNTL_READ:
+		edata->axi_rddata = (i < data->buf_len) ? data->buf[i] : 0;
+		edata->axi_status = AXI_STATUS_DONE;
+		break;
+	default:
+		edata->axi_status = 0;
+		break;
+	}
+}
+
+/* Value of the selected TDR loaded into the shift register when a DR scan captures */
+static uint32_t capture_tdr(struct jtag_data *data)
+{
+	struct jtag_emul_data *edata = &data->emul_data;
+
+	if (!edata->have_tdr) {
+		return 0;
+	}
+
+	switch (edata->tdr) {
+	case ARC_AXI_ADDR_TDR:
+		return edata->axi_addr_tdr;
+	case ARC_AXI_DATA_TDR:
+		return edata->axi_rddata;
+	case ARC_AXI_CONTROL_STATUS_TDR:
+		return edata->axi_status;
+	default:
+		return 0;
+	}
+}
+
 static void on_update_reg(struct jtag_data *data)
 {
 	struct jtag_emul_data *edata = &data->emul_data;
@@ -119,29 +174,32 @@ static void on_update_reg(struct jtag_data *data)
 		edata->hold_reg[DR] =
 			bitrev32(edata->shift_reg[DR]) >> (REG_BITS - edata->shift_bits[DR]);
 
-		if (edata->hold_reg[DR] - 1 == ARC_AXI_ADDR_TDR) {
-			edata->have_axi_addr_tdr = true;
-		} else if (edata->have_axi_addr_tdr) {
-			edata->have_axi_addr_tdr = false;
+		/* TDR accesses alternate between a scan selecting the TDR and one accessing it */
+		if (!edata->have_tdr) {
+			edata->have_tdr = true;
+			edata->tdr = edata->hold_reg[DR] - 1;
+			break;
+		}
+
+		edata->have_tdr = false;
+		switch (edata->tdr) {
+		case ARC_AXI_ADDR_TDR:
 			edata->axi_addr_tdr = edata->hold_reg[DR];
-		} else if (edata->hold_reg[DR] - 1 == ARC_AXI_DATA_TDR) {
-			edata->have_axi_data_tdr = true;
-		} else if (edata->have_axi_data_tdr) {
-			edata->have_axi_data_tdr = false;
+			break;
+		case ARC_AXI_DATA_TDR:
 			edata->axi_data_tdr = edata->hold_reg[DR];
-
-			size_t i = edata->axi_addr_tdr >> LOG2(sizeof(uint32_t));
-
-			if (i < data->buf_len) {
-				data->buf[i] = edata->axi_data_tdr;
-				LOG_DBG("W: addr: %03x data: %08x", edata->axi_addr_tdr,
-					edata->axi_data_tdr);
-			}
+			break;
+		case ARC_AXI_CONTROL_STATUS_TDR:
+			on_axi_control(data, edata->hold_reg[DR]);
+			break;
+		default:
+			break;
 		}
 	} break;
 	case IR:
 		edata->hold_reg[IR] =
 			bitrev32(edata->shift_reg[IR]) >> (REG_BITS - edata->shift_bits[IR] - 1);
+		edata->have_tdr = false;
 		break;
 	default:
 		break;
@@ -150,7 +208,7 @@ static void on_update_reg(struct jtag_data *data)
 
 /* _tms is the "incoming"" _tms value w.r.t. the state diagram */
 /* we only take action here based on the "incoming" TMS value and not the outcoing */
-static void on_tck_falling(struct jtag_data *data, bool _tdi)
+static void on_tck_rising(struct jtag_data *data, bool _tdi)
 {
 	struct jtag_emul_data *edata = &data->emul_data;
 
@@ -160,11 +218,15 @@ static void on_tck_falling(struct jtag_data *data, bool _tdi)
 		edata->selected_reg = (edata->state == SCAN_DR) ? DR : IR;
 		break;
 	case CAPTURE_DR:
+		edata->tdo_shift = (uint64_t)capture_tdr(data) << SIB_BITS;
+		edata->shift_bits[edata->selected_reg] = 0;
+		break;
 	case CAPTURE_IR:
 		edata->shift_bits[edata->selected_reg] = 0;
 		break;
 	case SHIFT_DR:
 	case SHIFT_IR:
+		edata->tdo_shift >>= 1;
 		if (!tms(data)) {
 			edata->shift_reg[edata->selected_reg] <<= 1;
 			edata->shift_reg[edata->selected_reg] |= _tdi;
@@ -180,6 +242,20 @@ static void on_tck_falling(struct jtag_data *data, bool _tdi)
 	}
 }
 
+/* Like a real TAP, change TDO on the falling edge of TCK, so that it is stable around the rising
+ * edge that shifts the next bit
+ */
+static void on_tck_falling(struct jtag_data *data)
+{
+	struct jtag_emul_data *edata = &data->emul_data;
+	bool _tdo = (edata->state == SHIFT_DR) && (edata->tdo_shift & 1);
+
+	if (_tdo != edata->tdo_old) {
+		edata->tdo_old = _tdo;
+		gpio_emul_input_set(data->tdo.port, data->tdo.pin, _tdo);
+	}
+}
+
 static inline bool tck(struct jtag_data *data)
 {
 	return gpio_emul_output_get(data->tck.port, data->tck.pin);
@@ -202,13 +278,14 @@ static inline bool trst(struct jtag_data *data)
 
 void jtag_emul_setup(const struct device *dev, uint32_t *buf, size_t buf_len)
 {
-	const struct jtag_data *cfg = dev->config;
+	const struct jtag_config *cfg = dev->config;
 	struct jtag_data *data = dev->data;
 
 	data->buf = buf;
 	data->buf_len = buf_len;
 
 	data->tck = cfg->tck;
+	data->tdo = cfg->tdo;
 	data->tdi = cfg->tdi;
 	data->tms = cfg->tms;
 	data->trst = cfg->trst;
@@ -216,13 +293,30 @@ void jtag_emul_setup(const struct device *dev, uint32_t *buf, size_t buf_len)
 	data->emul_data = (struct jtag_emul_data){
 		.state = IDLE,
 		.selected_reg = BR,
-		.tck_old = true,
+		.tck_old = gpio_emul_output_get(cfg->tck.port, cfg->tck.pin),
 	};
 
+	gpio_emul_input_set(cfg->tdo.port, cfg->tdo.pin, 0);
+
 	gpio_init_callback(&data->gpio_emul_cb, gpio_emul_callback, BIT(cfg->tck.pin));
 	gpio_add_callback(cfg->tck.port, &data->gpio_emul_cb);
 }
 
+void jtag_emul_fail_axi_write(const struct device *dev, uint32_t addr)
+{
+	struct jtag_data *data = dev->data;
+
+	data->emul_data.fail_axi_write = true;
+	data->emul_data.fail_axi_addr = addr;
+}
+
+size_t jtag_emul_tck_count(const struct device *dev)
+{
+	struct jtag_data *data = dev->data;
+
+	return data->emul_data.tck_count;
+}
+
 int jtag_emul_axi_read32(const struct device *dev, uint32_t addr, uint32_t *value)
 {
 	struct jtag_data *data = dev->data;
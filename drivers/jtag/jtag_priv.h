@@ -46,11 +46,19 @@ struct jtag_emul_data {
 	enum jtag_state state;
 	enum jtag_shift_reg selected_reg;
 	bool tck_old;
+	bool tdo_old;
 	size_t tck_count;
-	bool have_axi_addr_tdr;
+	/* A DR scan selected tdr, and the next one accesses it */
+	bool have_tdr;
+	uint32_t tdr;
+	/* Bits shifted out on TDO, LSB first */
+	uint64_t tdo_shift;
 	uint32_t axi_addr_tdr;
-	bool have_axi_data_tdr;
 	uint32_t axi_data_tdr;
+	uint32_t axi_rddata;
+	uint32_t axi_status;
+	bool fail_axi_write;
+	uint32_t fail_axi_addr;
 	uint32_t *sram;
 	size_t sram_len;
 };
@@ -73,6 +81,16 @@ struct jtag_config {
 };
 
 struct jtag_data {
+	/* TCK, TDI and TMS share a port, so one bit is clocked with two port writes */
+	bool batched;
+	gpio_port_pins_t port_mask;
+	gpio_port_pins_t tck_mask;
+	uint32_t bit_word[2][2]; /* [tms][tdi], with TCK low */
+	uint32_t tck_high_word;
+	uint32_t tck_low_word;
+	/* TDO pins of several devices clocked together, or 0 for a single device */
+	gpio_port_pins_t tdo_mask;
+
 #ifdef CONFIG_JTAG_EMUL
 	struct gpio_dt_spec tck;
 	struct gpio_dt_spec tdo;
@@ -50,6 +50,12 @@ struct bh_chip_data {
 
 	unsigned int bus_cancel_flag;
 
+	/*
+	 * Flag set when the last reset sequence of the chip failed. Nothing talks to the chip
+	 * until a later reset sequence brings it up.
+	 */
+	bool bringup_failed;
+
 	/*
 	 * notify the main thread to apply reset sequence
 	 * also used during initial workaround application to invoke a reset as soon
@@ -145,7 +151,15 @@ extern struct bh_chip BH_CHIPS[BH_CHIP_COUNT];
 
 #define BH_CHIP_PRIMARY_INDEX DT_PROP(DT_PATH(chips), primary)
 
+/* Reset a chip and load its bootcode. On failure, the chip is marked with bringup_failed. */
 int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset);
+/*
+ * Run jtag_bootrom_reset_sequence() on count chips at once, streaming the bootcode to all of them
+ * together. The result of each chip goes into rets[], so a failing chip does not stop the others.
+ * Returns the first error, or 0.
+ */
+int jtag_bootrom_reset_sequence_all(struct bh_chip *chips, size_t count, bool force_reset,
+				    int *rets);
 
 void bh_chip_cancel_bus_transfer_set(struct bh_chip *chip);
 void bh_chip_cancel_bus_transfer_clear(struct bh_chip *chip);
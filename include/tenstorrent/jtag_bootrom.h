@@ -25,10 +25,27 @@ const size_t get_bootcode_len(void);
 int jtag_bootrom_init(struct bh_chip *chip);
 
 int jtag_bootrom_reset_asic(struct bh_chip *chip);
+/*
+ * Reset count chips together, waiting up to CONFIG_JTAG_READY_TIMEOUT_MS for them to come up.
+ * Each chip's result goes into rets[]. Returns the first error, or 0.
+ */
+int jtag_bootrom_reset_asic_all(struct bh_chip *chips, size_t count, int *rets);
 
 int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_t patch_len,
 			      const uint32_t start_addr);
-int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch, size_t patch_len);
+/* Most chips whose patch is written in one go by jtag_bootrom_patch_offset_all() */
+#define JTAG_BOOTROM_PATCH_GANG_MAX 8
+
+/*
+ * Write the same patch to count chips, over their JTAG ports at once where the driver can. Chips
+ * whose rets[] entry is nonzero are skipped. A chip whose write fails gets -EIO and is torn down
+ * without its ARC being started.
+ * Returns the first error, or 0.
+ */
+int jtag_bootrom_patch_offset_all(struct bh_chip *chips, size_t count, const uint32_t *patch,
+				  size_t patch_len, const uint32_t start_addr, int *rets);
+int jtag_bootrom_verify_offset(const struct device *dev, const uint32_t *patch, size_t patch_len,
+			       const uint32_t start_addr);
 void jtag_bootrom_soft_reset_arc(struct bh_chip *chip);
 void jtag_bootrom_teardown(const struct bh_chip *chip);
 
@@ -37,6 +54,13 @@ ALWAYS_INLINE int jtag_bootrom_patch(struct bh_chip *chip, const uint32_t *patch
 	return jtag_bootrom_patch_offset(chip, patch, patch_len, 0);
 }
 
+/* ICCM start addr is 0 */
+ALWAYS_INLINE int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch,
+				      size_t patch_len)
+{
+	return jtag_bootrom_verify_offset(dev, patch, patch_len, 0);
+}
+
 /* for verification via gpio-emul */
 void jtag_bootrom_emul_setup(const uint32_t *buf, size_t buf_len);
 int jtag_bootrom_emul_axiread(uint32_t addr, uint32_t *value);
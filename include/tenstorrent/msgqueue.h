@@ -11,8 +11,24 @@
 
 #include <zephyr/sys/iterable_sections.h>
 
-#define NUM_MSG_QUEUES         4
-#define MSG_QUEUE_SIZE         4
+#ifdef CONFIG_TT_BH_ARC_NUM_MSG_QUEUES
+#define NUM_MSG_QUEUES CONFIG_TT_BH_ARC_NUM_MSG_QUEUES
+#else
+#define NUM_MSG_QUEUES 4
+#endif
+
+#ifdef CONFIG_TT_BH_ARC_MSG_QUEUE_SIZE
+#define MSG_QUEUE_SIZE CONFIG_TT_BH_ARC_MSG_QUEUE_SIZE
+#else
+#define MSG_QUEUE_SIZE 4
+#endif
+
+#ifdef CONFIG_TT_BH_ARC_MSG_QUEUE_BATCH_SIZE
+#define MSG_QUEUE_BATCH_SIZE CONFIG_TT_BH_ARC_MSG_QUEUE_BATCH_SIZE
+#else
+#define MSG_QUEUE_BATCH_SIZE 1
+#endif
+
 #define MSG_QUEUE_POINTER_WRAP (2 * MSG_QUEUE_SIZE)
 #define REQUEST_MSG_LEN        8
 #define RESPONSE_MSG_LEN       8
@@ -303,6 +319,37 @@ struct i2c_message_rqst {
 	uint8_t write_data[24];
 };
 
+/** @brief Host request to start or stop pushing telemetry to host memory
+ * @details Messages of this type are processed by @ref telemetry_stream_handler
+ */
+struct telemetry_stream_rqst {
+	/** @brief The command code corresponding to @ref TT_SMC_MSG_TELEMETRY_STREAM */
+	uint8_t command_code;
+
+	/** @brief One byte of padding */
+	uint8_t pad;
+
+	/** @brief Interval between transfers in ms, or 0 to stop streaming. Transfers happen on
+	 * telemetry updates, so the interval is effectively rounded up to the update interval.
+	 */
+	uint16_t period_ms;
+
+	/** @brief Size of the host buffer in bytes */
+	uint32_t buffer_size;
+
+	/** @brief Low 32 bits of the host buffer bus address */
+	uint32_t host_addr_lo;
+
+	/** @brief High 32 bits of the host buffer bus address */
+	uint32_t host_addr_hi;
+
+	/** @brief Low 32 bits of the MSI address written after each transfer */
+	uint32_t msi_addr_lo;
+
+	/** @brief High 32 bits of the MSI address written after each transfer */
+	uint32_t msi_addr_hi;
+};
+
 /** @brief A tenstorrent host request*/
 union request {
 	/** @brief The interpretation of the request as an array of uint32_t entries*/
@@ -351,19 +398,91 @@ union request {
 
 	/** @brief An I2C message request */
 	struct i2c_message_rqst i2c_message;
+
+	/** @brief A telemetry stream request */
+	struct telemetry_stream_rqst telemetry_stream;
 };
 
 /** @} */
 
+/** @brief Number of log2 buckets in each @ref msgqueue_stats_entry latency histogram */
+#define MSG_STATS_HIST_BUCKETS   16
+/** @brief log2 of the upper bound (in refclk cycles) of the first histogram bucket */
+#define MSG_STATS_HIST_MIN_LOG2  4
+#define MSG_STATS_VERSION        1
+
+/**
+ * @brief Per message code handler statistics
+ *
+ * Durations are measured in refclk cycles (20 ns). Histogram bucket 0 counts handlers that
+ * finished in fewer than 2^(@ref MSG_STATS_HIST_MIN_LOG2 + 1) cycles, bucket i counts durations
+ * in [2^(i + @ref MSG_STATS_HIST_MIN_LOG2), 2^(i + @ref MSG_STATS_HIST_MIN_LOG2 + 1)) and the
+ * last bucket counts everything longer. A request deferred by an asynchronous handler is counted
+ * when it completes, and its duration runs until @ref msgqueue_complete.
+ */
+struct msgqueue_stats_entry {
+	/** @brief Message code */
+	uint32_t msg_code;
+	/** @brief Number of times the message was handled, 0 if the entry is unused */
+	uint32_t count;
+	/** @brief Number of times the handler returned a non-zero exit code */
+	uint32_t errors;
+	/** @brief Longest handler duration in refclk cycles */
+	uint32_t max_cycles;
+	/** @brief log2 bucketed handler durations */
+	uint32_t hist[MSG_STATS_HIST_BUCKETS];
+};
+
+/**
+ * @brief Message handler statistics table header
+ *
+ * The address of this table is published in the third word of the message queue info block
+ * pointed to by STATUS_MSG_Q_INFO_REG_ADDR, or 0 if statistics are disabled. The header is
+ * followed by @ref num_entries @ref msgqueue_stats_entry "entries", which are assigned in order
+ * as new message codes are handled. It is cleared by @ref TT_SMC_MSG_RESET_MSG_STATS.
+ */
+struct msgqueue_stats {
+	/** @brief Layout version, @ref MSG_STATS_VERSION */
+	uint32_t version;
+	/** @brief Number of entries that follow */
+	uint32_t num_entries;
+	/** @brief Number of histogram buckets per entry */
+	uint16_t hist_buckets;
+	/** @brief log2 of the upper bound of the first histogram bucket */
+	uint16_t hist_min_log2;
+	/** @brief Number of handled messages that did not fit in the table */
+	uint32_t dropped;
+};
+
 struct response {
 	uint32_t data[RESPONSE_MSG_LEN];
 };
 
 typedef uint8_t (*msgqueue_request_handler_t)(const union request *req, struct response *rsp);
 
+/**
+ * @brief Handle identifying the reserved response slot of a pending asynchronous request
+ *
+ * Passed to @ref msgqueue_async_request_handler_t and later to @ref msgqueue_complete.
+ */
+typedef uint32_t msgqueue_token_t;
+
+/**
+ * @brief Asynchronous message handler
+ *
+ * An asynchronous handler may finish the request immediately by filling in @p rsp and returning
+ * the exit code (0 - 255), exactly like a @ref msgqueue_request_handler_t. To defer the work, it
+ * returns -EINPROGRESS instead and later calls @ref msgqueue_complete with @p token from any
+ * context. The response slot stays reserved in the meantime, and the message queues keep
+ * processing other requests. Responses are still published to the host in request order.
+ */
+typedef int (*msgqueue_async_request_handler_t)(const union request *req, struct response *rsp,
+						msgqueue_token_t token);
+
 struct msgqueue_handler {
 	uint32_t msg_type;
 	msgqueue_request_handler_t handler;
+	msgqueue_async_request_handler_t async_handler;
 };
 
 #define REGISTER_MESSAGE(msg, func)                                                                \
@@ -372,8 +491,65 @@ struct msgqueue_handler {
 		.handler = func,                                                                   \
 	}
 
+#define REGISTER_ASYNC_MESSAGE(msg, func)                                                          \
+	const STRUCT_SECTION_ITERABLE(msgqueue_handler, registration_for_##msg) = {                \
+		.msg_type = msg,                                                                   \
+		.async_handler = func,                                                             \
+	}
+
 void process_message_queues(void);
 void msgqueue_register_handler(uint32_t msg_code, msgqueue_request_handler_t handler);
+void msgqueue_register_async_handler(uint32_t msg_code, msgqueue_async_request_handler_t handler);
+
+/**
+ * @brief Complete a request deferred by a @ref msgqueue_async_request_handler_t
+ *
+ * May be called from any context, including ISRs.
+ *
+ * @param token Token passed to the asynchronous handler
+ * @param response Response to return to the host, or NULL for an empty response
+ * @param exit_code Exit code of the request, merged into the first response word
+ *
+ * @return 0 on success, -EINVAL if @p token does not refer to a pending request
+ */
+int msgqueue_complete(msgqueue_token_t token, const struct response *response, uint8_t exit_code);
+
+struct k_work;
+
+/**
+ * @brief Submit the deferred part of an asynchronous request to the message queue work queue
+ *
+ * Slow work (SPI flash writes, waiting on the DMFW) should run here rather than on the system
+ * workqueue, so that it does not hold up telemetry and DVFS.
+ *
+ * @param work Work item to submit
+ *
+ * @return Result of k_work_submit_to_queue()
+ */
+int msgqueue_submit_work(struct k_work *work);
+
+/**
+ * @brief Set the priority of a message queue
+ *
+ * Queues are drained in priority order, 0 being the highest priority. After every batch the
+ * highest priority queue with pending requests is picked again, so a latency-critical queue is
+ * never stuck behind requests in a bulk queue. By default, the priority of a queue is its index.
+ *
+ * @param msgqueue_id Message queue index
+ * @param priority Priority of the queue, lower values are serviced first
+ *
+ * @return 0 on success, -1 if @p msgqueue_id is out of range
+ */
+int msgqueue_set_priority(uint32_t msgqueue_id, uint8_t priority);
+
+/**
+ * @brief Get the number of times a message handler exceeded its deadline
+ *
+ * @param msg_code Message code of the handler
+ *
+ * @return Number of deadline overruns, saturating at UINT16_MAX
+ */
+uint16_t msgqueue_handler_overrun_count(uint32_t msg_code);
 
 int msgqueue_request_push(uint32_t msgqueue_id, const union request *request);
 int msgqueue_request_pop(uint32_t msgqueue_id, union request *request);
@@ -129,6 +129,10 @@ enum tt_smc_msg {
 	TT_SMC_MSG_FLASH_LOCK = 0xC3,
 	/** @brief Confirm SPI flash succeeded */
 	TT_SMC_MSG_CONFIRM_FLASHED_SPI = 0xC4,
+	/** @brief Reset the @ref msgqueue_stats "message handler statistics" */
+	TT_SMC_MSG_RESET_MSG_STATS = 0xC5,
+	/** @brief Start or stop pushing telemetry to host memory, see @ref telemetry_stream_rqst */
+	TT_SMC_MSG_TELEMETRY_STREAM = 0xC6,
 };
 
 /** @} */
@@ -18,4 +18,11 @@ int spi_transfer_by_parts(const struct device *dev, size_t spi_address, size_t i
 int spi_arc_dma_transfer_to_tile(const struct device *dev, size_t spi_address, size_t image_size,
 				 uint8_t *buf, size_t buf_size, uint8_t *tlb_dst);
 
+/* Same as spi_arc_dma_transfer_to_tile(), and also compute the tt_boot_fs_cksum() of the first
+ * cksum_size bytes of the image into *cksum while the image streams through buf.
+ */
+int spi_arc_dma_transfer_to_tile_cksum(const struct device *dev, size_t spi_address,
+				       size_t image_size, uint8_t *buf, size_t buf_size,
+				       uint8_t *tlb_dst, size_t cksum_size, uint32_t *cksum);
+
 #endif
@@ -7,9 +7,18 @@
 #ifndef TENSTORRENT_SYS_INIT_DEFINES_H_
 #define TENSTORRENT_SYS_INIT_DEFINES_H_
 
+#include <stdint.h>
+
 #include <zephyr/init.h>
+#include <zephyr/sys/iterable_sections.h>
+#include <zephyr/sys/util.h>
 
-/* SYS_INIT APPLICATION defines */
+/* SYS_INIT APPLICATION defines
+ *
+ * Each SYS_INIT_APP function is a boot stage. Its priority is the stage ID, which also decides
+ * which of several ready stages starts first, so running the stages one at a time keeps this
+ * order. A stage is ready once every stage in its _DEPS has finished.
+ */
 #define register_interrupt_handlers_PRIO      0
 #define arc_dma_init_PRIO                     1
 #define InitSpiFS_PRIO                        2
@@ -26,15 +35,75 @@
 #define pcie_init_PRIO                        13
 #define tensix_init_PRIO                      14
 #define InitMrisc_PRIO                        15
-#define eth_init_PRIO                         16
-#define InitSmbusTarget_PRIO                  17
-#define regulator_init_PRIO                   18
-#define avs_init_PRIO                         19
-#define InitNocTranslationFromHarvesting_PRIO 20
+#define InitSmbusTarget_PRIO                  16
+#define regulator_init_PRIO                   17
+#define avs_init_PRIO                         18
+#define InitNocTranslationFromHarvesting_PRIO 19
+#define eth_init_PRIO                         20
 #define gddr_training_PRIO                    21
 #define CATInit_PRIO                          22
 #define bh_arc_init_end_PRIO                  23
 
-#define SYS_INIT_APP(func) SYS_INIT(func, APPLICATION, func##_PRIO)
+#define BOOT_STAGE_COUNT 24
+
+#define BOOT_STAGE_DEP(func)   | BIT(func##_PRIO)
+#define BOOT_STAGE_DEPS(...)   (0 FOR_EACH(BOOT_STAGE_DEP, (), __VA_ARGS__))
+#define BOOT_STAGE_DEPS_ALL(n) BIT_MASK(n##_PRIO)
+
+/* Everything up to DeassertRiscvResets changes resets and PLLs under all other hardware, so it
+ * stays a chain. After that, stages only wait for the hardware they share:
+ * - The MRISC and ERISC loaders wipe L1 with zeros from, and stage firmware in, Tensix L1.
+ * - NOC translation moves the Tensix columns, so nothing may be using Tensix coordinates while it
+ *   is programmed. Rows 0 and 1 are not translated, so PCIe link-up continues alongside it.
+ * - ETH SERDES init runs on the lanes left over by PCIe, and the ETH loader stages firmware in
+ *   Tensix L1 through the translated NOC, while MRISC trains GDDR.
+ * - GDDR training is polled through the translated NOC.
+ * Stages that can run at the same time use separate NOC2AXI TLBs, see noc2axi.h.
+ */
+#define register_interrupt_handlers_DEPS      0
+#define arc_dma_init_DEPS                     0
+#define InitSpiFS_DEPS                        0
+#define bh_arc_init_start_DEPS                0
+#define CATEarlyInit_DEPS                     BOOT_STAGE_DEPS(bh_arc_init_start)
+#define CalculateHarvesting_DEPS              BOOT_STAGE_DEPS(bh_arc_init_start)
+#define DeassertTileResets_DEPS                                                                    \
+	BOOT_STAGE_DEPS(InitSpiFS, CATEarlyInit, CalculateHarvesting)
+#define PLLInit_DEPS                          BOOT_STAGE_DEPS(DeassertTileResets)
+#define PVTInit_DEPS                          BOOT_STAGE_DEPS(PLLInit)
+#define NocInit_DEPS                          BOOT_STAGE_DEPS(PLLInit)
+#define AssertSoftResets_DEPS                 BOOT_STAGE_DEPS(NocInit)
+#define DeassertRiscvResets_DEPS              BOOT_STAGE_DEPS(PVTInit, AssertSoftResets)
+#define InitAiclkPPM_DEPS                     BOOT_STAGE_DEPS(DeassertRiscvResets)
+#define pcie_init_DEPS                        BOOT_STAGE_DEPS(DeassertRiscvResets)
+#define tensix_init_DEPS                      BOOT_STAGE_DEPS(DeassertRiscvResets)
+#define InitMrisc_DEPS                        BOOT_STAGE_DEPS(tensix_init)
+#define InitSmbusTarget_DEPS                  BOOT_STAGE_DEPS(DeassertRiscvResets)
+#define regulator_init_DEPS                   BOOT_STAGE_DEPS(DeassertRiscvResets)
+#define avs_init_DEPS                         BOOT_STAGE_DEPS(regulator_init)
+#define InitNocTranslationFromHarvesting_DEPS BOOT_STAGE_DEPS(tensix_init, InitMrisc)
+#define eth_init_DEPS                                                                              \
+	BOOT_STAGE_DEPS(pcie_init, InitNocTranslationFromHarvesting)
+#define gddr_training_DEPS                                                                         \
+	BOOT_STAGE_DEPS(InitMrisc, InitNocTranslationFromHarvesting)
+#define CATInit_DEPS                          BOOT_STAGE_DEPS(avs_init)
+#define bh_arc_init_end_DEPS                  BOOT_STAGE_DEPS_ALL(bh_arc_init_end)
+
+struct boot_stage {
+	int (*init)(void);
+	const char *name;
+	uint8_t id;
+	uint32_t deps; /* Bitmask of stage IDs */
+};
+
+#define SYS_INIT_APP(func)                                                                         \
+	BUILD_ASSERT(func##_PRIO < BOOT_STAGE_COUNT, #func " has no boot stage ID");              \
+	BUILD_ASSERT((func##_DEPS & GENMASK(BOOT_STAGE_COUNT - 1, func##_PRIO)) == 0,             \
+		     #func " depends on a later boot stage");                                      \
+	const STRUCT_SECTION_ITERABLE(boot_stage, boot_stage_##func) = {                           \
+		.init = func,                                                                      \
+		.name = #func,                                                                     \
+		.id = func##_PRIO,                                                                 \
+		.deps = func##_DEPS,                                                               \
+	}
 
 #endif
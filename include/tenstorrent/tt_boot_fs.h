@@ -90,8 +90,14 @@ int tt_boot_fs_add_file(const tt_boot_fs *tt_boot_fs, tt_boot_fs_fd fd_data,
 			const uint8_t *image_data_src, bool isFailoverEntry,
 			bool isSecurityBinaryEntry);
 
+/* Image checksum, CRC-32 with CONFIG_TT_BOOT_FS_CHECKSUM_CRC32 and the word sum otherwise. When
+ * summing in chunks, only the last chunk may end in a partial word.
+ */
 uint32_t tt_boot_fs_cksum(uint32_t cksum, const uint8_t *data, size_t size);
 
+/* Descriptor checksum (fd_crc), always the word sum that the boot ROM checks */
+uint32_t tt_boot_fs_fd_cksum(const tt_boot_fs_fd *fd);
+
 int tt_boot_fs_get_file(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, uint8_t *buf,
 			size_t buf_size, size_t *file_size);
 
@@ -118,6 +124,10 @@ int tt_boot_fs_ls(const struct device *dev, tt_boot_fs_fd *fds, size_t nfds, siz
 /**
  * @brief Find a boot filesystem file descriptor by name on a given flash device.
  *
+ * The first lookup on @p flash_dev reads all file descriptors into a RAM index, and later lookups
+ * on the same device are served from it without accessing flash, until
+ * @ref tt_boot_fs_invalidate is called.
+ *
  * If @p fd is `NULL`, then a return value of 0 indicates that a file named @p name exists in the
  * boot filesystem residing on @p flash_dev.
  *
@@ -139,6 +149,16 @@ int tt_boot_fs_ls(const struct device *dev, tt_boot_fs_fd *fds, size_t nfds, siz
 int tt_boot_fs_find_fd_by_tag(const struct device *flash_dev, const uint8_t *tag,
 			      tt_boot_fs_fd *fd);
 
+/**
+ * @brief Drop the file descriptor index of a flash device.
+ *
+ * Must be called after writing to @p flash_dev, so that the next lookup reads the file
+ * descriptors again.
+ *
+ * @param flash_dev flash device that was written to, or `NULL` for any device
+ */
+void tt_boot_fs_invalidate(const struct device *flash_dev);
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,11 @@
 #ifndef ZEPHYR_INCLUDE_DRIVERS_PLL_H_
 #define ZEPHYR_INCLUDE_DRIVERS_PLL_H_
 
+#include <errno.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/clock_control.h>
+
 enum clock_control_tt_bh_clock {
 	CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
 	CLOCK_CONTROL_TT_BH_CLOCK_ARCCLK,
@@ -24,4 +29,48 @@ enum clock_control_tt_bh_clock_config {
 	CLOCK_CONTROL_TT_BH_CONFIG_BYPASS
 };
 
+/**
+ * @brief Callback for the end of an asynchronous rate change.
+ *
+ * @param dev Clock controller.
+ * @param status 0 once the clock runs at the requested rate, or -ECANCELED if a later
+ *	request replaced this one first.
+ * @param user_data User data passed with the request.
+ */
+typedef void (*clock_control_tt_bh_rate_cb_t)(const struct device *dev, int status,
+					      void *user_data);
+
+/**
+ * @brief Start changing the rate of a clock and return without waiting for it.
+ *
+ * The PLL glides toward the new rate from the system work queue, which yields between short
+ * bursts of glide steps. A request made before the previous one has finished retargets the glide
+ * in progress, and the previous callback gets -ECANCELED. Only AICLK is supported.
+ *
+ * @param dev Clock controller.
+ * @param sys Clock, see @ref clock_control_tt_bh_clock.
+ * @param rate Rate in MHz.
+ * @param cb Called from the system work queue when the glide finishes, or NULL.
+ * @param user_data Passed to @p cb.
+ *
+ * @retval 0 The glide has started or has been retargeted.
+ * @retval -ENOTSUP The clock cannot change rate asynchronously.
+ * @retval -EINVAL The rate cannot be reached with the current dividers.
+ * @retval -EBUSY A synchronous rate change is in progress.
+ */
+#ifdef CONFIG_CLOCK_CONTROL_TT_BH
+int clock_control_tt_bh_set_rate_async(const struct device *dev, clock_control_subsys_t sys,
+				       clock_control_subsys_rate_t rate,
+				       clock_control_tt_bh_rate_cb_t cb, void *user_data);
+#else
+static inline int clock_control_tt_bh_set_rate_async(const struct device *dev,
+						     clock_control_subsys_t sys,
+						     clock_control_subsys_rate_t rate,
+						     clock_control_tt_bh_rate_cb_t cb,
+						     void *user_data)
+{
+	return -ENOSYS;
+}
+#endif
+
 #endif /* ZEPHYR_INCLUDE_DRIVERS_PLL_H_ */
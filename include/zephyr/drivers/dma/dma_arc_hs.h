@@ -4,19 +4,79 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #include <zephyr/drivers/dma.h>
 
+/**
+ * @brief Per-channel ARC HS DMA counters
+ *
+ * busy_cycles counts hardware cycles from the start of each transfer until the driver noticed
+ * that it had finished. Channel occupancy is busy_cycles over elapsed cycles, and throughput is
+ * bytes over busy_cycles.
+ */
+struct dma_arc_hs_stats {
+	uint32_t transfers;   /**< Finished or stopped transfers */
+	uint64_t bytes;       /**< Bytes in finished or stopped transfers */
+	uint64_t busy_cycles; /**< Cycles with a transfer in progress */
+	bool active;          /**< A transfer is in progress now */
+};
+
+/**
+ * @brief Largest ARC HS DMA transfer, in bytes
+ *
+ * Each channel has its own ring of dma-descriptors / dma-channels descriptors, and each descriptor
+ * moves up to dma-max-block-size bytes. With 32 descriptors over 4 channels of 64 KiB blocks, a
+ * transfer is at most 512 KiB. Larger copies must be split by the caller.
+ */
+#define DMA_ARC_HS_MAX_TRANSFER_LEN(node_id)                                                       \
+	(DT_PROP(node_id, dma_max_block_size) *                                                    \
+	 (DT_PROP(node_id, dma_descriptors) / DT_PROP(node_id, dma_channels)))
+
 /**
  * @brief Blocking memory-to-memory transfer using ARC HS DMA
  *
+ * Completion is polled from the calling thread, so this is safe to call from a work item on the
+ * system workqueue.
+ *
  * @param dev     DMA device (from DEVICE_DT_GET)
  * @param channel DMA channel (0 to N-1)
  * @param src     Source address (4-byte aligned)
  * @param dst     Destination address (4-byte aligned)
  * @param len     Transfer length in bytes
  * @param timeout Timeout for the transfer
- * @return 0 on success, negative errno on error
+ * @return 0 on success, -E2BIG if @p len exceeds DMA_ARC_HS_MAX_TRANSFER_LEN(), -ETIMEDOUT if
+ *         @p timeout expired first, negative errno on error
  */
-
 int dma_arc_hs_transfer(const struct device *dev, uint32_t channel, const void *src, void *dst,
 			size_t len, k_timeout_t timeout);
+
+/**
+ * @brief Start a memory-to-memory transfer using ARC HS DMA
+ *
+ * Returns as soon as the transfer has been queued. @p callback is called once it has finished,
+ * either from the driver's completion work or from dma_get_status().
+ *
+ * @param dev       DMA device (from DEVICE_DT_GET)
+ * @param channel   DMA channel (0 to N-1)
+ * @param src       Source address (4-byte aligned)
+ * @param dst       Destination address (4-byte aligned)
+ * @param len       Transfer length in bytes, non-zero and at most DMA_ARC_HS_MAX_TRANSFER_LEN()
+ * @param callback  Called on completion, may be NULL
+ * @param user_data Passed to @p callback
+ * @return 0 on success, -E2BIG if @p len is too large, negative errno on error
+ */
+int dma_arc_hs_transfer_async(const struct device *dev, uint32_t channel, const void *src,
+			      void *dst, size_t len, dma_callback_t callback, void *user_data);
+
+/**
+ * @brief Read the counters of an ARC HS DMA channel
+ *
+ * @param dev     DMA device (from DEVICE_DT_GET)
+ * @param channel DMA channel (0 to N-1)
+ * @param stats   Filled in with the channel's counters
+ * @return 0 on success, -EINVAL for an invalid channel
+ */
+int dma_arc_hs_get_stats(const struct device *dev, uint32_t channel,
+			 struct dma_arc_hs_stats *stats);
@@ -13,8 +13,22 @@ enum tt_bh_dma_noc_channel_direction {
 struct tt_bh_dma_noc_coords {
 	uint8_t source_x, source_y;
 	uint8_t dest_x, dest_y;
+	/* BROADCAST only: the multicast rectangle, which wraps around the NOC edges when a start
+	 * coordinate is greater than its end coordinate. An all-zero rectangle selects every Tensix
+	 * row and column.
+	 */
+	uint8_t mcast_start_x, mcast_start_y;
+	uint8_t mcast_end_x, mcast_end_y;
+	/* BROADCAST only: quadrant of the rectangle to skip, see TT_BH_DMA_NOC_MCAST_EXCLUDE */
+	uint16_t mcast_exclude;
 };
 
+/* Exclusion quadrant of a multicast, anchored at (x, y). ctrl has the same encoding as the
+ * quad_exclude_ctrl field of a NOC2AXI TLB. 0 excludes nothing.
+ */
+#define TT_BH_DMA_NOC_MCAST_EXCLUDE(x, y, ctrl)                                                    \
+	((uint16_t)(((x) & 0x3F) | (((y) & 0x3F) << 6) | (((ctrl) & 0xF) << 12)))
+
 static inline struct tt_bh_dma_noc_coords
 tt_bh_dma_noc_coords_init(uint8_t source_x, uint8_t source_y, uint8_t dest_x, uint8_t dest_y)
 {
@@ -25,3 +39,22 @@ tt_bh_dma_noc_coords_init(uint8_t source_x, uint8_t source_y, uint8_t dest_x, ui
 		.dest_y = dest_y,
 	};
 }
+
+/* Coordinates of a BROADCAST from tile (source_x, source_y), which is also its dest tile */
+static inline struct tt_bh_dma_noc_coords
+tt_bh_dma_noc_coords_init_multicast(uint8_t source_x, uint8_t source_y, uint8_t start_x,
+				    uint8_t start_y, uint8_t end_x, uint8_t end_y,
+				    uint16_t exclude)
+{
+	return (struct tt_bh_dma_noc_coords){
+		.source_x = source_x,
+		.source_y = source_y,
+		.dest_x = source_x,
+		.dest_y = source_y,
+		.mcast_start_x = start_x,
+		.mcast_start_y = start_y,
+		.mcast_end_x = end_x,
+		.mcast_end_y = end_y,
+		.mcast_exclude = exclude,
+	};
+}
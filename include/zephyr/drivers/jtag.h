@@ -20,6 +20,12 @@ extern "C" {
 #ifdef CONFIG_JTAG_EMUL
 int jtag_emul_setup(const struct device *dev, uint32_t *buf, size_t buf_len);
 int jtag_emul_axi_read32(const struct device *dev, uint32_t addr, uint32_t *value);
+/* Number of TCK cycles seen since jtag_emul_setup() */
+size_t jtag_emul_tck_count(const struct device *dev);
+/* Number of TCK, TDI and TMS writes made by the bit-bang driver, for all devices */
+uint32_t jtag_emul_gpio_writes(void);
+/* Fail AXI writes to addr, until the next jtag_emul_setup() */
+void jtag_emul_fail_axi_write(const struct device *dev, uint32_t addr);
 #endif
 
 typedef int (*jtag_setup_api_t)(const struct device *dev);
@@ -37,6 +43,9 @@ typedef int (*jtag_axi_read32_api_t)(const struct device *dev, uint32_t addr, ui
 typedef int (*jtag_axi_write32_api_t)(const struct device *dev, uint32_t addr, uint32_t value);
 typedef int (*jtag_axi_block_write_api_t)(const struct device *dev, uint32_t addr,
 					  const uint32_t *value, uint32_t len);
+typedef int (*jtag_axi_block_write_multi_api_t)(const struct device *const *devs, size_t count,
+						uint32_t addr, const uint32_t *value, uint32_t len,
+						int *rets);
 
 struct jtag_api {
 	jtag_setup_api_t setup;
@@ -52,6 +61,7 @@ struct jtag_api {
 	jtag_axi_read32_api_t axi_read32;
 	jtag_axi_write32_api_t axi_write32;
 	jtag_axi_block_write_api_t axi_block_write;
+	jtag_axi_block_write_multi_api_t axi_block_write_multi;
 };
 
 static inline int jtag_tick(const struct device *dev, uint32_t count)
@@ -175,6 +185,41 @@ static inline int jtag_axi_block_write(const struct device *dev, uint32_t addr,
 	return api->axi_block_write(dev, addr, value, len);
 }
 
+/*
+ * Write the same block to count devices. A driver that can clock several devices at once writes
+ * them together, otherwise they are written in turn. Each device's result goes into rets[].
+ * Returns the first error, or 0.
+ */
+static inline int jtag_axi_block_write_multi(const struct device *const *devs, size_t count,
+					     uint32_t addr, const uint32_t *value, uint32_t len,
+					     int *rets)
+{
+	int ret = 0;
+
+	if (count == 0) {
+		return 0;
+	}
+
+	if (devs == NULL || rets == NULL) {
+		return -EINVAL;
+	}
+
+	const struct jtag_api *api = devs[0]->api;
+
+	if (api->axi_block_write_multi != NULL) {
+		return api->axi_block_write_multi(devs, count, addr, value, len, rets);
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		rets[i] = jtag_axi_block_write(devs[i], addr, value, len);
+		if (ret == 0) {
+			ret = rets[i];
+		}
+	}
+
+	return ret;
+}
+
 #ifdef __cplusplus
 }
 #endif
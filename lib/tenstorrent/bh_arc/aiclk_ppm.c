@@ -39,11 +39,12 @@ typedef enum {
 
 typedef struct {
 	bool enabled;
-	float value;
+	dvfs_num_t value; /* in MHz */
 } AiclkArb;
 
 typedef struct {
-	uint32_t curr_freq;   /* in MHz */
+	uint32_t curr_freq;   /* in MHz, the highest AICLK that may be in effect */
+	uint32_t glide_freq;  /* in MHz, the target of the last AICLK glide started */
 	uint32_t targ_freq;   /* in MHz */
 	uint32_t boot_freq;   /* in MHz */
 	uint32_t fmax;        /* in MHz */
@@ -63,14 +64,16 @@ static AiclkPPM aiclk_ppm = {
 
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
 
-void SetAiclkArbMax(AiclkArbMax arb_max, float freq)
+void SetAiclkArbMax(AiclkArbMax arb_max, dvfs_num_t freq)
 {
-	aiclk_ppm.arbiter_max[arb_max].value = CLAMP(freq, aiclk_ppm.fmin, aiclk_ppm.fmax);
+	aiclk_ppm.arbiter_max[arb_max].value = CLAMP(freq, DVFS_NUM_FROM_INT(aiclk_ppm.fmin),
+						     DVFS_NUM_FROM_INT(aiclk_ppm.fmax));
 }
 
-void SetAiclkArbMin(AiclkArbMin arb_min, float freq)
+void SetAiclkArbMin(AiclkArbMin arb_min, dvfs_num_t freq)
 {
-	aiclk_ppm.arbiter_min[arb_min].value = CLAMP(freq, aiclk_ppm.fmin, aiclk_ppm.fmax);
+	aiclk_ppm.arbiter_min[arb_min].value = CLAMP(freq, DVFS_NUM_FROM_INT(aiclk_ppm.fmin),
+						     DVFS_NUM_FROM_INT(aiclk_ppm.fmax));
 }
 
 void EnableArbMax(AiclkArbMax arb_max, bool enable)
@@ -89,7 +92,7 @@ void CalculateTargAiclk(void)
 	/* Start by calculating the highest arbiter_min */
 	/* Then limit to the lowest arbiter_max */
 	/* Finally make sure that the target frequency is at least Fmin */
-	uint32_t targ_freq = aiclk_ppm.fmin;
+	dvfs_num_t targ_freq = DVFS_NUM_FROM_INT(aiclk_ppm.fmin);
 
 	for (AiclkArbMin i = 0; i < kAiclkArbMinCount; i++) {
 		if (aiclk_ppm.arbiter_min[i].enabled) {
@@ -105,7 +108,7 @@ void CalculateTargAiclk(void)
 
 	/* Make sure target is not below Fmin */
 	/* (it will not be above Fmax, since we calculated the max limits last) */
-	aiclk_ppm.targ_freq = MAX(targ_freq, aiclk_ppm.fmin);
+	aiclk_ppm.targ_freq = MAX(DVFS_NUM_TO_INT(targ_freq), aiclk_ppm.fmin);
 
 	/* Apply random frequency if sweep is enabled */
 	if (aiclk_ppm.sweep_en == 1) {
@@ -119,27 +122,50 @@ void CalculateTargAiclk(void)
 	}
 }
 
+static void AiclkGlideDone(const struct device *dev, int status, void *user_data)
+{
+	uint32_t freq = POINTER_TO_UINT(user_data);
+
+	/* Only a finished glide to the latest target lowers the frequency that VDD must support */
+	if (status == 0 && freq == aiclk_ppm.glide_freq) {
+		aiclk_ppm.curr_freq = freq;
+	}
+}
+
+static int GlideAiclk(uint32_t freq)
+{
+	int rc = clock_control_tt_bh_set_rate_async(
+		pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
+		(clock_control_subsys_rate_t)freq, AiclkGlideDone, UINT_TO_POINTER(freq));
+
+	if (rc == 0) {
+		aiclk_ppm.glide_freq = freq;
+	}
+
+	return rc;
+}
+
+/* Start gliding down. curr_freq keeps the old frequency until the glide has finished, so that
+ * VDD is only lowered on a later DVFS pass.
+ */
 void DecreaseAiclk(void)
 {
-	if (aiclk_ppm.targ_freq < aiclk_ppm.curr_freq) {
-		clock_control_set_rate(pll_dev_0,
-				       (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
-				       (clock_control_subsys_rate_t)aiclk_ppm.targ_freq);
-		aiclk_ppm.curr_freq = aiclk_ppm.targ_freq;
+	/* Nothing to do if the glide in progress is already headed there */
+	if (aiclk_ppm.targ_freq < aiclk_ppm.curr_freq &&
+	    aiclk_ppm.targ_freq != aiclk_ppm.glide_freq) {
+		GlideAiclk(aiclk_ppm.targ_freq);
 	}
 }
 
+/* Start gliding up. VDD has already been raised for targ_freq. */
 void IncreaseAiclk(void)
 {
-	if (aiclk_ppm.targ_freq > aiclk_ppm.curr_freq) {
-		clock_control_set_rate(pll_dev_0,
-				       (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
-				       (clock_control_subsys_rate_t)aiclk_ppm.targ_freq);
+	if (aiclk_ppm.targ_freq > aiclk_ppm.curr_freq && GlideAiclk(aiclk_ppm.targ_freq) == 0) {
 		aiclk_ppm.curr_freq = aiclk_ppm.targ_freq;
 	}
 }
 
-float GetThrottlerArbMax(AiclkArbMax arb_max)
+dvfs_num_t GetThrottlerArbMax(AiclkArbMax arb_max)
 {
 	return aiclk_ppm.arbiter_max[arb_max].value;
 }
@@ -147,32 +173,16 @@ float GetThrottlerArbMax(AiclkArbMax arb_max)
 /* TODO: Write a Zephyr unit test for this function */
 uint32_t GetMaxAiclkForVoltage(uint32_t voltage)
 {
-	/* Assume monotonically increasing relationship between frequency and voltage */
-	/* and conduct binary search. */
 	/* Note this function doesn't work if you would need lower than fmin to achieve the voltage
 	 */
-
-	/* starting high_freq at fmax + 1 solves the case where the Max AICLK is fmax */
-	uint32_t high_freq = aiclk_ppm.fmax + 1;
-	uint32_t low_freq = aiclk_ppm.fmin;
-
-	while (low_freq < high_freq) {
-		uint32_t mid_freq = (low_freq + high_freq) / 2;
-
-		if (VFCurve(mid_freq) > voltage) {
-			high_freq = mid_freq;
-		} else {
-			low_freq = mid_freq + 1;
-		}
-	}
-
-	return low_freq - 1;
+	return VFCurveMaxFreq(voltage);
 }
 
 void InitArbMaxVoltage(void)
 {
 	/* ArbMaxVoltage is statically set to the frequency of the maximum voltage */
-	SetAiclkArbMax(kAiclkArbMaxVoltage, GetMaxAiclkForVoltage(voltage_arbiter.vdd_max));
+	SetAiclkArbMax(kAiclkArbMaxVoltage,
+		       DVFS_NUM_FROM_INT(GetMaxAiclkForVoltage(voltage_arbiter.vdd_max)));
 }
 
 static int InitAiclkPPM(void)
@@ -186,6 +196,7 @@ static int InitAiclkPPM(void)
 	clock_control_get_rate(pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
 			       &aiclk_ppm.boot_freq);
 	aiclk_ppm.curr_freq = aiclk_ppm.boot_freq;
+	aiclk_ppm.glide_freq = aiclk_ppm.curr_freq;
 	aiclk_ppm.targ_freq = aiclk_ppm.curr_freq;
 
 	aiclk_ppm.fmax = CLAMP(tt_bh_fwtable_get_fw_table(fwtable_dev)->chip_limits.asic_fmax,
@@ -200,12 +211,12 @@ static int InitAiclkPPM(void)
 	aiclk_ppm.sweep_en = 0;
 
 	for (int i = 0; i < kAiclkArbMaxCount; i++) {
-		aiclk_ppm.arbiter_max[i].value = aiclk_ppm.fmax;
+		aiclk_ppm.arbiter_max[i].value = DVFS_NUM_FROM_INT(aiclk_ppm.fmax);
 		aiclk_ppm.arbiter_max[i].enabled = true;
 	}
 
 	for (int i = 0; i < kAiclkArbMinCount; i++) {
-		aiclk_ppm.arbiter_min[i].value = aiclk_ppm.fmin;
+		aiclk_ppm.arbiter_min[i].value = DVFS_NUM_FROM_INT(aiclk_ppm.fmin);
 		aiclk_ppm.arbiter_min[i].enabled = true;
 	}
 
@@ -240,6 +251,11 @@ uint32_t GetAiclkTarg(void)
 	return aiclk_ppm.targ_freq;
 }
 
+uint32_t GetAiclkCurr(void)
+{
+	return aiclk_ppm.curr_freq;
+}
+
 uint32_t GetAiclkFmin(void)
 {
 	return aiclk_ppm.fmin;
@@ -253,9 +269,9 @@ uint32_t GetAiclkFmax(void)
 void aiclk_set_busy(bool is_busy)
 {
 	if (is_busy) {
-		SetAiclkArbMin(kAiclkArbMinBusy, aiclk_ppm.fmax);
+		SetAiclkArbMin(kAiclkArbMinBusy, DVFS_NUM_FROM_INT(aiclk_ppm.fmax));
 	} else {
-		SetAiclkArbMin(kAiclkArbMinBusy, aiclk_ppm.fmin);
+		SetAiclkArbMin(kAiclkArbMinBusy, DVFS_NUM_FROM_INT(aiclk_ppm.fmin));
 	}
 }
 
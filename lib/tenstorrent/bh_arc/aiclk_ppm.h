@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "dvfs.h"
+
 typedef enum {
 	kAiclkArbMaxFmax,
 	kAiclkArbMaxTDP,
@@ -30,17 +32,18 @@ typedef enum {
 } AiclkArbMin;
 
 void aiclk_set_busy(bool is_busy);
-void SetAiclkArbMax(AiclkArbMax arb_max, float freq);
-void SetAiclkArbMin(AiclkArbMin arb_min, float freq);
+void SetAiclkArbMax(AiclkArbMax arb_max, dvfs_num_t freq);
+void SetAiclkArbMin(AiclkArbMin arb_min, dvfs_num_t freq);
 void EnableArbMax(AiclkArbMax arb_max, bool enable);
 void EnableArbMin(AiclkArbMin arb_min, bool enable);
 void CalculateTargAiclk(void);
 void DecreaseAiclk(void);
 void IncreaseAiclk(void);
 void InitArbMaxVoltage(void);
-float GetThrottlerArbMax(AiclkArbMax arb_max);
+dvfs_num_t GetThrottlerArbMax(AiclkArbMax arb_max);
 uint8_t ForceAiclk(uint32_t freq);
 uint32_t GetAiclkTarg(void);
+uint32_t GetAiclkCurr(void);
 uint32_t GetMaxAiclkForVoltage(uint32_t voltage);
 uint32_t GetAiclkFmin(void);
 uint32_t GetAiclkFmax(void);
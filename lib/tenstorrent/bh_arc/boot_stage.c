@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "boot_stage.h"
+#include "reg.h"
+#include "status_reg.h"
+#include "timer.h"
+
+#include <tenstorrent/sys_init_defines.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/iterable_sections.h>
+
+LOG_MODULE_REGISTER(boot_stage, CONFIG_TT_APP_LOG_LEVEL);
+
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+/* All boot stages run at one cooperative priority, so a thread only switches to another stage
+ * when its own stage blocks.
+ */
+#define BOOT_STAGE_THREAD_PRIO K_PRIO_COOP(CONFIG_NUM_COOP_PRIORITIES - 1)
+#define NUM_EXTRA_THREADS      (CONFIG_TT_BH_ARC_BOOT_STAGE_THREADS - 1)
+
+static struct boot_stage_time boot_stage_times[BOOT_STAGE_COUNT];
+
+static const struct boot_stage *boot_stages[BOOT_STAGE_COUNT];
+static uint32_t stages_pending; /* Registered stages that have not started */
+static uint32_t stages_done;    /* Finished stages, and IDs without a stage */
+static uint32_t stages_failed;  /* Finished stages that returned an error */
+
+static K_MUTEX_DEFINE(boot_stage_mutex);
+static K_CONDVAR_DEFINE(boot_stage_condvar);
+
+#if NUM_EXTRA_THREADS > 0
+static K_THREAD_STACK_ARRAY_DEFINE(boot_stage_stacks, NUM_EXTRA_THREADS,
+				   CONFIG_TT_BH_ARC_BOOT_STAGE_STACK_SIZE);
+static struct k_thread boot_stage_threads[NUM_EXTRA_THREADS];
+#endif
+
+/* Lowest pending stage whose dependencies have all finished, or NULL */
+static const struct boot_stage *NextReadyStage(void)
+{
+	for (uint32_t id = 0; id < BOOT_STAGE_COUNT; id++) {
+		if (IS_BIT_SET(stages_pending, id) && (boot_stages[id]->deps & ~stages_done) == 0) {
+			return boot_stages[id];
+		}
+	}
+
+	return NULL;
+}
+
+static void RunBootStageThread(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	k_mutex_lock(&boot_stage_mutex, K_FOREVER);
+
+	while (stages_pending != 0) {
+		const struct boot_stage *stage = NextReadyStage();
+
+		if (stage == NULL) {
+			k_condvar_wait(&boot_stage_condvar, &boot_stage_mutex, K_FOREVER);
+			continue;
+		}
+
+		stages_pending &= ~BIT(stage->id);
+		k_mutex_unlock(&boot_stage_mutex);
+
+		boot_stage_times[stage->id].start = TimerTimestamp();
+		int rc = stage->init();
+
+		boot_stage_times[stage->id].end = TimerTimestamp();
+
+		if (rc != 0) {
+			LOG_ERR("%s() failed: %d", stage->name, rc);
+		}
+
+		k_mutex_lock(&boot_stage_mutex, K_FOREVER);
+		if (rc != 0) {
+			stages_failed |= BIT(stage->id);
+			WriteReg(BOOT_STAGE_FAILED_REG_ADDR, stages_failed);
+		}
+		stages_done |= BIT(stage->id);
+		k_condvar_broadcast(&boot_stage_condvar);
+	}
+
+	k_mutex_unlock(&boot_stage_mutex);
+}
+
+/* Run boot stages on CONFIG_TT_BH_ARC_BOOT_STAGE_THREADS threads, including the caller, and
+ * return once all of them have finished.
+ */
+STATIC void RunBootStages(const struct boot_stage *stages, size_t num_stages)
+{
+	k_tid_t self = k_current_get();
+	int prio = k_thread_priority_get(self);
+
+	memset(boot_stages, 0, sizeof(boot_stages));
+	memset(boot_stage_times, 0, sizeof(boot_stage_times));
+	stages_pending = 0;
+	stages_failed = 0;
+
+	for (size_t i = 0; i < num_stages; i++) {
+		uint8_t id = stages[i].id;
+
+		__ASSERT(boot_stages[id] == NULL, "duplicate boot stage %u", id);
+		boot_stages[id] = &stages[i];
+		stages_pending |= BIT(id);
+	}
+	stages_done = ~stages_pending;
+
+	/* The workers cannot start before the caller blocks, as all of them are cooperative */
+	k_thread_priority_set(self, BOOT_STAGE_THREAD_PRIO);
+
+#if NUM_EXTRA_THREADS > 0
+	for (int i = 0; i < NUM_EXTRA_THREADS; i++) {
+		k_thread_create(&boot_stage_threads[i], boot_stage_stacks[i],
+				K_THREAD_STACK_SIZEOF(boot_stage_stacks[i]), RunBootStageThread,
+				NULL, NULL, NULL, BOOT_STAGE_THREAD_PRIO, 0, K_NO_WAIT);
+		k_thread_name_set(&boot_stage_threads[i], "boot_stage");
+	}
+#endif
+
+	RunBootStageThread(NULL, NULL, NULL);
+
+#if NUM_EXTRA_THREADS > 0
+	for (int i = 0; i < NUM_EXTRA_THREADS; i++) {
+		k_thread_join(&boot_stage_threads[i], K_FOREVER);
+	}
+#endif
+
+	k_thread_priority_set(self, prio);
+}
+
+const struct boot_stage_time *GetBootStageTimes(void)
+{
+	return boot_stage_times;
+}
+
+uint32_t GetFailedBootStages(void)
+{
+	return stages_failed;
+}
+
+static int boot_stage_init(void)
+{
+	size_t num_stages;
+	struct boot_stage *stages;
+
+	WriteReg(BOOT_STAGE_TIMES_REG_ADDR, POINTER_TO_UINT(boot_stage_times));
+	WriteReg(BOOT_STAGE_FAILED_REG_ADDR, 0);
+
+	STRUCT_SECTION_COUNT(boot_stage, &num_stages);
+	STRUCT_SECTION_GET(boot_stage, 0, &stages);
+	RunBootStages(stages, num_stages);
+
+	return 0;
+}
+SYS_INIT(boot_stage_init, APPLICATION, 0);
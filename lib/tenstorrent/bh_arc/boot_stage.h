@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BOOT_STAGE_H
+#define BOOT_STAGE_H
+
+#include <stdint.h>
+
+/* Refclk timestamps of a boot stage. Both are 0 if the stage did not run. The table of all
+ * BOOT_STAGE_COUNT stages, indexed by stage ID, is at the address in BOOT_STAGE_TIMES_REG_ADDR.
+ */
+struct boot_stage_time {
+	uint32_t start;
+	uint32_t end;
+};
+
+const struct boot_stage_time *GetBootStageTimes(void);
+/* Bitmask of the IDs of boot stages that returned an error, also in BOOT_STAGE_FAILED_REG_ADDR */
+uint32_t GetFailedBootStages(void);
+
+#endif
@@ -42,7 +42,14 @@ typedef struct {
 } Cm2DmMsgState;
 
 static Cm2DmMsgState cm2dm_msg_state;
-K_SEM_DEFINE(dmfw_ping_sem, 0, 1);
+/* Pending TT_SMC_MSG_PING_DM requests, all completed by the DMFW response or a timeout */
+static struct {
+	struct k_spinlock lock;
+	/* Every response slot of every queue can hold a pending ping */
+	msgqueue_token_t tokens[NUM_MSG_QUEUES * MSG_QUEUE_SIZE];
+	uint32_t count;
+	int64_t start;
+} dmfw_ping;
 static uint16_t power;
 static uint16_t telemetry_reg;
 static struct {
@@ -209,26 +216,68 @@ REGISTER_MESSAGE(TT_SMC_MSG_TRIGGER_RESET, reset_dm_handler);
  * @param[out] response The response to the host. Set to 1 if DMC is alive, 0 otherwise.
  * @return 0
  */
-static uint8_t ping_dm_handler(const union request *request, struct response *response)
+static void ping_dm_complete(bool alive)
 {
-	int ret;
-	uint64_t timestamp;
+	struct response response = {0};
+	msgqueue_token_t tokens[ARRAY_SIZE(dmfw_ping.tokens)];
+	k_spinlock_key_t key = k_spin_lock(&dmfw_ping.lock);
+	uint32_t count = dmfw_ping.count;
+
+	if (count == 0) {
+		k_spin_unlock(&dmfw_ping.lock, key);
+		return;
+	}
 
-	/* Send a ping to the dmfw */
-	k_sem_reset(&dmfw_ping_sem);
-	PostCm2DmMsg(kCm2DmMsgIdPing, request->dmc_ping.legacy_ping);
-	/* Delay to allow DMFW to respond */
-	timestamp = k_uptime_get();
-	ret = k_sem_take(&dmfw_ping_sem, K_MSEC(CONFIG_TT_BH_ARC_DMFW_PING_TIMEOUT));
-	/* Record the time it took for DMFW to respond in us */
-	WriteReg(PING_DMFW_DURATION_REG_ADDR, k_uptime_delta(&timestamp));
+	memcpy(tokens, dmfw_ping.tokens, count * sizeof(tokens[0]));
+	dmfw_ping.count = 0;
+
+	/* Record the time it took for DMFW to respond */
+	WriteReg(PING_DMFW_DURATION_REG_ADDR, k_uptime_delta(&dmfw_ping.start));
+	k_spin_unlock(&dmfw_ping.lock, key);
 
 	/* Send 1 if DMFW is alive, 0 otherwise */
-	response->data[1] = (ret == 0);
-	return 0;
+	response.data[1] = alive;
+	for (uint32_t i = 0; i < count; i++) {
+		msgqueue_complete(tokens[i], &response, 0);
+	}
+}
+
+static void ping_dm_timeout_handler(struct k_work *work)
+{
+	ping_dm_complete(false);
+}
+
+static K_WORK_DELAYABLE_DEFINE(ping_dm_timeout_work, ping_dm_timeout_handler);
+
+static int ping_dm_handler(const union request *request, struct response *response,
+			   msgqueue_token_t token)
+{
+	k_spinlock_key_t key = k_spin_lock(&dmfw_ping.lock);
+	bool first = dmfw_ping.count == 0;
+
+	if (dmfw_ping.count == ARRAY_SIZE(dmfw_ping.tokens)) {
+		k_spin_unlock(&dmfw_ping.lock, key);
+		return EBUSY;
+	}
+
+	/* A ping that is already in flight answers this request too */
+	dmfw_ping.tokens[dmfw_ping.count++] = token;
+	if (first) {
+		dmfw_ping.start = k_uptime_get();
+	}
+	k_spin_unlock(&dmfw_ping.lock, key);
+
+	if (first) {
+		/* Send a ping to the dmfw and give it time to respond */
+		PostCm2DmMsg(kCm2DmMsgIdPing, request->dmc_ping.legacy_ping);
+		k_work_reschedule(&ping_dm_timeout_work,
+				  K_MSEC(CONFIG_TT_BH_ARC_DMFW_PING_TIMEOUT));
+	}
+
+	return -EINPROGRESS;
 }
 
-REGISTER_MESSAGE(TT_SMC_MSG_PING_DM, ping_dm_handler);
+REGISTER_ASYNC_MESSAGE(TT_SMC_MSG_PING_DM, ping_dm_handler);
 
 static uint8_t set_watchdog_timeout(const union request *request, struct response *response)
 {
@@ -296,7 +345,8 @@ int32_t Dm2CmPingHandler(const uint8_t *data, uint8_t size)
 	if (response != 0xA5A5) {
 		return -1;
 	}
-	k_sem_give(&dmfw_ping_sem);
+	k_work_cancel_delayable(&ping_dm_timeout_work);
+	ping_dm_complete(true);
 	return 0;
 }
 
@@ -306,7 +356,8 @@ int32_t Dm2CmPingV2(uint8_t *data, uint8_t *size)
 
 	data[0] = 0xA5;
 	data[1] = 0xA5;
-	k_sem_give(&dmfw_ping_sem);
+	k_work_cancel_delayable(&ping_dm_timeout_work);
+	ping_dm_complete(true);
 	return 0;
 }
 
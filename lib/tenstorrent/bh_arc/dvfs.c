@@ -9,6 +9,7 @@
 #include "throttler.h"
 #include "aiclk_ppm.h"
 #include "voltage.h"
+#include "telemetry_history.h"
 
 bool dvfs_enabled;
 
@@ -17,8 +18,9 @@ void DVFSChange(void)
 	CalculateThrottlers();
 	CalculateTargAiclk();
 
-	uint32_t targ_freq = GetAiclkTarg();
-	uint32_t aiclk_voltage = VFCurve(targ_freq);
+	/* A decrease that is still gliding needs the voltage of the frequency it started from */
+	uint32_t vdd_freq = MAX(GetAiclkTarg(), GetAiclkCurr());
+	uint32_t aiclk_voltage = DVFS_NUM_TO_INT(VFCurve(vdd_freq));
 
 	VoltageArbRequest(VoltageReqAiclk, aiclk_voltage);
 
@@ -27,6 +29,8 @@ void DVFSChange(void)
 	DecreaseAiclk();
 	VoltageChange();
 	IncreaseAiclk();
+
+	UpdateTelemetryHistory();
 }
 
 static void dvfs_work_handler(struct k_work *work)
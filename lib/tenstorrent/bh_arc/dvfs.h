@@ -8,6 +8,37 @@
 
 #include <stdbool.h>
 
+#include "fixed_point.h"
+
+/* Number format of the DVFS control loop: throttlers, AICLK arbiters and the V/F curve */
+#ifdef CONFIG_TT_BH_ARC_DVFS_FIXED_POINT
+typedef q16_16_t dvfs_num_t;
+#define DVFS_NUM(x)            Q16_16(x)
+#define DVFS_NUM_FROM_INT(x)   q16_16_from_int(x)
+#define DVFS_NUM_TO_INT(x)     q16_16_to_int(x)
+#define DVFS_NUM_FROM_FLOAT(x) q16_16_from_float(x)
+#define DVFS_NUM_TO_FLOAT(x)   q16_16_to_float(x)
+#define DVFS_MUL(a, b)         q16_16_mul(a, b)
+#define DVFS_MUL_ROUND(a, b)   q16_16_mul_round(a, b)
+#define DVFS_DIV(a, b)         q16_16_div(a, b)
+typedef q16_16_recip_t dvfs_recip_t;
+#define DVFS_RECIP(x)          q16_16_recip(x)
+#define DVFS_MUL_RECIP(a, r)   q16_16_mul_recip(a, r)
+#else
+typedef float dvfs_num_t;
+#define DVFS_NUM(x)            ((float)(x))
+#define DVFS_NUM_FROM_INT(x)   ((float)(x))
+#define DVFS_NUM_TO_INT(x)     ((int32_t)(x))
+#define DVFS_NUM_FROM_FLOAT(x) (x)
+#define DVFS_NUM_TO_FLOAT(x)   (x)
+#define DVFS_MUL(a, b)         ((a) * (b))
+#define DVFS_MUL_ROUND(a, b)   ((a) * (b))
+#define DVFS_DIV(a, b)         ((a) / (b))
+typedef float dvfs_recip_t;
+#define DVFS_RECIP(x)          (1.0f / (x))
+#define DVFS_MUL_RECIP(a, r)   ((a) * (r))
+#endif
+
 extern bool dvfs_enabled;
 
 void InitDVFS(void);
@@ -6,9 +6,11 @@
 
 #include "functional_efuse.h"
 #include "eth.h"
+#include "fw_fanout.h"
 #include "harvesting.h"
 #include "init.h"
 #include "noc.h"
+#include "noc_dma.h"
 #include "noc_init.h"
 #include "noc2axi.h"
 #include "reg.h"
@@ -23,14 +25,17 @@
 #include <zephyr/init.h>
 #include <zephyr/drivers/misc/bh_fwtable.h>
 #include <zephyr/drivers/dma.h>
-#include <zephyr/drivers/dma/dma_tt_bh_noc.h>
 #include <zephyr/drivers/dma/dma_arc_hs.h>
 
 LOG_MODULE_REGISTER(eth, CONFIG_TT_APP_LOG_LEVEL);
 
-#define ETH_SETUP_TLB  0
+#define ETH_SETUP_TLB  6
 #define ETH_PARAM_ADDR 0x7c000
 
+/* The shifting is to align the address to the lowest 16 bytes */
+/* #define ETH_FW_LOAD_ADDR (((ETH_PARAM_ADDR - fw_size) >> 2) << 2) */
+#define ETH_FW_LOAD_ADDR 0x00070000
+
 #define ERISC_L1_SIZE (512 * 1024)
 
 #define ETH_RESET_PC_0              0xFFB14000
@@ -49,7 +54,6 @@ LOG_MODULE_REGISTER(eth, CONFIG_TT_APP_LOG_LEVEL);
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
 static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
 static const struct device *const arc_dma_dev = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(dma0));
-static const struct device *dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 
 typedef struct {
 	uint32_t sd_mode_sel_0: 1;
@@ -204,26 +208,11 @@ void ReleaseEthReset(uint32_t eth_inst, uint32_t ring)
 	*soft_reset_0 &= ~(1 << 11); /* Clear bit for RISC0 reset, leave RISC1 in reset still */
 }
 
-int LoadEthFw(uint32_t eth_inst, uint32_t ring, uint8_t *buf, size_t buf_size, size_t spi_address,
-	      size_t image_size)
+static void SetEthFwPc(uint32_t eth_inst, uint32_t ring)
 {
-	/* The shifting is to align the address to the lowest 16 bytes */
-	/* uint32_t fw_load_addr = ((ETH_PARAM_ADDR - fw_size) >> 2) << 2; */
-	uint32_t fw_load_addr = 0x00070000;
-
-	SetupEthTlb(eth_inst, ring, fw_load_addr);
-	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, ETH_SETUP_TLB, fw_load_addr);
-
-	if (spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
-					 (uint8_t *)eth_tlb)) {
-		return -1;
-	}
-
 	SetupEthTlb(eth_inst, ring, ETH_RESET_PC_0);
-	NOC2AXIWrite32(ring, ETH_SETUP_TLB, ETH_RESET_PC_0, fw_load_addr);
+	NOC2AXIWrite32(ring, ETH_SETUP_TLB, ETH_RESET_PC_0, ETH_FW_LOAD_ADDR);
 	NOC2AXIWrite32(ring, ETH_SETUP_TLB, ETH_END_PC_0, ETH_PARAM_ADDR - 0x4);
-
-	return 0;
 }
 
 /**
@@ -285,8 +274,8 @@ int LoadEthFwCfg(uint32_t eth_inst, uint32_t ring, uint8_t *buf, uint32_t eth_en
 	SetupEthTlb(eth_inst, ring, ETH_PARAM_ADDR);
 	volatile uint32_t *eth_tlb = GetTlbWindowAddr(ring, ETH_SETUP_TLB, ETH_PARAM_ADDR);
 
-	if (dma_arc_hs_transfer(arc_dma_dev, 0, buf, (void *)eth_tlb, image_size, K_MSEC(500)) <
-	    0) {
+	if (dma_arc_hs_transfer(arc_dma_dev, ARC_DMA_CHANNEL_ETH, buf, (void *)eth_tlb, image_size,
+				K_MSEC(500)) < 0) {
 		LOG_ERR("DMA transfer failed");
 		return -1;
 	}
@@ -360,43 +349,22 @@ static void wipe_l1(void)
 {
 	uint8_t noc_id = 0;
 	uint64_t addr = 0;
+	struct noc_dma_dest dests[MAX_ETH_INSTANCES];
+	size_t num_dests = 0;
 	uint8_t tensix_x, tensix_y;
 
 	GetEnabledTensix(&tensix_x, &tensix_y);
 
-	struct tt_bh_dma_noc_coords coords =
-		tt_bh_dma_noc_coords_init(tensix_x, tensix_y, 0, 0);
-
-	struct dma_block_config block = {
-		.source_address = addr,
-		.dest_address = addr,
-		.block_size = ERISC_L1_SIZE,
-	};
-
-	struct dma_config config = {
-		.channel_direction = PERIPHERAL_TO_MEMORY,
-		.source_data_size = 1,
-		.dest_data_size = 1,
-		.source_burst_length = 1,
-		.dest_burst_length = 1,
-		.block_count = 1,
-		.head_block = &block,
-		.user_data = &coords,
-	};
-
 	for (uint8_t eth_inst = 0; eth_inst < MAX_ETH_INSTANCES; eth_inst++) {
 		if (tile_enable.eth_enabled & BIT(eth_inst)) {
-			uint8_t x, y;
-
-			GetEthNocCoords(eth_inst, noc_id, &x, &y);
+			struct noc_dma_dest *dest = &dests[num_dests++];
 
-			coords.dest_x = x;
-			coords.dest_y = y;
-
-			dma_config(dma_noc, 1, &config);
-			dma_start(dma_noc, 1);
+			GetEthNocCoords(eth_inst, noc_id, &dest->x, &dest->y);
+			dest->addr = addr;
 		}
 	}
+
+	NocDmaCopy(tensix_x, tensix_y, addr, dests, num_dests, ERISC_L1_SIZE);
 }
 
 static void EthInit(void)
@@ -421,13 +389,29 @@ static void EthInit(void)
 		LOG_ERR("%s(%s) failed: %d", "tt_boot_fs_find_fd_by_tag", ETH_FW_TAG, rc);
 		return;
 	}
-	image_size = tag_fd.flags.f.image_size;
-	spi_address = tag_fd.spi_addr;
 
-	/* Load fw */
+	/* Load fw: read it from SPI once and copy it to all ERISCs over the NOC */
+	struct noc_dma_dest dests[MAX_ETH_INSTANCES];
+	size_t num_dests = 0;
+
+	for (uint8_t eth_inst = 0; eth_inst < MAX_ETH_INSTANCES; eth_inst++) {
+		if (tile_enable.eth_enabled & BIT(eth_inst)) {
+			struct noc_dma_dest *dest = &dests[num_dests++];
+
+			GetEthNocCoords(eth_inst, 0, &dest->x, &dest->y);
+			dest->addr = ETH_FW_LOAD_ADDR;
+		}
+	}
+
+	rc = FwFanOut(&tag_fd, buf, SCRATCHPAD_SIZE, dests, num_dests);
+	if (rc < 0) {
+		LOG_ERR("%s(%s) failed: %d", "FwFanOut", ETH_FW_TAG, rc);
+		return;
+	}
+
 	for (uint8_t eth_inst = 0; eth_inst < MAX_ETH_INSTANCES; eth_inst++) {
 		if (tile_enable.eth_enabled & BIT(eth_inst)) {
-			LoadEthFw(eth_inst, ring, buf, SCRATCHPAD_SIZE, spi_address, image_size);
+			SetEthFwPc(eth_inst, ring);
 		}
 	}
 
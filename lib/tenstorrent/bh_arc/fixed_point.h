@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TENSTORRENT_BH_ARC_FIXED_POINT_H_
+#define TENSTORRENT_BH_ARC_FIXED_POINT_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Signed Q16.16 fixed point, the same format as the 16.16 telemetry values */
+typedef int32_t q16_16_t;
+
+#define Q16_16_FRAC_BITS 16
+#define Q16_16_ONE       (1 << Q16_16_FRAC_BITS)
+
+/* Convert a constant to Q16.16 at compile time, rounding to nearest */
+#define Q16_16(x) ((q16_16_t)((x) * (double)Q16_16_ONE + ((x) >= 0 ? 0.5 : -0.5)))
+
+static inline q16_16_t q16_16_from_int(int32_t val)
+{
+	return (q16_16_t)((uint32_t)val << Q16_16_FRAC_BITS);
+}
+
+/* Rounds towards negative infinity */
+static inline int32_t q16_16_to_int(q16_16_t val)
+{
+	return val >> Q16_16_FRAC_BITS;
+}
+
+static inline q16_16_t q16_16_from_float(float val)
+{
+	return (q16_16_t)(val * Q16_16_ONE);
+}
+
+static inline float q16_16_to_float(q16_16_t val)
+{
+	return (float)val / Q16_16_ONE;
+}
+
+static inline q16_16_t q16_16_mul(q16_16_t a, q16_16_t b)
+{
+	return (q16_16_t)(((int64_t)a * b) >> Q16_16_FRAC_BITS);
+}
+
+static inline q16_16_t q16_16_div(q16_16_t a, q16_16_t b)
+{
+	return (q16_16_t)(((int64_t)a << Q16_16_FRAC_BITS) / b);
+}
+
+/* Shift right, rounding to nearest with ties away from zero, so that -x rounds to -(x rounded) */
+static inline int64_t q16_16_round_shift(int64_t val, unsigned int shift)
+{
+	int64_t half = (int64_t)1 << (shift - 1);
+
+	return val >= 0 ? (val + half) >> shift : -((-val + half) >> shift);
+}
+
+/* Same as q16_16_mul(), but rounds symmetrically instead of towards negative infinity */
+static inline q16_16_t q16_16_mul_round(q16_16_t a, q16_16_t b)
+{
+	return (q16_16_t)q16_16_round_shift((int64_t)a * b, Q16_16_FRAC_BITS);
+}
+
+/* 1 / b scaled by 2^48, so that dividing by b is a multiply and a shift */
+typedef int64_t q16_16_recip_t;
+
+#define Q16_16_RECIP_SHIFT (3 * Q16_16_FRAC_BITS)
+
+/* |b| must be at least 1.0, so that q16_16_mul_recip() products fit in 64 bits */
+static inline q16_16_recip_t q16_16_recip(q16_16_t b)
+{
+	int64_t one = (int64_t)1 << Q16_16_RECIP_SHIFT;
+	int64_t abs_b = b >= 0 ? b : -(int64_t)b;
+	int64_t recip = (one + abs_b / 2) / abs_b;
+
+	return b >= 0 ? recip : -recip;
+}
+
+/* a / b from the reciprocal of b, rounded symmetrically */
+static inline q16_16_t q16_16_mul_recip(q16_16_t a, q16_16_recip_t recip_b)
+{
+	return (q16_16_t)q16_16_round_shift((int64_t)a * recip_b,
+					    Q16_16_RECIP_SHIFT - Q16_16_FRAC_BITS);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
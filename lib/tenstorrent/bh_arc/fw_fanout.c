@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fw_fanout.h"
+#include "noc_dma.h"
+#include "noc_init.h"
+#include "noc2axi.h"
+
+#include <tenstorrent/spi_flash_buf.h>
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(fw_fanout, CONFIG_TT_APP_LOG_LEVEL);
+
+/* Images are staged in the L1 of an enabled Tensix, above the 512KB that the MRISC and ERISC L1
+ * wipes copy zeros from, and the staging area is zeroed again afterwards.
+ */
+#define FW_FANOUT_TLB          12
+#define FW_FANOUT_STAGING_ADDR 0x100000
+#define FW_FANOUT_STAGING_SIZE (512 * 1024)
+
+static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
+
+static K_MUTEX_DEFINE(fw_fanout_mutex);
+
+int FwFanOut(const tt_boot_fs_fd *fd, uint8_t *buf, size_t buf_size,
+	     const struct noc_dma_dest *dests, size_t num_dests)
+{
+	size_t image_size = fd->flags.f.image_size;
+	uint32_t cksum;
+	uint8_t x, y;
+	int rc;
+
+	if (num_dests == 0) {
+		return 0;
+	}
+
+	/* NOC2AXI to Tensix L1 transactions must be aligned to 64 bytes. Reading past the end of
+	 * the image only stages flash contents that are never copied out.
+	 */
+	size_t staged_size = ROUND_UP(image_size, 64);
+
+	if (staged_size > FW_FANOUT_STAGING_SIZE) {
+		LOG_ERR("Image size %zu exceeds staging size %u", image_size,
+			FW_FANOUT_STAGING_SIZE);
+		return -E2BIG;
+	}
+
+	k_mutex_lock(&fw_fanout_mutex, K_FOREVER);
+
+	GetEnabledTensix(&x, &y);
+	NOC2AXITlbSetup(0, FW_FANOUT_TLB, x, y, FW_FANOUT_STAGING_ADDR);
+
+	/* The image is checksummed as it streams through buf, so verifying it is nearly free */
+	rc = spi_arc_dma_transfer_to_tile_cksum(
+		flash, fd->spi_addr, staged_size, buf, buf_size,
+		(uint8_t *)GetTlbWindowAddr(0, FW_FANOUT_TLB, FW_FANOUT_STAGING_ADDR), image_size,
+		&cksum);
+	if (rc < 0) {
+		LOG_ERR("%s() failed: %d", "spi_arc_dma_transfer_to_tile_cksum", rc);
+	} else if (cksum != fd->data_crc) {
+		LOG_ERR("Image checksum 0x%08x does not match 0x%08x", cksum, fd->data_crc);
+		rc = -EIO;
+	} else {
+		rc = NocDmaCopy(x, y, FW_FANOUT_STAGING_ADDR, dests, num_dests, image_size);
+	}
+
+	/* Tensix L1 below the staging area is still zero from tensix_init */
+	const struct noc_dma_dest staging = {
+		.x = x,
+		.y = y,
+		.addr = FW_FANOUT_STAGING_ADDR,
+	};
+	int wipe_rc = NocDmaCopy(x, y, 0, &staging, 1, staged_size);
+
+	k_mutex_unlock(&fw_fanout_mutex);
+
+	return rc < 0 ? rc : wipe_rc;
+}
@@ -0,0 +1,24 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef FW_FANOUT_H
+#define FW_FANOUT_H
+
+#include "noc_dma.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <tenstorrent/tt_boot_fs.h>
+
+/* Read the image of fd from SPI flash once, verify its checksum and copy it to every destination
+ * over the NOC. Returns once all copies have landed, or -EIO without copying if the checksum does
+ * not match.
+ */
+int FwFanOut(const tt_boot_fs_fd *fd, uint8_t *buf, size_t buf_size,
+	     const struct noc_dma_dest *dests, size_t num_dests);
+
+#endif
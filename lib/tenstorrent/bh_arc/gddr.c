@@ -4,10 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include "fw_fanout.h"
 #include "gddr.h"
 #include "harvesting.h"
 #include "init.h"
 #include "noc.h"
+#include "noc_dma.h"
 #include "noc_init.h"
 #include "noc2axi.h"
 #include "reg.h"
@@ -25,13 +27,11 @@
 #include <zephyr/drivers/clock_control/clock_control_tt_bh.h>
 #include <zephyr/drivers/clock_control.h>
 #include <zephyr/drivers/dma.h>
-#include <zephyr/drivers/dma/dma_tt_bh_noc.h>
 #include <zephyr/drivers/dma/dma_arc_hs.h>
 
 static const struct device *const pll_dev_3 = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(pll3));
 static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
 static const struct device *const arc_dma_dev = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(dma0));
-static const struct device *dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 
 /* This is the noc2axi instance we want to run the MRISC FW on */
 #define MRISC_FW_NOC2AXI_PORT 0
@@ -105,7 +105,7 @@ static void MriscRegWrite32(uint8_t gddr_inst, uint32_t addr, uint32_t val)
 int read_gddr_telemetry_table(uint8_t gddr_inst, gddr_telemetry_table_t *gddr_telemetry)
 {
 	volatile uint8_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
-	if (dma_arc_hs_transfer(arc_dma_dev, 0,
+	if (dma_arc_hs_transfer(arc_dma_dev, ARC_DMA_CHANNEL_GDDR,
 				(const void *)(mrisc_l1 + GDDR_TELEMETRY_TABLE_ADDR),
 				gddr_telemetry, sizeof(*gddr_telemetry), K_MSEC(500)) < 0) {
 		/* If DMA failed, can read 32b at a time via NOC2AXI */
@@ -160,25 +160,6 @@ static void SetAxiEnable(uint8_t gddr_inst, uint8_t noc2axi_port, bool axi_enabl
 	}
 }
 
-static int LoadMriscFw(uint8_t gddr_inst, uint8_t *buf, size_t buf_size, size_t spi_address,
-		       size_t image_size)
-{
-	volatile uint32_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
-	int rc = spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
-					      (uint8_t *)mrisc_l1);
-
-	return rc;
-}
-static int LoadMriscFwCfg(uint8_t gddr_inst, uint8_t *buf, size_t buf_size, size_t spi_address,
-			  size_t image_size)
-{
-	volatile uint32_t *mrisc_l1 = SetupMriscL1Tlb(gddr_inst);
-	int rc = spi_arc_dma_transfer_to_tile(flash, spi_address, image_size, buf, buf_size,
-					      (uint8_t *)mrisc_l1 + MRISC_FW_CFG_OFFSET);
-
-	return rc;
-}
-
 static uint32_t GetDramMask(void)
 {
 	uint32_t dram_mask = tile_enable.gddr_enabled; /* bit mask */
@@ -282,47 +263,44 @@ static void wipe_l1(void)
 	uint8_t noc_id = 0;
 	uint64_t addr = 0;
 	uint32_t dram_mask = GetDramMask();
+	struct noc_dma_dest dests[NUM_GDDR * NUM_MRISC_NOC2AXI_PORT];
+	size_t num_dests = 0;
 	uint8_t tensix_x, tensix_y;
 
 	GetEnabledTensix(&tensix_x, &tensix_y);
 
-	struct tt_bh_dma_noc_coords coords =
-		tt_bh_dma_noc_coords_init(tensix_x, tensix_y, 0, 0);
-
-	struct dma_block_config block = {
-		.source_address = addr,
-		.dest_address = addr,
-		.block_size = MRISC_L1_SIZE,
-	};
-
-	struct dma_config config = {
-		.channel_direction = PERIPHERAL_TO_MEMORY,
-		.source_data_size = 1,
-		.dest_data_size = 1,
-		.source_burst_length = 1,
-		.dest_burst_length = 1,
-		.block_count = 1,
-		.head_block = &block,
-		.user_data = &coords,
-	};
-
 	for (uint32_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
 		if (IS_BIT_SET(dram_mask, gddr_inst)) {
 			for (uint32_t noc2axi_port = 0; noc2axi_port < NUM_MRISC_NOC2AXI_PORT;
 			     noc2axi_port++) {
-				uint8_t x, y;
-
-				GetGddrNocCoords(gddr_inst, noc2axi_port, noc_id, &x, &y);
-
-				coords.dest_x = x;
-				coords.dest_y = y;
+				struct noc_dma_dest *dest = &dests[num_dests++];
 
+				GetGddrNocCoords(gddr_inst, noc2axi_port, noc_id, &dest->x,
+						 &dest->y);
 				/* AXI enable must not be set, using MRISC address 0 */
-				dma_config(dma_noc, 1, &config);
-				dma_start(dma_noc, 1);
+				dest->addr = addr;
 			}
 		}
 	}
+
+	NocDmaCopy(tensix_x, tensix_y, addr, dests, num_dests, MRISC_L1_SIZE);
+}
+
+/* Queue the MRISC L1 address addr of every GDDR in dram_mask as an image destination */
+static size_t GetMriscFwDests(uint32_t dram_mask, uint64_t addr, struct noc_dma_dest *dests)
+{
+	size_t num_dests = 0;
+
+	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
+		if (IS_BIT_SET(dram_mask, gddr_inst)) {
+			struct noc_dma_dest *dest = &dests[num_dests++];
+
+			GetGddrNocCoords(gddr_inst, MRISC_FW_NOC2AXI_PORT, 0, &dest->x, &dest->y);
+			dest->addr = addr;
+		}
+	}
+
+	return num_dests;
 }
 
 static int InitMrisc(void)
@@ -350,6 +328,9 @@ static int InitMrisc(void)
 	size_t image_size;
 	size_t spi_address;
 
+	struct noc_dma_dest dests[NUM_GDDR];
+	size_t num_dests;
+
 	uint8_t buf[SCRATCHPAD_SIZE] __aligned(4);
 
 	rc = tt_boot_fs_find_fd_by_tag(flash, MRISC_FW_TAG, &tag_fd);
@@ -357,16 +338,12 @@ static int InitMrisc(void)
 		LOG_ERR("%s (%s) failed: %d", "tt_boot_fs_find_fd_by_tag", MRISC_FW_TAG, rc);
 		return rc;
 	}
-	image_size = tag_fd.flags.f.image_size;
-	spi_address = tag_fd.spi_addr;
 
-	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
-		if (IS_BIT_SET(dram_mask, gddr_inst)) {
-			if (LoadMriscFw(gddr_inst, buf, SCRATCHPAD_SIZE, spi_address, image_size)) {
-				LOG_ERR("%s(%d) failed: %d", "LoadMriscFw", gddr_inst, -EIO);
-				return -EIO;
-			}
-		}
+	/* Read the image from SPI once and copy it to all MRISCs over the NOC */
+	num_dests = GetMriscFwDests(dram_mask, MRISC_L1_ADDR, dests);
+	if (FwFanOut(&tag_fd, buf, SCRATCHPAD_SIZE, dests, num_dests)) {
+		LOG_ERR("%s(%s) failed: %d", "FwFanOut", MRISC_FW_TAG, -EIO);
+		return -EIO;
 	}
 
 	rc = tt_boot_fs_find_fd_by_tag(flash, MRISC_FW_CFG_TAG, &tag_fd);
@@ -402,13 +379,14 @@ static int InitMrisc(void)
 		return -EIO;
 	}
 
+	num_dests = GetMriscFwDests(dram_mask, MRISC_L1_ADDR + MRISC_FW_CFG_OFFSET, dests);
+	if (FwFanOut(&tag_fd, buf, SCRATCHPAD_SIZE, dests, num_dests)) {
+		LOG_ERR("%s(%s) failed: %d", "FwFanOut", MRISC_FW_CFG_TAG, -EIO);
+		return -EIO;
+	}
+
 	for (uint8_t gddr_inst = 0; gddr_inst < NUM_GDDR; gddr_inst++) {
 		if (IS_BIT_SET(dram_mask, gddr_inst)) {
-			if (LoadMriscFwCfg(gddr_inst, buf, SCRATCHPAD_SIZE, spi_address,
-					   image_size)) {
-				LOG_ERR("%s(%d) failed: %d", "LoadMriscFwCfg", gddr_inst, -EIO);
-				return -EIO;
-			}
 			MriscRegWrite32(gddr_inst, MRISC_INIT_STATUS, MRISC_INIT_BEFORE);
 			ReleaseMriscReset(gddr_inst);
 		}
@@ -27,6 +27,12 @@
 #define RESET_UNIT_TENSIX_RISC_RESET_0_REG_ADDR 0x80030040
 #define SCRATCHPAD_SIZE                         CONFIG_TT_BH_ARC_SCRATCHPAD_SIZE
 
+/* Each ARC DMA user has a channel of its own, so that their transfers can overlap */
+#define ARC_DMA_CHANNEL_PCIE 0
+#define ARC_DMA_CHANNEL_SPI  1
+#define ARC_DMA_CHANNEL_ETH  2
+#define ARC_DMA_CHANNEL_GDDR 3
+
 typedef struct {
 	uint32_t system_reset_n: 1;
 	uint32_t noc_reset_n: 1;
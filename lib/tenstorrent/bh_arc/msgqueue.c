@@ -18,6 +18,7 @@
 #include "status_reg.h"
 #include "reg.h"
 #include "irqnum.h"
+#include "timer.h"
 
 #define MSGHANDLER_COMPAT_MASK 0x1
 
@@ -69,6 +70,8 @@ typedef union {
 #define MSI_CATCHER_STATUS_REG_ADDR (MSI_CATCHER_BASE + MSI_CATCHER_STATUS_OFFSET)
 
 BUILD_ASSERT(sizeof(union request) <= (sizeof(uint32_t) * REQUEST_MSG_LEN));
+BUILD_ASSERT(MSG_QUEUE_SIZE <= 0xFF && NUM_MSG_QUEUES <= 0xFF,
+	     "message queue geometry must fit in message_queue_info");
 typedef struct {
 	uint32_t msi_ready: 1; /* [0:0] -- FIFO can accept a push. (Out of reset and not full.) */
 	uint32_t unused: 7;
@@ -91,11 +94,63 @@ struct message_queue {
 /* All the message queues in the system. */
 static struct message_queue message_queues[NUM_MSG_QUEUES];
 
+/* Firmware-side state of a message queue, not visible to the host. */
+struct message_queue_state {
+	/* Next response slot to hand out. Runs ahead of response_queue_wptr while responses are
+	 * pending.
+	 */
+	uint32_t response_reserve_ptr;
+	/* Response slots reserved by asynchronous requests that have not completed yet. */
+	ATOMIC_DEFINE(pending, MSG_QUEUE_SIZE);
+	/* Message code and dispatch time of the request in each pending slot, for its stats. */
+	uint32_t pending_msg_code[MSG_QUEUE_SIZE];
+	uint64_t pending_start[MSG_QUEUE_SIZE];
+};
+
+static struct message_queue_state message_queue_states[NUM_MSG_QUEUES];
+
+/* Priority of each message queue, lower values are serviced first. */
+static uint8_t message_queue_priority[NUM_MSG_QUEUES];
+
+/* Queues that overran a handler deadline and yield to all other ready queues. */
+static uint32_t message_queue_deferred;
+
 /* All message handlers */
 static void *message_handlers[CONFIG_TT_BH_ARC_NUM_MSG_CODES];
 
+/* Message codes whose handler is a msgqueue_async_request_handler_t */
+static ATOMIC_DEFINE(message_handlers_async, CONFIG_TT_BH_ARC_NUM_MSG_CODES);
+
+#define MSGQUEUE_TOKEN(queue_id, slot)  (((queue_id) << 8) | (slot))
+#define MSGQUEUE_TOKEN_QUEUE(token)     ((token) >> 8)
+#define MSGQUEUE_TOKEN_SLOT(token)      ((token) & 0xFF)
+
+/* Number of times each message handler exceeded its deadline */
+static uint16_t message_handler_overruns[CONFIG_TT_BH_ARC_NUM_MSG_CODES];
+
+#define MSG_HANDLER_DEADLINE_CYCLES (CONFIG_TT_BH_ARC_MSGQUEUE_HANDLER_DEADLINE_US * WAIT_1US)
+
+#if CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES > 0
+/* Per message code handler statistics, read by the host. */
+static struct {
+	struct msgqueue_stats header;
+	struct msgqueue_stats_entry entries[CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES];
+} message_stats;
+
+/* Entry index + 1 for each message code, 0 if the code has no entry yet. */
+static uint8_t message_stats_index[CONFIG_TT_BH_ARC_NUM_MSG_CODES];
+static uint8_t message_stats_used;
+
+/* Asynchronous requests record their stats on completion, which may be in an ISR. */
+static struct k_spinlock message_stats_lock;
+
+#define MESSAGE_STATS_ADDR ((uintptr_t)&message_stats)
+#else
+#define MESSAGE_STATS_ADDR 0
+#endif
+
 __attribute__((used)) static const uintptr_t message_queue_info[] = {
-	(uintptr_t)&message_queues, MSG_QUEUE_SIZE | (NUM_MSG_QUEUES << 8), 0, 0};
+	(uintptr_t)&message_queues, MSG_QUEUE_SIZE | (NUM_MSG_QUEUES << 8), MESSAGE_STATS_ADDR, 0};
 
 static inline void *mask_voidp(void *x, uintptr_t mask)
 {
@@ -201,38 +256,37 @@ int msgqueue_response_pop(uint32_t msgqueue_id, struct response *response)
 	return 0;
 }
 
-static bool start_next_message(struct message_queue *queue, uint32_t *request_rptr_out,
-			       uint32_t *response_wptr_out)
+/* Number of slots in use between a read and write pointer. */
+static uint32_t queue_occupancy(uint32_t wptr, uint32_t rptr)
 {
 	/* Queue pointers are double-wrapped so equal means empty, differ by size means full. */
+	return (wptr + MSG_QUEUE_POINTER_WRAP - rptr) % MSG_QUEUE_POINTER_WRAP;
+}
 
+/* Number of requests that can be run right now, limited by free response slots and batch size. */
+static uint32_t ready_message_count(struct message_queue *queue)
+{
 	uint32_t request_wptr = queue->header.request_queue_wptr;
 	uint32_t request_rptr = queue->header.request_queue_rptr;
-
-	if (request_wptr == request_rptr) {
-		return false;
-	}
-
-	/* Don't accept a request unless there's a response queue slot. */
-	/* We must not block and we don't want to hold onto the response. */
-	uint32_t response_wptr = queue->header.response_queue_wptr;
+	/* Slots reserved by pending requests are not available either. */
+	uint32_t response_wptr = message_queue_states[queue - message_queues].response_reserve_ptr;
 	uint32_t response_rptr = queue->header.response_queue_rptr;
 
-	if ((response_wptr - response_rptr) % MSG_QUEUE_POINTER_WRAP == MSG_QUEUE_SIZE) {
-		return false;
-	}
-
 	if (request_wptr >= MSG_QUEUE_POINTER_WRAP || request_rptr >= MSG_QUEUE_POINTER_WRAP ||
-	    response_wptr >= MSG_QUEUE_POINTER_WRAP || request_rptr >= MSG_QUEUE_POINTER_WRAP) {
-		return false;
+	    response_wptr >= MSG_QUEUE_POINTER_WRAP || response_rptr >= MSG_QUEUE_POINTER_WRAP) {
+		return 0;
 	}
 
-	atomic_thread_fence(memory_order_acquire);
+	uint32_t pending = queue_occupancy(request_wptr, request_rptr);
+	uint32_t responses = queue_occupancy(response_wptr, response_rptr);
 
-	*request_rptr_out = request_rptr;
-	*response_wptr_out = response_wptr;
+	if (pending > MSG_QUEUE_SIZE || responses > MSG_QUEUE_SIZE) {
+		return 0;
+	}
 
-	return true;
+	/* Don't accept a request unless there's a response queue slot. */
+	/* We must not block and we don't want to hold onto the response. */
+	return MIN(MIN(pending, MSG_QUEUE_SIZE - responses), MSG_QUEUE_BATCH_SIZE);
 }
 
 static bool command_writes_serial(const union request *request)
@@ -247,22 +301,115 @@ static void advance_serial(struct message_queue *queue, const union request *req
 	}
 }
 
+static void reset_message_stats(void)
+{
+#if CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES > 0
+	k_spinlock_key_t key = k_spin_lock(&message_stats_lock);
+
+	memset(&message_stats, 0, sizeof(message_stats));
+	memset(message_stats_index, 0, sizeof(message_stats_index));
+	message_stats_used = 0;
+
+	message_stats.header.version = MSG_STATS_VERSION;
+	message_stats.header.num_entries = CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES;
+	message_stats.header.hist_buckets = MSG_STATS_HIST_BUCKETS;
+	message_stats.header.hist_min_log2 = MSG_STATS_HIST_MIN_LOG2;
+
+	k_spin_unlock(&message_stats_lock, key);
+#endif
+}
+
+static void record_message_stats(uint32_t msg_code, uint8_t exit_code, uint64_t cycles)
+{
+#if CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES > 0
+	k_spinlock_key_t key = k_spin_lock(&message_stats_lock);
+
+	if (message_stats_index[msg_code] == 0) {
+		if (message_stats_used == CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES) {
+			message_stats.header.dropped++;
+			k_spin_unlock(&message_stats_lock, key);
+			return;
+		}
+		message_stats.entries[message_stats_used].msg_code = msg_code;
+		message_stats_index[msg_code] = ++message_stats_used;
+	}
+
+	struct msgqueue_stats_entry *entry =
+		&message_stats.entries[message_stats_index[msg_code] - 1];
+	uint32_t duration = MIN(cycles, UINT32_MAX);
+	int bucket = (int)find_msb_set(duration) - 1 - MSG_STATS_HIST_MIN_LOG2;
+
+	entry->count++;
+	if (exit_code != 0) {
+		entry->errors++;
+	}
+	entry->max_cycles = MAX(entry->max_cycles, duration);
+	entry->hist[CLAMP(bucket, 0, MSG_STATS_HIST_BUCKETS - 1)]++;
+
+	k_spin_unlock(&message_stats_lock, key);
+#endif
+}
+
 /* Forward to process_l2_message. Nearly every message takes this path. */
-static void process_l2_message_queue(const union request *request, struct response *response)
+static bool process_l2_message_queue(const union request *request, struct response *response,
+				     msgqueue_token_t token)
 {
 	uint32_t msg_code = request->command_code;
+	bool pending = false;
+	uint8_t exit_code;
 
-	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES || message_handlers[msg_code] == NULL) {
+	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES) {
 		response->data[0] = MSG_ERROR_REPLY;
-		return;
+		return false;
+	}
+
+	if (message_handlers[msg_code] == NULL) {
+		response->data[0] = MSG_ERROR_REPLY;
+		record_message_stats(msg_code, MSG_ERROR_REPLY, 0);
+		return false;
 	}
 
-	msgqueue_request_handler_t handler = message_handlers[msg_code];
-	uint8_t exit_code = handler(request, response);
+	uint64_t start = TimerTimestamp();
+
+	if (atomic_test_bit(message_handlers_async, msg_code)) {
+		msgqueue_async_request_handler_t handler = message_handlers[msg_code];
+		struct message_queue_state *state =
+			&message_queue_states[MSGQUEUE_TOKEN_QUEUE(token)];
+		uint32_t slot = MSGQUEUE_TOKEN_SLOT(token);
+
+		/* Saved first, the handler may complete the request before it returns */
+		state->pending_msg_code[slot] = msg_code;
+		state->pending_start[slot] = start;
 
-	response->data[0] |= exit_code;
+		int ret = handler(request, response, token);
+
+		pending = (ret == -EINPROGRESS);
+		exit_code = pending ? 0 : (uint8_t)ret;
+	} else {
+		msgqueue_request_handler_t handler = message_handlers[msg_code];
+
+		exit_code = handler(request, response);
+	}
+
+	/* A pending request is recorded by msgqueue_complete(), with its full latency */
+	if (!pending) {
+		record_message_stats(msg_code, exit_code, TimerTimestamp() - start);
+		response->data[0] |= exit_code;
+	}
+
+	return pending;
 }
 
+static uint8_t reset_msg_stats_handler(const union request *request, struct response *response)
+{
+	ARG_UNUSED(request);
+	ARG_UNUSED(response);
+
+	reset_message_stats();
+	return 0;
+}
+REGISTER_MESSAGE(TT_SMC_MSG_RESET_MSG_STATS, reset_msg_stats_handler);
+
 static void handle_set_last_serial(struct message_queue *queue, const union request *request)
 {
 	queue->header.last_serial = request->data[1];
@@ -282,9 +429,9 @@ static void report_scratch_only_message(struct response *response)
 	response->data[0] = MESSAGE_QUEUE_STATUS_SCRATCH_ONLY;
 }
 
-/* Run a single message. */
-static void process_queued_message(struct message_queue *queue, const union request *request,
-				   struct response *response)
+/* Run a single message. Returns true if the response is pending. */
+static bool process_queued_message(struct message_queue *queue, const union request *request,
+				   struct response *response, msgqueue_token_t token)
 {
 	switch (request->command_code) {
 	case TT_SMC_MSG_SET_LAST_SERIAL:
@@ -297,28 +444,120 @@ static void process_queued_message(struct message_queue *queue, const union requ
 		report_scratch_only_message(response);
 		break;
 	default:
-		process_l2_message_queue(request, response);
-		break;
+		return process_l2_message_queue(request, response, token);
 	}
+
+	return false;
 }
 
-/* Run all the outstanding messages in a single queue. */
-static void process_message_queue(struct message_queue *queue)
+/* Publish completed responses to the host, in order, up to the first pending one. */
+static void publish_responses(struct message_queue *queue)
 {
+	struct message_queue_state *state = &message_queue_states[queue - message_queues];
+	uint32_t response_wptr = queue->header.response_queue_wptr;
 
-	uint32_t request_rptr;
-	uint32_t response_wptr;
+	if (response_wptr == state->response_reserve_ptr) {
+		return;
+	}
 
-	while (start_next_message(queue, &request_rptr, &response_wptr)) {
-		union request request = (union request){0};
-		struct response response = (struct response){0};
+	while (response_wptr != state->response_reserve_ptr &&
+	       !atomic_test_bit(state->pending, response_wptr % MSG_QUEUE_SIZE)) {
+		response_wptr = (response_wptr + 1) % MSG_QUEUE_POINTER_WRAP;
+	}
+
+	atomic_thread_fence(memory_order_seq_cst);
+	queue->header.response_queue_wptr = response_wptr;
+}
+
+/* Account a handler run against its deadline. Returns true if the deadline was exceeded. */
+static bool handler_overran(const union request *request, uint64_t start)
+{
+	uint32_t msg_code = request->command_code;
+
+	if (TimerTimestamp() - start <= MSG_HANDLER_DEADLINE_CYCLES) {
+		return false;
+	}
+
+	if (msg_code < CONFIG_TT_BH_ARC_NUM_MSG_CODES &&
+	    message_handler_overruns[msg_code] < UINT16_MAX) {
+		message_handler_overruns[msg_code]++;
+	}
 
-		msgqueue_request_pop(queue - message_queues, &request);
-		process_queued_message(queue, &request, &response);
-		msgqueue_response_push(queue - message_queues, &response);
+	return true;
+}
+
+/* Run a batch of messages from a single queue, publishing all responses at once. */
+static void process_message_batch(struct message_queue *queue, uint32_t count)
+{
+	uint32_t queue_id = queue - message_queues;
+	struct message_queue_state *state = &message_queue_states[queue_id];
+	uint32_t response_wptr = state->response_reserve_ptr;
+	uint32_t done = 0;
+
+	atomic_thread_fence(memory_order_acquire);
+
+	while (done < count) {
+		union request request = (union request){0};
+		uint32_t slot = (response_wptr + done) % MSG_QUEUE_SIZE;
+		struct response *response = response_entry(queue, slot);
+		uint64_t start = TimerTimestamp();
+
+		msgqueue_request_pop(queue_id, &request);
+		*response = (struct response){0};
+
+		/* Reserve the slot before running the handler, it may complete from an ISR. */
+		atomic_set_bit(state->pending, slot);
+		if (!process_queued_message(queue, &request, response,
+					    MSGQUEUE_TOKEN(queue_id, slot))) {
+			atomic_clear_bit(state->pending, slot);
+		}
 
 		advance_serial(queue, &request);
+		done++;
+
+		if (handler_overran(&request, start)) {
+			/* Let the other queues catch up before running more of this one. */
+			message_queue_deferred |= BIT(queue_id);
+			break;
+		}
+	}
+
+	state->response_reserve_ptr = (response_wptr + done) % MSG_QUEUE_POINTER_WRAP;
+	publish_responses(queue);
+}
+
+/* Pick the highest priority queue that has requests ready to run. */
+static struct message_queue *next_ready_queue(uint32_t *count)
+{
+	struct message_queue *next = NULL;
+	uint8_t next_priority = UINT8_MAX;
+
+	for (unsigned int i = 0; i < NUM_MSG_QUEUES; i++) {
+		uint32_t ready;
+
+		if (message_queue_deferred & BIT(i)) {
+			continue;
+		}
+
+		if (next != NULL && message_queue_priority[i] >= next_priority) {
+			continue;
+		}
+
+		ready = ready_message_count(&message_queues[i]);
+		if (ready > 0) {
+			next = &message_queues[i];
+			next_priority = message_queue_priority[i];
+			*count = ready;
+		}
+	}
+
+	if (next == NULL && message_queue_deferred != 0) {
+		/* Every other queue is idle, so deferred queues may run again. */
+		message_queue_deferred = 0;
+		return next_ready_queue(count);
 	}
+
+	return next;
 }
 
 void clear_msg_irq(void)
@@ -334,14 +573,42 @@ void clear_msg_irq(void)
 /* Run all messages in all queues. */
 void process_message_queues(void)
 {
+	struct message_queue *queue;
+	uint32_t count;
+
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARC_MSG_HANDLE_START);
+	/* Pick up asynchronous completions */
 	for (unsigned int i = 0; i < NUM_MSG_QUEUES; i++) {
-		SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARG_MSG_QUEUE_START + i);
-		process_message_queue(&message_queues[i]);
+		publish_responses(&message_queues[i]);
+	}
+
+	while ((queue = next_ready_queue(&count)) != NULL) {
+		SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARG_MSG_QUEUE(queue - message_queues));
+		process_message_batch(queue, count);
 	}
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_ARC_MSG_HANDLE_DONE);
 }
 
+int msgqueue_set_priority(uint32_t msgqueue_id, uint8_t priority)
+{
+	if (msgqueue_id >= NUM_MSG_QUEUES) {
+		return -1;
+	}
+
+	message_queue_priority[msgqueue_id] = priority;
+
+	return 0;
+}
+
+uint16_t msgqueue_handler_overrun_count(uint32_t msg_code)
+{
+	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES) {
+		return 0;
+	}
+
+	return message_handler_overruns[msg_code];
+}
+
 void msgqueue_register_handler(uint32_t msg_code, msgqueue_request_handler_t handler)
 {
 	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES) {
@@ -349,6 +616,17 @@ void msgqueue_register_handler(uint32_t msg_code, msgqueue_request_handler_t han
 	}
 
 	message_handlers[msg_code] = handler;
+	atomic_clear_bit(message_handlers_async, msg_code);
+}
+
+void msgqueue_register_async_handler(uint32_t msg_code, msgqueue_async_request_handler_t handler)
+{
+	if (msg_code >= CONFIG_TT_BH_ARC_NUM_MSG_CODES) {
+		return;
+	}
+
+	message_handlers[msg_code] = handler;
+	atomic_set_bit(message_handlers_async, msg_code);
 }
 
 static void prepare_msg_queue(void)
@@ -356,8 +634,12 @@ static void prepare_msg_queue(void)
 	/* clear message queue headers */
 	for (unsigned int i = 0; i < NUM_MSG_QUEUES; i++) {
 		memset(&message_queues[i].header, 0, sizeof(message_queues[i].header));
+		memset(&message_queue_states[i], 0, sizeof(message_queue_states[i]));
+		message_queue_priority[i] = i;
 	}
 
+	reset_message_stats();
+
 	/* populate address of message queue info */
 	WriteReg(STATUS_MSG_Q_INFO_REG_ADDR, (uint32_t)message_queue_info);
 }
@@ -366,7 +648,11 @@ static void prepare_msg_queue(void)
 static int register_interrupt_handlers(void)
 {
 	STRUCT_SECTION_FOREACH(msgqueue_handler, item) {
-		msgqueue_register_handler(item->msg_type, item->handler);
+		if (item->async_handler != NULL) {
+			msgqueue_register_async_handler(item->msg_type, item->async_handler);
+		} else {
+			msgqueue_register_handler(item->msg_type, item->handler);
+		}
 	}
 	return 0;
 }
@@ -375,18 +661,40 @@ SYS_INIT_APP(register_interrupt_handlers);
 #endif
 
 #ifdef CONFIG_BOARD_TT_BLACKHOLE
-static void msgqueue_work_handler(struct k_work *work)
+#ifdef K_FP_REGS
+#define MSGQUEUE_THREAD_OPTIONS K_FP_REGS
+#else
+#define MSGQUEUE_THREAD_OPTIONS 0
+#endif
+
+static K_SEM_DEFINE(msgqueue_sem, 0, 1);
+
+static void msgqueue_thread_entry(void *p1, void *p2, void *p3)
 {
-	process_message_queues();
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&msgqueue_sem, K_FOREVER);
+		process_message_queues();
+	}
 }
 
-static K_WORK_DEFINE(msgqueue_work, msgqueue_work_handler);
+K_THREAD_DEFINE(msgqueue_thread, CONFIG_TT_BH_ARC_MSGQUEUE_THREAD_STACK_SIZE,
+		msgqueue_thread_entry, NULL, NULL, NULL, CONFIG_TT_BH_ARC_MSGQUEUE_THREAD_PRIORITY,
+		MSGQUEUE_THREAD_OPTIONS, 0);
+
+static void msgqueue_wakeup(void)
+{
+	k_sem_give(&msgqueue_sem);
+}
 
 static void msgqueue_interrupt_handler(void *arg)
 {
 	(void)(arg);
 	clear_msg_irq();
-	k_work_submit(&msgqueue_work);
+	msgqueue_wakeup();
 }
 
 static bool msi_catcher_nonempty(void)
@@ -423,7 +731,7 @@ static void msgqueue_msi_interrupt_handler(void *arg)
 	}
 
 	if (msi_for_msgqueue) {
-		k_work_submit(&msgqueue_work);
+		msgqueue_wakeup();
 	}
 }
 
@@ -432,10 +740,61 @@ static void msgqueue_msi_overflow_handler(void *arg)
 	(void)(arg);
 
 	msi_catcher_flush();
-	k_work_submit(&msgqueue_work);
+	msgqueue_wakeup();
+}
+#else
+static inline void msgqueue_wakeup(void)
+{
 }
 #endif
 
+int msgqueue_complete(msgqueue_token_t token, const struct response *response, uint8_t exit_code)
+{
+	uint32_t queue_id = MSGQUEUE_TOKEN_QUEUE(token);
+	uint32_t slot = MSGQUEUE_TOKEN_SLOT(token);
+
+	if (queue_id >= NUM_MSG_QUEUES || slot >= MSG_QUEUE_SIZE ||
+	    !atomic_test_bit(message_queue_states[queue_id].pending, slot)) {
+		return -EINVAL;
+	}
+
+	struct message_queue_state *state = &message_queue_states[queue_id];
+	struct response *entry = response_entry(&message_queues[queue_id], slot);
+
+	record_message_stats(state->pending_msg_code[slot], exit_code,
+			     TimerTimestamp() - state->pending_start[slot]);
+
+	*entry = (response != NULL) ? *response : (struct response){0};
+	entry->data[0] |= exit_code;
+
+	/* The response must be visible before the slot can be published. */
+	atomic_thread_fence(memory_order_seq_cst);
+	atomic_clear_bit(state->pending, slot);
+	msgqueue_wakeup();
+
+	return 0;
+}
+
+static K_KERNEL_STACK_DEFINE(msgqueue_work_q_stack, CONFIG_TT_BH_ARC_MSGQUEUE_WORKQ_STACK_SIZE);
+static struct k_work_q msgqueue_work_q;
+
+int msgqueue_submit_work(struct k_work *work)
+{
+	return k_work_submit_to_queue(&msgqueue_work_q, work);
+}
+
+static int msgqueue_work_q_init(void)
+{
+	const struct k_work_queue_config cfg = {.name = "msgqueue_workq"};
+
+	k_work_queue_start(&msgqueue_work_q, msgqueue_work_q_stack,
+			   K_KERNEL_STACK_SIZEOF(msgqueue_work_q_stack),
+			   CONFIG_TT_BH_ARC_MSGQUEUE_WORKQ_PRIORITY, &cfg);
+
+	return 0;
+}
+SYS_INIT(msgqueue_work_q_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
 void init_msgqueue(void)
 {
 	prepare_msg_queue();
@@ -6,6 +6,7 @@
 
 #include "noc.h"
 #include "noc2axi.h"
+#include "noc_init.h"
 
 typedef struct {
 	uint32_t passthrough_bits: 24;
@@ -139,15 +140,24 @@ void NOC2AXIMulticastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const u
 /* Broadcast to all unharvested Tensix. Requires NocInit to be called first to set up broadcast
  * disables.
  */
-/* Then we can just broadcast to the entire NOC, skipping ARC's own column to workaround this bug:
+/* The rectangle only spans the enabled Tensix columns, and never ARC's own column, to workaround
+ * this bug:
  */
 /* https://yyz-gitlab.local.tenstorrent.com/tenstorrent/syseng/-/issues/3401#note_191646 */
 void NOC2AXITensixBroadcastTlbSetup(const uint8_t ring, const uint8_t tlb_num, const uint64_t addr,
 				    Noc2AxiOrdering ordering)
 {
-	/* Skip ARC on column x = 8 */
-	const uint8_t kXStart = 9;
-	const uint8_t kXEnd = 7;
-
-	NOC2AXIMulticastTlbSetup(ring, tlb_num, kXStart, 0, kXEnd, NOC_Y_SIZE - 1, addr, ordering);
+	uint8_t x_start, y_start, x_end, y_end;
+
+	GetEnabledTensixRange(&x_start, &y_start, &x_end, &y_end);
+
+	if (ring == 1) {
+		/* NOC 1 runs in the opposite direction, so the range is mirrored */
+		NOC2AXIMulticastTlbSetup(ring, tlb_num, NOC0_X_TO_NOC1(x_end),
+					 NOC0_Y_TO_NOC1(y_end), NOC0_X_TO_NOC1(x_start),
+					 NOC0_Y_TO_NOC1(y_start), addr, ordering);
+	} else {
+		NOC2AXIMulticastTlbSetup(ring, tlb_num, x_start, y_start, x_end, y_end, addr,
+					 ordering);
+	}
 }
@@ -13,6 +13,17 @@
 #define ARC_NOC0_BASE_ADDR 0xC0000000
 #define ARC_NOC1_BASE_ADDR 0xE0000000
 
+/* NOC2AXI TLBs used on ring 0. Boot stages that can run at the same time (see
+ * sys_init_defines.h) must not share a TLB, as one could reprogram it while the other is blocked.
+ * 0     Resets, PCIe MSI and other users that never run alongside another
+ * 0-5   PCIe SERDES, SII and TLB config, and PCIE_DBI_REG_TLB (14)
+ * 6     Tensix clock gating, then ETH and ETH SERDES setup, which waits for Tensix init
+ * 7     NIU configuration and NOC translation
+ * 8-11  NOC DMA channels
+ * 12    Firmware fan-out staging
+ * 13    MRISC setup
+ * 15    Kernel throttle broadcast
+ */
 #define NOC_TLB_LOG_SIZE         24
 #define NOC_TLB_WINDOW_ADDR_MASK ((1 << NOC_TLB_LOG_SIZE) - 1)
 
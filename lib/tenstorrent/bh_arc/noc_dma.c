@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "noc_dma.h"
+#include "noc_init.h"
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/dma_tt_bh_noc.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+
+LOG_MODULE_REGISTER(noc_dma, CONFIG_TT_APP_LOG_LEVEL);
+
+#define NOC_DMA_NUM_CHANNELS DT_PROP(DT_NODELABEL(dma1), dma_channels)
+/* Backstop for NocDmaWait(). The driver times out each transfer well before this. */
+#define NOC_DMA_WAIT_TIMEOUT_MS 200
+
+static const struct device *const dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
+
+/* Copies issued by one call, which waits for all of them */
+struct noc_dma_batch {
+	/* Channels still in flight. Whoever clears a channel's bit releases the channel. */
+	atomic_t channels;
+	int status;
+};
+
+struct noc_dma_slot {
+	/* Passed to the driver as user_data, which it also hands back to the callback */
+	struct tt_bh_dma_noc_coords coords;
+	struct noc_dma_batch *batch;
+};
+
+static struct noc_dma_slot slots[NOC_DMA_NUM_CHANNELS];
+static atomic_t free_channels = ATOMIC_INIT(BIT_MASK(NOC_DMA_NUM_CHANNELS));
+static K_SEM_DEFINE(free_channel_count, NOC_DMA_NUM_CHANNELS, NOC_DMA_NUM_CHANNELS);
+
+static uint32_t AcquireChannel(void)
+{
+	k_sem_take(&free_channel_count, K_FOREVER);
+
+	for (uint32_t channel = 0;; channel = (channel + 1) % NOC_DMA_NUM_CHANNELS) {
+		if (atomic_test_and_clear_bit(&free_channels, channel)) {
+			return channel;
+		}
+	}
+}
+
+static void ReleaseChannel(uint32_t channel)
+{
+	atomic_set_bit(&free_channels, channel);
+	k_sem_give(&free_channel_count);
+}
+
+static void NocDmaCallback(const struct device *dev, void *user_data, uint32_t channel,
+			   int status)
+{
+	struct noc_dma_slot *slot = CONTAINER_OF(user_data, struct noc_dma_slot, coords);
+	struct noc_dma_batch *batch = slot->batch;
+
+	ARG_UNUSED(dev);
+
+	if (status == DMA_STATUS_BLOCK) {
+		return;
+	}
+
+	if (status < 0) {
+		batch->status = status;
+	}
+
+	if (atomic_test_and_clear_bit(&batch->channels, channel)) {
+		ReleaseChannel(channel);
+	}
+}
+
+static int NocDmaStart(struct noc_dma_batch *batch, uint32_t direction,
+		       struct tt_bh_dma_noc_coords coords, uint64_t source_address,
+		       uint64_t dest_address, size_t size)
+{
+	uint32_t channel = AcquireChannel();
+	struct noc_dma_slot *slot = &slots[channel];
+	int rc;
+
+	slot->coords = coords;
+	slot->batch = batch;
+
+	struct dma_block_config block = {
+		.source_address = source_address,
+		.dest_address = dest_address,
+		.block_size = size,
+	};
+
+	struct dma_config config = {
+		.channel_direction = direction,
+		.source_data_size = 1,
+		.dest_data_size = 1,
+		.source_burst_length = 1,
+		.dest_burst_length = 1,
+		.block_count = 1,
+		.head_block = &block,
+		.user_data = &slot->coords,
+		.dma_callback = NocDmaCallback,
+	};
+
+	/* In flight before it starts, as it may finish before dma_start() returns */
+	atomic_set_bit(&batch->channels, channel);
+
+	rc = dma_config(dma_noc, channel, &config);
+	if (rc == 0) {
+		rc = dma_start(dma_noc, channel);
+	}
+	if (rc < 0) {
+		LOG_ERR("%s() failed: %d", "dma_start", rc);
+		atomic_clear_bit(&batch->channels, channel);
+		ReleaseChannel(channel);
+		return rc;
+	}
+
+	return 0;
+}
+
+static int NocDmaWait(struct noc_dma_batch *batch)
+{
+	k_timepoint_t timeout = sys_timepoint_calc(K_MSEC(NOC_DMA_WAIT_TIMEOUT_MS));
+
+	/* Check the transaction counters from here rather than waiting for the driver's sysworkq
+	 * poll, which cannot run if this is the sysworkq. A finished or timed out channel calls
+	 * back from dma_get_status(). The driver times transfers out itself, so the backstop
+	 * only fires if that has gone wrong.
+	 */
+	while (atomic_get(&batch->channels) != 0) {
+		for (uint32_t channel = 0; channel < NOC_DMA_NUM_CHANNELS; channel++) {
+			struct dma_status status;
+
+			if (atomic_test_bit(&batch->channels, channel)) {
+				(void)dma_get_status(dma_noc, channel, &status);
+			}
+		}
+
+		if (atomic_get(&batch->channels) == 0) {
+			break;
+		}
+
+		if (sys_timepoint_expired(timeout)) {
+			for (uint32_t channel = 0; channel < NOC_DMA_NUM_CHANNELS; channel++) {
+				if (atomic_test_and_clear_bit(&batch->channels, channel)) {
+					LOG_ERR("NOC DMA channel %u timed out", channel);
+					dma_stop(dma_noc, channel);
+					ReleaseChannel(channel);
+				}
+			}
+			batch->status = -ETIMEDOUT;
+			break;
+		}
+
+		k_usleep(CONFIG_DMA_TT_BH_NOC_POLL_US);
+	}
+
+	return batch->status;
+}
+
+static void NocDmaBatchInit(struct noc_dma_batch *batch)
+{
+	atomic_clear(&batch->channels);
+	batch->status = 0;
+}
+
+int NocDmaCopy(uint8_t x, uint8_t y, uint64_t addr, const struct noc_dma_dest *dests,
+	       size_t num_dests, size_t size)
+{
+	struct noc_dma_batch batch;
+	int rc = 0;
+
+	NocDmaBatchInit(&batch);
+
+	for (size_t i = 0; i < num_dests && rc == 0; i++) {
+		rc = NocDmaStart(&batch, PERIPHERAL_TO_MEMORY,
+				 tt_bh_dma_noc_coords_init(x, y, dests[i].x, dests[i].y), addr,
+				 dests[i].addr, size);
+	}
+
+	int wait_rc = NocDmaWait(&batch);
+
+	return rc < 0 ? rc : wait_rc;
+}
+
+int NocDmaRead(uint8_t x, uint8_t y, uint64_t addr, const struct noc_dma_dest *src, size_t size)
+{
+	struct noc_dma_batch batch;
+	int rc;
+
+	NocDmaBatchInit(&batch);
+
+	rc = NocDmaStart(&batch, MEMORY_TO_PERIPHERAL,
+			 tt_bh_dma_noc_coords_init(x, y, src->x, src->y), addr, src->addr, size);
+
+	int wait_rc = NocDmaWait(&batch);
+
+	return rc < 0 ? rc : wait_rc;
+}
+
+int NocDmaBroadcastTensix(uint8_t x, uint8_t y, uint64_t addr, size_t size)
+{
+	struct noc_dma_batch batch;
+	uint8_t x_start, y_start, x_end, y_end;
+	int rc;
+
+	NocDmaBatchInit(&batch);
+	GetEnabledTensixRange(&x_start, &y_start, &x_end, &y_end);
+
+	struct tt_bh_dma_noc_coords coords =
+		tt_bh_dma_noc_coords_init_multicast(x, y, x_start, y_start, x_end, y_end, 0);
+
+	rc = NocDmaStart(&batch, TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST, coords, addr, addr,
+			 size);
+
+	int wait_rc = NocDmaWait(&batch);
+
+	return rc < 0 ? rc : wait_rc;
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef NOC_DMA_H
+#define NOC_DMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* NOC 0 coordinates and address of one end of a NOC DMA copy */
+struct noc_dma_dest {
+	uint8_t x;
+	uint8_t y;
+	uint64_t addr;
+};
+
+/* Copy size bytes from addr on tile (x, y) to every destination. Copies are spread over the free
+ * NOC DMA channels, and the call returns once all of them have landed.
+ */
+int NocDmaCopy(uint8_t x, uint8_t y, uint64_t addr, const struct noc_dma_dest *dests,
+	       size_t num_dests, size_t size);
+
+/* Make tile (x, y) read size bytes from src into addr, and wait for the data to land */
+int NocDmaRead(uint8_t x, uint8_t y, uint64_t addr, const struct noc_dma_dest *src, size_t size);
+
+/* Multicast size bytes from addr on Tensix (x, y) to the same address on every enabled Tensix */
+int NocDmaBroadcastTensix(uint8_t x, uint8_t y, uint64_t addr, size_t size);
+
+#endif
@@ -49,7 +49,7 @@
 #define STREAM_PERF_CONFIG_REG_INDEX 35
 #define CLOCK_GATING_EN              0
 
-static const uint8_t kTlbIndex;
+static const uint8_t kTlbIndex = 7;
 
 static const uint32_t kFirstCfgRegIndex = 0x100 / sizeof(uint32_t);
 
@@ -753,3 +753,35 @@ void GetEnabledTensix(uint8_t *x, uint8_t *y)
 	}
 	*y = 2;
 }
+
+void GetEnabledTensixRange(uint8_t *x_start, uint8_t *y_start, uint8_t *x_end, uint8_t *y_end)
+{
+	uint32_t enabled_noc0_x = 0;
+
+	if (noc_translation_enabled) {
+		/* Enabled columns are packed into X=1-7, then X=10-16 */
+		unsigned int num_enabled = POPCOUNT(tile_enable.tensix_col_enabled);
+
+		enabled_noc0_x = GENMASK(MIN(num_enabled, 7), 1);
+		if (num_enabled > 7) {
+			enabled_noc0_x |= GENMASK(num_enabled + 2, 10);
+		}
+	} else {
+		for (unsigned int i = 0; i < ARRAY_SIZE(kTensixEthNoc0X); i++) {
+			if (IS_BIT_SET(tile_enable.tensix_col_enabled, i)) {
+				enabled_noc0_x |= BIT(kTensixEthNoc0X[i]);
+			}
+		}
+	}
+
+	uint32_t west = enabled_noc0_x & GENMASK(7, 1);
+	uint32_t east = enabled_noc0_x & GENMASK(16, 10);
+
+	/* Start in the east half and wrap around through GDDR column 0, so that the range never
+	 * covers the ARC column at X=8.
+	 */
+	*x_start = LOG2(LSB_GET(east != 0 ? east : west));
+	*x_end = LOG2(west != 0 ? west : east);
+	*y_start = 2;
+	*y_end = NOC_Y_SIZE - 1;
+}
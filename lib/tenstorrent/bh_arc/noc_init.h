@@ -23,4 +23,10 @@ void ClearNocTranslation(void);
  */
 void GetEnabledTensix(uint8_t *x, uint8_t *y);
 
+/* Returns the smallest NOC 0 multicast rectangle that covers every enabled Tensix and no ARC
+ * column, for the current translation. x_start is greater than x_end when the range wraps around
+ * the NOC edge. Harvested columns inside it are skipped by the router broadcast disables.
+ */
+void GetEnabledTensixRange(uint8_t *x_start, uint8_t *y_start, uint8_t *x_end, uint8_t *y_end);
+
 #endif
@@ -23,6 +23,7 @@
 #include <zephyr/drivers/dma.h>
 #include <zephyr/drivers/dma/dma_arc_hs.h>
 #include <zephyr/init.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/util.h>
 
@@ -45,7 +46,7 @@
 #define DBI_PCIE_TLB_ID                   62
 #define PCIE_NOC_TLB_DATA_REG_OFFSET2(ID) PCIE_SII_A_NOC_TLB_DATA_##ID##__REG_OFFSET
 #define PCIE_NOC_TLB_DATA_REG_OFFSET(ID)  PCIE_NOC_TLB_DATA_REG_OFFSET2(ID)
-#define DBI_ADDR                          ((uint64_t)DBI_PCIE_TLB_ID << 58)
+#define DBI_ADDR                          ((uint64_t)DBI_PCIE_TLB_ID << PCIE_OUTBOUND_ADDR_BITS)
 
 #define CMN_A_REG_MAP_BASE_ADDR         0xFFFFFFFFE1000000LL
 #define SERDES_SS_0_A_REG_MAP_BASE_ADDR 0xFFFFFFFFE0000000LL
@@ -176,7 +177,8 @@ bool ArcDmaTransfer(const void *src, void *dst, uint32_t len)
 	if (arc_dma_dev == NULL) {
 		return false;
 	}
-	return dma_arc_hs_transfer(arc_dma_dev, 0, src, dst, len, K_MSEC(500)) == 0;
+	return dma_arc_hs_transfer(arc_dma_dev, ARC_DMA_CHANNEL_PCIE, src, dst, len,
+				   K_MSEC(500)) == 0;
 }
 
 static inline void SetupDbiAccess(void)
@@ -411,6 +413,9 @@ static PCIeInitStatus PollForLinkUp(uint8_t pcie_inst)
 
 		ltssm_state.val = ReadSiiReg(PCIE_SII_A_LTSSM_STATE_REG_OFFSET);
 		training_done = ltssm_state.f.smlh_link_up_sync && ltssm_state.f.rdlh_link_up_sync;
+
+		/* Let other boot stages run while the link trains */
+		k_yield();
 	} while (!training_done && TimerTimestamp() < end_time);
 
 	if (!training_done) {
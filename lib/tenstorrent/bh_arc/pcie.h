@@ -26,6 +26,11 @@ typedef enum {
 #define PCIE_LOGICAL_Y       0
 #define PCIE_DBI_REG_TLB     14
 
+/* Width of the host address space reachable through the PCIe outbound window. The address bits
+ * above it select the outbound TLB settings.
+ */
+#define PCIE_OUTBOUND_ADDR_BITS 58
+
 static inline void WriteDbiReg(const uint32_t addr, const uint32_t data)
 {
 	const uint8_t noc_id = 0;
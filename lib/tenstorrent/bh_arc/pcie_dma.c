@@ -12,6 +12,7 @@
 
 #include "util.h"
 #include "pcie.h"
+#include "pcie_dma.h"
 
 #define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_STATUS_OFF_WRCH_0_REG_ADDR 0x00380080
 #define PCIE_DBI_USP_A_BH_PCIE_DWC_PCIE_USP_PF0_HDMA_CAP_HDMA_INT_SETUP_OFF_WRCH_0_REG_ADDR        \
@@ -106,14 +107,31 @@ typedef enum {
 	DMAStopped = 3
 } DMAStatus;
 
+/* Serialise the callers that share each channel between checking that it is idle and ringing
+ * its doorbell
+ */
+static struct k_spinlock hdma_wrch_lock;
+static struct k_spinlock hdma_rdch_lock;
+
+/* Whether len bytes at host_addr lie within the PCIe outbound window */
+bool PcieDmaHostRangeValid(uint64_t host_addr, uint64_t len)
+{
+	const uint64_t window = BIT64(PCIE_OUTBOUND_ADDR_BITS);
+
+	return host_addr != 0 && len <= window && host_addr <= window - len;
+}
+
 /* write transfer from the prespective of the chip. i.e., from chip to host */
 bool PcieDmaWriteTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t transfer_size_bytes,
 			  uint64_t msi_completion_addr, uint8_t completion_data)
 {
+	k_spinlock_key_t key = k_spin_lock(&hdma_wrch_lock);
+
 	/* reject dma request if there is a pending transaction */
 	uint32_t status = ReadDbiReg(HDMA_REG_ADDR(STATUS_OFF_WRCH_0));
 
 	if (status == DMARunning) {
+		k_spin_unlock(&hdma_wrch_lock, key);
 		return false;
 	}
 
@@ -142,6 +160,7 @@ bool PcieDmaWriteTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t trans
 	WriteDbiReg(HDMA_REG_ADDR(XFERSIZE_OFF_WRCH_0), transfer_size_bytes);
 	WriteDbiReg(HDMA_REG_ADDR(DOORBELL_OFF_WRCH_0), 0x1);
 
+	k_spin_unlock(&hdma_wrch_lock, key);
 	return true;
 }
 
@@ -149,10 +168,13 @@ bool PcieDmaWriteTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t trans
 bool PcieDmaReadTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t transfer_size_bytes,
 			 uint64_t msi_completion_addr, uint8_t completion_data)
 {
+	k_spinlock_key_t key = k_spin_lock(&hdma_rdch_lock);
+
 	/* reject dma request if there is a pending transaction */
 	uint32_t status = ReadDbiReg(HDMA_REG_ADDR(STATUS_OFF_RDCH_0));
 
 	if (status == DMARunning) {
+		k_spin_unlock(&hdma_rdch_lock, key);
 		return false;
 	}
 
@@ -181,6 +203,7 @@ bool PcieDmaReadTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t transf
 	WriteDbiReg(HDMA_REG_ADDR(XFERSIZE_OFF_RDCH_0), transfer_size_bytes);
 	WriteDbiReg(HDMA_REG_ADDR(DOORBELL_OFF_RDCH_0), 0x1);
 
+	k_spin_unlock(&hdma_rdch_lock, key);
 	return true;
 }
 
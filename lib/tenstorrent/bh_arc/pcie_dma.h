@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef PCIE_DMA_H
+#define PCIE_DMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+bool PcieDmaHostRangeValid(uint64_t host_addr, uint64_t len);
+bool PcieDmaWriteTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t transfer_size_bytes,
+			  uint64_t msi_completion_addr, uint8_t completion_data);
+bool PcieDmaReadTransfer(uint64_t chip_addr, uint64_t host_addr, uint32_t transfer_size_bytes,
+			 uint64_t msi_completion_addr, uint8_t completion_data);
+
+#endif
@@ -15,7 +15,7 @@
 
 LOG_MODULE_REGISTER(eth_serdes, CONFIG_TT_APP_LOG_LEVEL);
 
-#define SERDES_ETH_SETUP_TLB 0
+#define SERDES_ETH_SETUP_TLB 6
 
 static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
 
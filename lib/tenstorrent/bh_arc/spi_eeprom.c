@@ -20,6 +20,7 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/init.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/math_extras.h>
 
 #define SPI_PAGE_SIZE   256
 #define SECTOR_SIZE     4096
@@ -32,6 +33,12 @@
 
 LOG_MODULE_REGISTER(spi_eeprom, CONFIG_TT_APP_LOG_LEVEL);
 
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
 /* Temporary buffer to hold SPI page */
 static uint8_t spi_page_buf[SPI_BUFFER_SIZE];
 /* Global buffer for SPI programming */
@@ -41,7 +48,7 @@ static bool flash_locked = true;
 
 static const struct device *flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
 
-static void EepromSetup(void)
+STATIC void EepromSetup(void)
 {
 	/* Setup SPI buffer address */
 	WriteReg(RESET_UNIT_SCRATCH_RAM_REG_ADDR(10),
@@ -67,96 +74,198 @@ static int SpiBlockRead(uint32_t spi_address, uint32_t num_bytes, uint8_t *dest)
 	return rc;
 }
 
-/* automatically erases sectors and merges incoming data with existing data as needed */
-static int SpiSmartWrite(uint32_t address, const uint8_t *data, uint32_t num_bytes)
+/* NOR flash erases to all ones, and programming can only clear bits */
+#define SPI_ERASED_BYTE 0xFF
+/* Sectors classified before any of them is erased or written, enough to span a 64K block */
+#define SPI_DELTA_SECTORS 32
+
+/* Bitmask of the pages that differ in a range starting off bytes into a sector. Sets *erase if
+ * any byte sets a bit that old has cleared, which programming alone cannot do.
+ */
+STATIC uint32_t SpiDiffPages(uint32_t off, const uint8_t *old, const uint8_t *new, uint32_t len,
+			     bool *erase)
+{
+	uint32_t pages = 0;
+
+	while (len > 0) {
+		uint32_t n = MIN(ROUND_UP(off + 1, SPI_PAGE_SIZE) - off, len);
+
+		if (memcmp(old, new, n) != 0) {
+			pages |= BIT(off / SPI_PAGE_SIZE);
+			for (uint32_t i = 0; i < n && !*erase; i++) {
+				*erase = (new[i] & ~old[i]) != 0;
+			}
+		}
+		off += n;
+		old += n;
+		new += n;
+		len -= n;
+	}
+
+	return pages;
+}
+
+/* Bitmask of the pages of a sector that hold anything but erased bytes */
+static uint32_t SpiUsedPages(const uint8_t *buf, uint32_t sector_size)
+{
+	uint32_t pages = 0;
+
+	for (uint32_t off = 0; off < sector_size; off++) {
+		if (buf[off] != SPI_ERASED_BYTE) {
+			pages |= BIT(off / SPI_PAGE_SIZE);
+			off = ROUND_UP(off + 1, SPI_PAGE_SIZE) - 1;
+		}
+	}
+
+	return pages;
+}
+
+/* Program the pages of a sector set in pages, merging runs of adjacent pages into one write */
+static int SpiProgramPages(uint32_t addr, const uint8_t *buf, uint32_t pages)
+{
+	while (pages != 0) {
+		uint32_t first = u32_count_trailing_zeros(pages);
+		uint32_t count = u32_count_trailing_zeros(~(pages >> first));
+		uint32_t off = first * SPI_PAGE_SIZE;
+		int rc;
+
+		rc = flash_write(flash, addr + off, buf + off, count * SPI_PAGE_SIZE);
+		if (rc < 0) {
+			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash write", "", addr + off, rc);
+			return rc;
+		}
+		pages &= ~GENMASK(first + count - 1, first);
+	}
+
+	return 0;
+}
+
+/* Write len bytes at off into the sector at addr, keeping the rest of the sector */
+static int SpiWritePartialSector(uint32_t addr, uint32_t off, const uint8_t *data, uint32_t len)
 {
 	uint32_t sector_size = page_info.size;
-	uint32_t addr = ROUND_DOWN(address, sector_size);
-	uint32_t chunk_size;
+	uint32_t pages;
+	bool erase = false;
 	int rc;
 
-	__ASSERT(sector_size > sizeof(spi_page_buf), "Sector size is larger than temp buffer");
-	sys_trace_named_event("spiwrite", address, num_bytes);
-
-	/* Phase 1: Write first chunk (may be unaligned)*/
-	chunk_size = MIN((ROUND_UP((address + 1), sector_size) - address), num_bytes);
 	rc = flash_read(flash, addr, spi_page_buf, sector_size);
 	if (rc < 0) {
-		LOG_ERR("%s failed %sat 0x%08x: %d", "Flash read", "[phase 1] ", addr, rc);
+		LOG_ERR("%s failed %sat 0x%08x: %d", "Flash read", "[partial] ", addr, rc);
 		return rc;
 	}
-	if (memcmp(&spi_page_buf[address - addr], data, chunk_size) != 0) {
-		/* Write this block */
-		memcpy(&spi_page_buf[address - addr], data, chunk_size);
+
+	pages = SpiDiffPages(off, &spi_page_buf[off], data, len, &erase);
+	if (pages == 0) {
+		return 0;
+	}
+
+	memcpy(&spi_page_buf[off], data, len);
+	if (erase) {
 		rc = flash_erase(flash, addr, sector_size);
 		if (rc < 0) {
-			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash erase", "[phase 1] ", addr, rc);
+			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash erase", "[partial] ", addr, rc);
 			return rc;
 		}
-		rc = flash_write(flash, addr, spi_page_buf, sector_size);
+		pages = SpiUsedPages(spi_page_buf, sector_size);
+	}
+
+	return SpiProgramPages(addr, spi_page_buf, pages);
+}
+
+/* Write num_sectors whole sectors. All of them are compared against flash first, so that
+ * adjacent sectors that need an erase can be erased together, which lets the flash driver use
+ * 32K and 64K block erases. Host writes come from spi_global_buffer, which holds one sector, so
+ * only callers of SpiSmartWrite with larger buffers get to merge erases.
+ */
+STATIC int SpiWriteSectors(uint32_t addr, const uint8_t *data, uint32_t num_sectors)
+{
+	uint32_t sector_size = page_info.size;
+	uint32_t dirty_pages[SPI_DELTA_SECTORS];
+	uint32_t erase_map = 0;
+	int rc;
+
+	__ASSERT_NO_MSG(num_sectors <= SPI_DELTA_SECTORS);
+
+	for (uint32_t i = 0; i < num_sectors; i++) {
+		const uint8_t *sector_data = data + i * sector_size;
+		bool erase = false;
+
+		rc = flash_read(flash, addr + i * sector_size, spi_page_buf, sector_size);
 		if (rc < 0) {
-			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash write", "[phase 1] ", addr, rc);
+			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash read", "",
+				addr + i * sector_size, rc);
 			return rc;
 		}
+
+		dirty_pages[i] = SpiDiffPages(0, spi_page_buf, sector_data, sector_size, &erase);
+		if (erase) {
+			erase_map |= BIT(i);
+			dirty_pages[i] = SpiUsedPages(sector_data, sector_size);
+		}
 	}
-	addr += sector_size;
-	data += chunk_size;
-	num_bytes -= chunk_size;
 
-	/* Phase 2: Write aligned data  */
-	while (num_bytes > sector_size) {
+	while (erase_map != 0) {
+		uint32_t first = u32_count_trailing_zeros(erase_map);
+		uint32_t count = u32_count_trailing_zeros(~(erase_map >> first));
+		uint32_t erase_addr = addr + first * sector_size;
 
-		rc = flash_read(flash, addr, spi_page_buf, sector_size);
+		rc = flash_erase(flash, erase_addr, count * sector_size);
 		if (rc < 0) {
-			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash read", "[phase 2] ", addr, rc);
+			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash erase", "", erase_addr, rc);
 			return rc;
 		}
-		if (memcmp(spi_page_buf, data, MIN(sector_size, sizeof(spi_page_buf))) != 0) {
-			/* Write this block */
-			rc = flash_erase(flash, addr, sector_size);
-			if (rc < 0) {
-				LOG_ERR("%s failed %sat 0x%08x: %d", "Flash erase", "[phase 2] ",
-					addr, rc);
-				return rc;
-			}
-			rc = flash_write(flash, addr, data, sector_size);
-			if (rc < 0) {
-				LOG_ERR("%s failed %sat 0x%08x: %d", "Flash write", "[phase 2] ",
-					addr, rc);
-				return rc;
-			}
-		}
-		addr += sector_size;
-		data += sector_size;
-		num_bytes -= sector_size;
+		erase_map &= ~GENMASK(first + count - 1, first);
 	}
 
-	if (num_bytes == 0) {
-		/* No need for phase 3 */
-		return 0;
-	}
+	for (uint32_t i = 0; i < num_sectors; i++) {
+		uint32_t offset = i * sector_size;
 
-	/* Phase 3: Write last chunk (may be unaligned) */
-	chunk_size = num_bytes;
-	rc = flash_read(flash, addr, spi_page_buf, sector_size);
-	if (rc < 0) {
-		LOG_ERR("%s failed %sat 0x%08x: %d", "Flash read", "[phase 3] ", addr, rc);
-		return rc;
-	}
-	if (memcmp(spi_page_buf, data, chunk_size) != 0) {
-		/* Write this block */
-		memcpy(spi_page_buf, data, chunk_size);
-		rc = flash_erase(flash, addr, sector_size);
+		rc = SpiProgramPages(addr + offset, data + offset, dirty_pages[i]);
 		if (rc < 0) {
-			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash erase", "[phase 3] ", addr, rc);
 			return rc;
 		}
-		rc = flash_write(flash, addr, spi_page_buf, sector_size);
+	}
+
+	return 0;
+}
+
+/* Merges incoming data with existing data, erasing and programming only what changed. Sectors
+ * are only erased when the new data sets bits that are clear in flash, and only the pages that
+ * differ are programmed.
+ */
+STATIC int SpiSmartWrite(uint32_t address, const uint8_t *data, uint32_t num_bytes)
+{
+	uint32_t sector_size = page_info.size;
+	uint32_t delta_size = SPI_DELTA_SECTORS * sector_size;
+	int rc;
+
+	__ASSERT(sector_size <= sizeof(spi_page_buf), "Sector size is larger than temp buffer");
+	__ASSERT(sector_size / SPI_PAGE_SIZE <= 32, "Too many pages per sector");
+	sys_trace_named_event("spiwrite", address, num_bytes);
+
+	while (num_bytes > 0) {
+		uint32_t addr = ROUND_DOWN(address, sector_size);
+		uint32_t len;
+
+		if (address != addr || num_bytes < sector_size) {
+			/* First or last sector, not completely overwritten */
+			len = MIN(sector_size - (address - addr), num_bytes);
+			rc = SpiWritePartialSector(addr, address - addr, data, len);
+		} else {
+			/* Whole sectors, up to a delta_size boundary so that no block is split */
+			len = MIN(ROUND_DOWN(num_bytes, sector_size),
+				  ROUND_UP(address + 1, delta_size) - address);
+			rc = SpiWriteSectors(address, data, len / sector_size);
+		}
 		if (rc < 0) {
-			LOG_ERR("%s failed %sat 0x%08x: %d", "Flash write", "[phase 3] ", addr, rc);
 			return rc;
 		}
+
+		address += len;
+		data += len;
+		num_bytes -= len;
 	}
+
 	return 0;
 }
 
@@ -168,7 +277,53 @@ static bool check_csm_region(uint32_t addr, uint32_t num_bytes)
 	       (addr + num_bytes) > ((uint32_t)spi_global_buffer + sizeof(spi_global_buffer));
 }
 
-static uint8_t read_eeprom_handler(const union request *request, struct response *response)
+/* SPI flash requests deferred to the message queue work queue, run in request order */
+struct spi_eeprom_request {
+	msgqueue_token_t token;
+	bool write;
+	uint32_t spi_address;
+	uint32_t num_bytes;
+	uint8_t *csm_addr;
+};
+
+K_MSGQ_DEFINE(spi_eeprom_msgq, sizeof(struct spi_eeprom_request), NUM_MSG_QUEUES * MSG_QUEUE_SIZE,
+	      4);
+
+static void spi_eeprom_work_handler(struct k_work *work)
+{
+	struct spi_eeprom_request req;
+	int rc;
+
+	while (k_msgq_get(&spi_eeprom_msgq, &req, K_NO_WAIT) == 0) {
+		if (req.write) {
+			rc = SpiSmartWrite(req.spi_address, req.csm_addr, req.num_bytes);
+			/* Even a failed write may have changed the boot filesystem */
+			tt_boot_fs_invalidate(flash);
+		} else {
+			rc = SpiBlockRead(req.spi_address, req.num_bytes, req.csm_addr);
+		}
+		/* Flash errors are reported as 1, like a flash that failed to initialize */
+		msgqueue_complete(req.token, NULL, (rc < 0) ? 1 : 0);
+	}
+}
+
+static K_WORK_DEFINE(spi_eeprom_work, spi_eeprom_work_handler);
+
+static int spi_eeprom_defer(const struct spi_eeprom_request *req)
+{
+	/* One slot per outstanding host request, so this can only fail on a bug */
+	if (k_msgq_put(&spi_eeprom_msgq, req, K_NO_WAIT) != 0) {
+		return 1;
+	}
+
+	msgqueue_submit_work(&spi_eeprom_work);
+
+	return -EINPROGRESS;
+}
+
+/* Reads are deferred as well, so that they stay ordered with respect to pending writes. */
+static int read_eeprom_handler(const union request *request, struct response *response,
+			       msgqueue_token_t token)
 {
 	uint8_t buffer_mem_type = BYTE_GET(request->data[0], 1);
 	uint32_t spi_address = request->data[1];
@@ -189,10 +344,17 @@ static uint8_t read_eeprom_handler(const union request *request, struct response
 		return 1;
 	}
 
-	return SpiBlockRead(spi_address, num_bytes, csm_addr);
+	return spi_eeprom_defer(&(struct spi_eeprom_request){
+		.token = token,
+		.write = false,
+		.spi_address = spi_address,
+		.num_bytes = num_bytes,
+		.csm_addr = csm_addr,
+	});
 }
 
-static uint8_t write_eeprom_handler(const union request *request, struct response *response)
+static int write_eeprom_handler(const union request *request, struct response *response,
+				msgqueue_token_t token)
 {
 	uint8_t buffer_mem_type = BYTE_GET(request->data[0], 1);
 	uint32_t spi_address = request->data[1];
@@ -218,7 +380,13 @@ static uint8_t write_eeprom_handler(const union request *request, struct respons
 		return 1;
 	}
 
-	return SpiSmartWrite(spi_address, csm_addr, num_bytes);
+	return spi_eeprom_defer(&(struct spi_eeprom_request){
+		.token = token,
+		.write = true,
+		.spi_address = spi_address,
+		.num_bytes = num_bytes,
+		.csm_addr = csm_addr,
+	});
 }
 
 /* Challenge message issued from tt-flash to confirm a firmware update. */
@@ -240,8 +408,8 @@ static uint8_t flash_unlock_handler(const union request *request, struct respons
 	return 0;
 }
 
-REGISTER_MESSAGE(TT_SMC_MSG_READ_EEPROM, read_eeprom_handler);
-REGISTER_MESSAGE(TT_SMC_MSG_WRITE_EEPROM, write_eeprom_handler);
+REGISTER_ASYNC_MESSAGE(TT_SMC_MSG_READ_EEPROM, read_eeprom_handler);
+REGISTER_ASYNC_MESSAGE(TT_SMC_MSG_WRITE_EEPROM, write_eeprom_handler);
 REGISTER_MESSAGE(TT_SMC_MSG_CONFIRM_FLASHED_SPI, confirm_flashed_spi_handler);
 REGISTER_MESSAGE(TT_SMC_MSG_FLASH_LOCK, flash_lock_handler);
 REGISTER_MESSAGE(TT_SMC_MSG_FLASH_UNLOCK, flash_unlock_handler);
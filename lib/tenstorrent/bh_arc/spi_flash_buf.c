@@ -6,6 +6,8 @@
 
 #include <stdlib.h>
 
+#include "init.h"
+
 #include <tenstorrent/spi_flash_buf.h>
 #include <tenstorrent/tt_boot_fs.h>
 #include <zephyr/drivers/flash.h>
@@ -16,11 +18,27 @@
 
 LOG_MODULE_REGISTER(spi_flash_buf, CONFIG_TT_APP_LOG_LEVEL);
 
+#define SPI_DMA_TIMEOUT_MS 500
+
 static const struct device *const arc_dma_dev = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(dma0));
 
-int spi_transfer_by_parts(const struct device *dev, size_t spi_address, size_t image_size,
-			  uint8_t *buf, size_t buf_size, uint8_t *tlb_dst,
-			  int (*cb)(uint8_t *src, uint8_t *dst, size_t len))
+static K_MUTEX_DEFINE(spi_dma_mutex);
+static K_SEM_DEFINE(spi_dma_done, 0, 1);
+static int spi_dma_status;
+
+/* Add the part of chunk [offset, offset + len) that lies within cksum_size to *cksum */
+static void spi_chunk_cksum(const uint8_t *chunk, size_t offset, size_t len, size_t cksum_size,
+			    uint32_t *cksum)
+{
+	if ((cksum != NULL) && (offset < cksum_size)) {
+		*cksum = tt_boot_fs_cksum(*cksum, chunk, MIN(len, cksum_size - offset));
+	}
+}
+
+static int transfer_by_parts(const struct device *dev, size_t spi_address, size_t image_size,
+			     uint8_t *buf, size_t buf_size, uint8_t *tlb_dst,
+			     int (*cb)(uint8_t *src, uint8_t *dst, size_t len), size_t cksum_size,
+			     uint32_t *cksum)
 {
 	if ((buf == NULL) || (buf_size == 0)) {
 		return -EINVAL;
@@ -41,6 +59,8 @@ int spi_transfer_by_parts(const struct device *dev, size_t spi_address, size_t i
 			break;
 		}
 
+		spi_chunk_cksum(buf, offset, len, cksum_size, cksum);
+
 		rc = cb(buf, tlb_dst + offset, len);
 		if (rc < 0) {
 			break;
@@ -49,18 +69,138 @@ int spi_transfer_by_parts(const struct device *dev, size_t spi_address, size_t i
 	return rc;
 }
 
+int spi_transfer_by_parts(const struct device *dev, size_t spi_address, size_t image_size,
+			  uint8_t *buf, size_t buf_size, uint8_t *tlb_dst,
+			  int (*cb)(uint8_t *src, uint8_t *dst, size_t len))
+{
+	return transfer_by_parts(dev, spi_address, image_size, buf, buf_size, tlb_dst, cb, 0,
+				 NULL);
+}
+
 static int arc_dma_transfer_wrapper(uint8_t *src, uint8_t *dst, size_t len)
 {
-	if (dma_arc_hs_transfer(arc_dma_dev, 0, src, dst, len, K_MSEC(500)) < 0) {
+	if (dma_arc_hs_transfer(arc_dma_dev, ARC_DMA_CHANNEL_SPI, src, dst, len,
+				K_MSEC(SPI_DMA_TIMEOUT_MS)) < 0) {
 		LOG_ERR("%s() failed: %d", "dma_arc_hs_transfer", -EIO);
 		return -EIO;
 	}
 	return 0;
 }
 
+static void spi_dma_callback(const struct device *dev, void *user_data, uint32_t channel,
+			     int status)
+{
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+	ARG_UNUSED(channel);
+
+	spi_dma_status = status;
+	k_sem_give(&spi_dma_done);
+}
+
+/* Start copying len bytes from src to dst. spi_dma_done is given once the copy has finished. */
+static int spi_dma_start(uint8_t *src, uint8_t *dst, size_t len)
+{
+	return dma_arc_hs_transfer_async(arc_dma_dev, ARC_DMA_CHANNEL_SPI, src, dst, len,
+					 spi_dma_callback, NULL);
+}
+
+static int spi_dma_wait(void)
+{
+	struct dma_status status;
+
+	/* By the time the next chunk has been read from SPI the copy has usually finished. Checking
+	 * the status runs the callback right away instead of waiting for the driver to notice.
+	 */
+	dma_get_status(arc_dma_dev, ARC_DMA_CHANNEL_SPI, &status);
+
+	if (k_sem_take(&spi_dma_done, K_MSEC(SPI_DMA_TIMEOUT_MS)) < 0) {
+		dma_stop(arc_dma_dev, ARC_DMA_CHANNEL_SPI);
+		return -ETIMEDOUT;
+	}
+	return spi_dma_status;
+}
+
+int spi_arc_dma_transfer_to_tile_cksum(const struct device *dev, size_t spi_address,
+				       size_t image_size, uint8_t *buf, size_t buf_size,
+				       uint8_t *tlb_dst, size_t cksum_size, uint32_t *cksum)
+{
+	if (cksum != NULL) {
+		*cksum = 0;
+	}
+
+	/* The two halves of buf take turns: SPI reads the next chunk into one half while ARC DMA
+	 * copies the previous chunk out of the other.
+	 */
+	size_t half_size = ROUND_DOWN(buf_size / 2, sizeof(uint32_t));
+
+	if ((arc_dma_dev == NULL) || (half_size == 0)) {
+		return transfer_by_parts(dev, spi_address, image_size, buf, buf_size, tlb_dst,
+					 arc_dma_transfer_wrapper, cksum_size, cksum);
+	}
+
+	if (buf == NULL) {
+		return -EINVAL;
+	}
+
+	if (image_size > (size_t)INT32_MAX) {
+		return -E2BIG;
+	}
+
+	int rc = 0;
+	bool dma_pending = false;
+
+	k_mutex_lock(&spi_dma_mutex, K_FOREVER);
+	k_sem_reset(&spi_dma_done);
+
+	for (size_t offset = 0, len; offset < image_size; offset += len) {
+		uint8_t *chunk = buf + ((offset / half_size) % 2) * half_size;
+
+		len = MIN(half_size, image_size - offset);
+
+		rc = flash_read(dev, spi_address + offset, chunk, len);
+		if (rc < 0) {
+			LOG_ERR("%s() failed: %d", "flash_read", rc);
+			break;
+		}
+
+		if (dma_pending) {
+			dma_pending = false;
+			rc = spi_dma_wait();
+			if (rc < 0) {
+				LOG_ERR("%s() failed: %d", "spi_dma_wait", rc);
+				break;
+			}
+		}
+
+		rc = spi_dma_start(chunk, tlb_dst + offset, len);
+		if (rc < 0) {
+			LOG_ERR("%s() failed: %d", "spi_dma_start", rc);
+			break;
+		}
+		dma_pending = true;
+
+		/* The DMA only reads the chunk, so it can be summed while it is being copied */
+		spi_chunk_cksum(chunk, offset, len, cksum_size, cksum);
+	}
+
+	if (dma_pending) {
+		int wait_rc = spi_dma_wait();
+
+		if (wait_rc < 0) {
+			LOG_ERR("%s() failed: %d", "spi_dma_wait", wait_rc);
+			rc = (rc < 0) ? rc : wait_rc;
+		}
+	}
+
+	k_mutex_unlock(&spi_dma_mutex);
+
+	return rc;
+}
+
 int spi_arc_dma_transfer_to_tile(const struct device *dev, size_t spi_address, size_t image_size,
 				 uint8_t *buf, size_t buf_size, uint8_t *tlb_dst)
 {
-	return spi_transfer_by_parts(dev, spi_address, image_size, buf, buf_size, tlb_dst,
-				     arc_dma_transfer_wrapper);
+	return spi_arc_dma_transfer_to_tile_cksum(dev, spi_address, image_size, buf, buf_size,
+						  tlb_dst, 0, NULL);
 }
@@ -13,11 +13,14 @@
 #include "regulator.h"
 #include "status_reg.h"
 #include "telemetry.h"
+#include "telemetry_history.h"
 #include "telemetry_internal.h"
+#include "telemetry_stream.h"
 #include "gddr.h"
 
 #include <float.h> /* for FLT_MAX */
 #include <math.h>  /* for floor */
+#include <stdatomic.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -60,8 +63,39 @@ struct telemetry_entry {
 	uint16_t offset;
 };
 
+/**
+ * @brief A consistent copy of the telemetry data.
+ */
+struct telemetry_snapshot {
+	/**
+	 * @brief The value of @ref telemetry_table::generation this snapshot was taken at.
+	 *
+	 * Written before @ref telemetry.
+	 */
+	uint32_t generation;
+
+	/**
+	 * @brief The telemetry data corresponding to the tags.
+	 */
+	uint32_t telemetry[TAG_COUNT];
+
+	/**
+	 * @brief Copy of @ref generation, written after @ref telemetry.
+	 */
+	uint32_t generation_end;
+};
+
 /**
  * @brief Represents the telemetry table containing telemetry data and metadata.
+ *
+ * Updates are prepared in a private buffer and then published here. Readers can get a consistent
+ * view in one of two ways:
+ * - Seqlock: read @ref generation, then @ref telemetry, then @ref generation again. The data is
+ *   consistent if both reads of the generation are equal and even.
+ * - Double buffer: in a single bulk read of the table, use
+ *   @ref snapshots[@ref snapshot_index]. The data is consistent if its generation and
+ *   generation_end are equal. The current snapshot is only rewritten one update interval after
+ *   it has been replaced, so a reader only has to retry if its read was delayed that long.
  */
 struct telemetry_table {
 	/**
@@ -83,6 +117,33 @@ struct telemetry_table {
 	 * @brief The telemetry data corresponding to the tags.
 	 */
 	uint32_t telemetry[TAG_COUNT];
+
+	/**
+	 * @brief Publication counter. Odd while @ref telemetry is being rewritten.
+	 */
+	uint32_t generation;
+
+	/**
+	 * @brief Index of the most recently published entry in @ref snapshots.
+	 */
+	uint32_t snapshot_index;
+
+	/**
+	 * @brief Double-buffered copies of @ref telemetry.
+	 */
+	struct telemetry_snapshot snapshots[2];
+
+	/**
+	 * @brief Uptime in milliseconds of the most recent publication.
+	 */
+	uint32_t publish_time;
+
+	/**
+	 * @brief Uptime in milliseconds at which each value in @ref telemetry was last refreshed,
+	 * or 0 for values that are only written at init. Comparing against @ref publish_time gives
+	 * the age of each value.
+	 */
+	uint32_t timestamp[TAG_COUNT];
 };
 
 /* Global variables */
@@ -162,19 +223,37 @@ static struct telemetry_table telemetry_table = {
 		[57] = {TAG_TDC_LIMIT_MAX, TELEM_OFFSET(TAG_TDC_LIMIT_MAX)},
 		[58] = {TAG_THM_LIMIT_THROTTLE, TELEM_OFFSET(TAG_THM_LIMIT_THROTTLE)},
 		[59] = {TAG_TDP_LIMIT_MAX, TELEM_OFFSET(TAG_TDP_LIMIT_MAX)},
+		[60] = {TAG_TELEM_HISTORY_ADDR, TELEM_OFFSET(TAG_TELEM_HISTORY_ADDR)},
 	},
 };
 
 /**
- * @brief Pointer to the telemetry data buffer.
+ * @brief Private working copy of the telemetry data.
  *
- * This buffer contains dynamically updated telemetry values. The address of this buffer
- * is published in the @ref TELEMETRY_DATA_REG_ADDR register.
+ * All updates go here and are copied to @ref telemetry_table by publish_telemetry(), so readers
+ * never see a partially updated value. The address of the published data,
+ * telemetry_table.telemetry, is written to the @ref TELEMETRY_DATA_REG_ADDR register.
  */
-static uint32_t *telemetry = &telemetry_table.telemetry[0];
+static uint32_t telemetry[TAG_COUNT];
+
+/**
+ * @brief Uptime in milliseconds at which each telemetry value was last refreshed.
+ *
+ * 0 for values that are only written once at init. Published in
+ * telemetry_table.timestamp alongside the data.
+ */
+static uint32_t telemetry_timestamp[TAG_COUNT];
 
 /** @} */ /* end of telemetry_table group */
 
+static struct k_spinlock telemetry_publish_lock;
+
+/* Serializes writers of the working telemetry: the periodic update on the system work queue and
+ * the setters at the end of this file, which are called from other threads. It is held across
+ * publish_telemetry(), so each publication copies a complete update.
+ */
+static K_MUTEX_DEFINE(telemetry_lock);
+
 static struct k_timer telem_update_timer;
 static struct k_work telem_update_worker;
 static int telem_update_interval = 100;
@@ -209,16 +288,62 @@ float ConvertTelemetryToFloat(int32_t value)
 	}
 }
 
-static void UpdateGddrTelemetry(void)
+/* Copy the working telemetry to the host-visible table. */
+static void publish_telemetry(void)
 {
-	/* We pack multiple metrics into one field, so need to clear first. */
-	for (int i = 0; i < NUM_GDDR / 2; i++) {
-		telemetry[TAG_GDDR_0_1_TEMP + i] = 0;
-		telemetry[TAG_GDDR_0_1_CORR_ERRS + i] = 0;
-	}
+	k_spinlock_key_t key = k_spin_lock(&telemetry_publish_lock);
+	uint32_t next = !telemetry_table.snapshot_index;
+	uint32_t generation = telemetry_table.generation + 2;
+
+	/* Fill the inactive snapshot between its two generation words, then make it current */
+	telemetry_table.snapshots[next].generation = generation;
+	atomic_thread_fence(memory_order_seq_cst);
+	memcpy(telemetry_table.snapshots[next].telemetry, telemetry, sizeof(telemetry));
+	atomic_thread_fence(memory_order_seq_cst);
+	telemetry_table.snapshots[next].generation_end = generation;
+	atomic_thread_fence(memory_order_seq_cst);
+	telemetry_table.snapshot_index = next;
+
+	/* Seqlock protected copy at the legacy location */
+	telemetry_table.generation = generation - 1;
+	atomic_thread_fence(memory_order_seq_cst);
+	memcpy(telemetry_table.telemetry, telemetry, sizeof(telemetry));
+	memcpy(telemetry_table.timestamp, telemetry_timestamp, sizeof(telemetry_timestamp));
+	telemetry_table.publish_time = k_uptime_get_32();
+	atomic_thread_fence(memory_order_seq_cst);
+	telemetry_table.generation = generation;
+
+	k_spin_unlock(&telemetry_publish_lock, key);
+}
+
+/**
+ * @brief Copy the most recently published telemetry and per-tag timestamps.
+ *
+ * @param data Destination for the TAG_COUNT telemetry values
+ * @param timestamp Destination for the TAG_COUNT refresh timestamps
+ *
+ * @return The publication generation the copy belongs to
+ */
+uint32_t CopyTelemetry(uint32_t *data, uint32_t *timestamp)
+{
+	k_spinlock_key_t key = k_spin_lock(&telemetry_publish_lock);
+	uint32_t generation = telemetry_table.generation;
+
+	memcpy(data, telemetry_table.telemetry, sizeof(telemetry_table.telemetry));
+	memcpy(timestamp, telemetry_table.timestamp, sizeof(telemetry_table.timestamp));
 
-	telemetry[TAG_GDDR_UNCORR_ERRS] = 0;
-	telemetry[TAG_GDDR_STATUS] = 0;
+	k_spin_unlock(&telemetry_publish_lock, key);
+
+	return generation;
+}
+
+static void UpdateGddrTelemetry(void)
+{
+	/* We pack multiple metrics into one field, so build them locally first. */
+	uint32_t gddr_temp[NUM_GDDR / 2] = {0};
+	uint32_t gddr_corr_errs[NUM_GDDR / 2] = {0};
+	uint32_t gddr_uncorr_errs = 0;
+	uint32_t gddr_status = 0;
 
 	for (int i = 0; i < NUM_GDDR; i++) {
 		gddr_telemetry_table_t gddr_telemetry;
@@ -238,9 +363,8 @@ static void UpdateGddrTelemetry(void)
 			 * [14] - Training Complete GDDR 7
 			 * [15] - Error GDDR 7
 			 */
-			telemetry[TAG_GDDR_STATUS] |=
-				(gddr_telemetry.training_complete << (i * 2)) |
-				(gddr_telemetry.gddr_error << (i * 2 + 1));
+			gddr_status |= (gddr_telemetry.training_complete << (i * 2)) |
+				       (gddr_telemetry.gddr_error << (i * 2 + 1));
 
 			/* DDR_x_y_TEMP:
 			 * [31:24] GDDR y top
@@ -250,7 +374,7 @@ static void UpdateGddrTelemetry(void)
 			 */
 			int shift_val = (i % 2) * 16;
 
-			telemetry[TAG_GDDR_0_1_TEMP + i / 2] |=
+			gddr_temp[i / 2] |=
 				((gddr_telemetry.dram_temperature_top & 0xff) << (8 + shift_val)) |
 				((gddr_telemetry.dram_temperature_bottom & 0xff) << shift_val);
 
@@ -260,7 +384,7 @@ static void UpdateGddrTelemetry(void)
 			 * [15:8]  GDDR x Corrected Write EDC errors
 			 * [7:0]   GDDR y Corrected Read EDC Errors
 			 */
-			telemetry[TAG_GDDR_0_1_CORR_ERRS + i / 2] |=
+			gddr_corr_errs[i / 2] |=
 				((gddr_telemetry.corr_edc_wr_errors & 0xff) << (8 + shift_val)) |
 				((gddr_telemetry.corr_edc_rd_errors & 0xff) << shift_val);
 
@@ -271,13 +395,19 @@ static void UpdateGddrTelemetry(void)
 			 * ...
 			 * [15] GDDR 7 Uncorrected Write EDC error
 			 */
-			telemetry[TAG_GDDR_UNCORR_ERRS] |=
-				(gddr_telemetry.uncorr_edc_rd_error << (i * 2)) |
-				(gddr_telemetry.uncorr_edc_wr_error << (i * 2 + 1));
+			gddr_uncorr_errs |= (gddr_telemetry.uncorr_edc_rd_error << (i * 2)) |
+					    (gddr_telemetry.uncorr_edc_wr_error << (i * 2 + 1));
 			/* GDDR speed - in Mbps */
 			telemetry[TAG_GDDR_SPEED] = gddr_telemetry.dram_speed;
 		}
 	}
+
+	for (int i = 0; i < NUM_GDDR / 2; i++) {
+		telemetry[TAG_GDDR_0_1_TEMP + i] = gddr_temp[i];
+		telemetry[TAG_GDDR_0_1_CORR_ERRS + i] = gddr_corr_errs[i];
+	}
+	telemetry[TAG_GDDR_UNCORR_ERRS] = gddr_uncorr_errs;
+	telemetry[TAG_GDDR_STATUS] = gddr_status;
 }
 
 int GetMaxGDDRTemp(void)
@@ -348,6 +478,7 @@ static void write_static_telemetry(uint32_t app_version)
 		tt_bh_fwtable_get_fw_table(fwtable_dev)->fw_bundle_version;
 	telemetry[TAG_CM_FW_VERSION] = app_version;
 	telemetry[TAG_L2CPU_FW_VERSION] = 0x00000000;
+	telemetry[TAG_TELEM_HISTORY_ADDR] = GetTelemetryHistoryAddr();
 
 	/* Tile enablement / harvesting information */
 	telemetry[TAG_ENABLED_TENSIX_COL] = tile_enable.tensix_col_enabled;
@@ -363,14 +494,12 @@ static void write_static_telemetry(uint32_t app_version)
 	telemetry[TAG_ASIC_LOCATION] = tt_bh_fwtable_get_asic_location(fwtable_dev);
 }
 
-static void update_telemetry(void)
+static void update_power_telemetry(void)
 {
-	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_START);
 	TelemetryInternalData telemetry_internal_data;
 
 	ReadTelemetryInternal(telem_update_interval, &telemetry_internal_data);
 
-	/* Get all dynamically updated values */
 	telemetry[TAG_VCORE] =
 		telemetry_internal_data
 			.vcore_voltage; /* reported in mV, will be truncated to uint32_t */
@@ -384,11 +513,20 @@ static void update_telemetry(void)
 		telemetry_internal_data.asic_temperature); /* ASIC temperature - reported in
 							    * signed int 16.16 format
 							    */
-	telemetry[TAG_VREG_TEMPERATURE] = 0x000000;        /* VREG temperature - need I2C line */
-	telemetry[TAG_BOARD_TEMPERATURE] = 0x000000;       /* Board temperature - need I2C line */
+	/* AICLK follows DVFS, so it is refreshed with the power values */
 	clock_control_get_rate(pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
 			       &telemetry[TAG_AICLK]);
 	/* first 16 bits - MAX ASIC FREQ (Not Available yet), lower 16 bits - current AICLK */
+	telemetry[TAG_FAN_SPEED] = GetFanSpeed(); /* Target fan speed - reported in percentage */
+	telemetry[TAG_INPUT_POWER] = GetInputPower(); /* Input power - reported in W */
+
+	UpdateTelemetryHistory();
+}
+
+static void update_clock_telemetry(void)
+{
+	telemetry[TAG_VREG_TEMPERATURE] = 0x000000;  /* VREG temperature - need I2C line */
+	telemetry[TAG_BOARD_TEMPERATURE] = 0x000000; /* Board temperature - need I2C line */
 
 	clock_control_get_rate(
 		pll_dev_1, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AXICLK,
@@ -425,12 +563,84 @@ static void update_telemetry(void)
 		0x00000000; /* ETH live status lower 16 bits: heartbeat status, upper 16 bits:
 			     * retrain_status - Not Available yet
 			     */
-	telemetry[TAG_FAN_SPEED] = GetFanSpeed(); /* Target fan speed - reported in percentage */
-	telemetry[TAG_FAN_RPM] = GetFanRPM();     /* Actual fan RPM */
+	telemetry[TAG_FAN_RPM] = GetFanRPM(); /* Actual fan RPM */
+}
+
+static void update_gddr_telemetry(void)
+{
 	UpdateGddrTelemetry();
 	telemetry[TAG_MAX_GDDR_TEMP] = GetMaxGDDRTemp();
-	telemetry[TAG_INPUT_POWER] = GetInputPower(); /* Input power - reported in W */
+}
+
+/* Tags refreshed together, at the same period */
+struct telemetry_update_group {
+	void (*update)(void);
+	uint32_t period_ms;
+	const uint8_t *tags;
+	uint8_t num_tags;
+};
+
+static const uint8_t power_tags[] = {
+	TAG_VCORE, TAG_TDP,       TAG_TDC,         TAG_ASIC_TEMPERATURE,
+	TAG_AICLK, TAG_FAN_SPEED, TAG_INPUT_POWER,
+};
+
+static const uint8_t clock_tags[] = {
+	TAG_VREG_TEMPERATURE, TAG_BOARD_TEMPERATURE, TAG_AXICLK,    TAG_ARCCLK,
+	TAG_L2CPUCLK0,        TAG_L2CPUCLK1,         TAG_L2CPUCLK2, TAG_L2CPUCLK3,
+	TAG_ETH_LIVE_STATUS,  TAG_FAN_RPM,
+};
+
+static const uint8_t gddr_tags[] = {
+	TAG_GDDR_STATUS,        TAG_GDDR_SPEED,         TAG_GDDR_0_1_TEMP,
+	TAG_GDDR_2_3_TEMP,      TAG_GDDR_4_5_TEMP,      TAG_GDDR_6_7_TEMP,
+	TAG_GDDR_0_1_CORR_ERRS, TAG_GDDR_2_3_CORR_ERRS, TAG_GDDR_4_5_CORR_ERRS,
+	TAG_GDDR_6_7_CORR_ERRS, TAG_GDDR_UNCORR_ERRS,   TAG_MAX_GDDR_TEMP,
+};
+
+static const struct telemetry_update_group telemetry_update_groups[] = {
+	{update_power_telemetry, 0, power_tags, ARRAY_SIZE(power_tags)},
+	{update_clock_telemetry, CONFIG_TT_BH_ARC_TELEMETRY_CLOCK_PERIOD_MS, clock_tags,
+	 ARRAY_SIZE(clock_tags)},
+	{update_gddr_telemetry, CONFIG_TT_BH_ARC_TELEMETRY_GDDR_PERIOD_MS, gddr_tags,
+	 ARRAY_SIZE(gddr_tags)},
+};
+
+static uint32_t telemetry_group_last_update[ARRAY_SIZE(telemetry_update_groups)];
+
+static void set_telemetry_timestamp(uint16_t tag, uint32_t now)
+{
+	telemetry_timestamp[tag] = now;
+}
+
+static void update_telemetry(bool all)
+{
+	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_START);
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
+	uint32_t now = k_uptime_get_32();
+
+	/* Refresh each group of dynamically updated values once its period has elapsed. The half
+	 * interval of slack keeps timer jitter from skipping a whole interval.
+	 */
+	for (size_t i = 0; i < ARRAY_SIZE(telemetry_update_groups); i++) {
+		const struct telemetry_update_group *group = &telemetry_update_groups[i];
+		uint32_t elapsed = now - telemetry_group_last_update[i] + telem_update_interval / 2;
+
+		if (!all && elapsed < group->period_ms) {
+			continue;
+		}
+
+		group->update();
+		for (size_t j = 0; j < group->num_tags; j++) {
+			set_telemetry_timestamp(group->tags[j], now);
+		}
+		telemetry_group_last_update[i] = now;
+	}
+
 	telemetry[TAG_TIMER_HEARTBEAT]++; /* Incremented every time the timer is called */
+	set_telemetry_timestamp(TAG_TIMER_HEARTBEAT, now);
+	publish_telemetry();
+	k_mutex_unlock(&telemetry_lock);
 	SetPostCode(POST_CODE_SRC_CMFW, POST_CODE_TELEMETRY_END);
 }
 
@@ -438,7 +648,8 @@ static void update_telemetry(void)
 static void telemetry_work_handler(struct k_work *work)
 {
 	/* Repeat fetching of dynamic telemetry values */
-	update_telemetry();
+	update_telemetry(false);
+	UpdateTelemetryStream();
 }
 static void telemetry_timer_handler(struct k_timer *timer)
 {
@@ -456,12 +667,14 @@ static K_TIMER_DEFINE(telem_update_timer, telemetry_timer_handler, NULL);
 
 void init_telemetry(uint32_t app_version)
 {
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
 	write_static_telemetry(app_version);
+	k_mutex_unlock(&telemetry_lock);
 	/* fill the dynamic values once before starting timed updates */
-	update_telemetry();
+	update_telemetry(true);
 
 	/* Publish the telemetry data pointer for readers in Scratch RAM */
-	WriteReg(TELEMETRY_DATA_REG_ADDR, (uint32_t)&telemetry[0]);
+	WriteReg(TELEMETRY_DATA_REG_ADDR, (uint32_t)&telemetry_table.telemetry[0]);
 	WriteReg(TELEMETRY_TABLE_REG_ADDR, (uint32_t)&telemetry_table);
 }
 
@@ -478,24 +691,43 @@ void StartTelemetryTimer(void)
 
 void UpdateDmFwVersion(uint32_t bl_version, uint32_t app_version)
 {
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
+	uint32_t now = k_uptime_get_32();
+
 	telemetry[TAG_DM_BL_FW_VERSION] = bl_version;
 	telemetry[TAG_DM_APP_FW_VERSION] = app_version;
+	set_telemetry_timestamp(TAG_DM_BL_FW_VERSION, now);
+	set_telemetry_timestamp(TAG_DM_APP_FW_VERSION, now);
+	publish_telemetry();
+	k_mutex_unlock(&telemetry_lock);
 }
 
 void UpdateTelemetryNocTranslation(bool translation_enabled)
 {
 	/* Note that this may be called before init_telemetry. */
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
 	telemetry[TAG_NOC_TRANSLATION] = translation_enabled;
+	set_telemetry_timestamp(TAG_NOC_TRANSLATION, k_uptime_get_32());
+	publish_telemetry();
+	k_mutex_unlock(&telemetry_lock);
 }
 
 void UpdateTelemetryBoardPowerLimit(uint32_t power_limit)
 {
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
 	telemetry[TAG_BOARD_POWER_LIMIT] = power_limit;
+	set_telemetry_timestamp(TAG_BOARD_POWER_LIMIT, k_uptime_get_32());
+	publish_telemetry();
+	k_mutex_unlock(&telemetry_lock);
 }
 
 void UpdateTelemetryThermTripCount(uint16_t therm_trip_count)
 {
+	k_mutex_lock(&telemetry_lock, K_FOREVER);
 	telemetry[TAG_THERM_TRIP_COUNT] = therm_trip_count;
+	set_telemetry_timestamp(TAG_THERM_TRIP_COUNT, k_uptime_get_32());
+	publish_telemetry();
+	k_mutex_unlock(&telemetry_lock);
 }
 
 bool GetTelemetryTagValid(uint16_t tag)
@@ -224,12 +224,15 @@
 /** @brief Maximum TDP limit in watts. */
 #define TAG_TDP_LIMIT_MAX 64
 
+/** @brief Address of the telemetry history ring in CSM, 0 if disabled. */
+#define TAG_TELEM_HISTORY_ADDR 65
+
 /** @} */ /* end of telemetry_tag group */
 
 /* Not a real tag, signifies the last tag in the list.
  * MUST be incremented if new tags are defined.
  */
-#define TAG_COUNT 65
+#define TAG_COUNT 66
 
 /* Telemetry tags are at offset `tag` in the telemetry buffer */
 #define TELEM_OFFSET(tag) (tag)
@@ -245,5 +248,6 @@ void UpdateTelemetryBoardPowerLimit(uint32_t power_limit);
 void UpdateTelemetryThermTripCount(uint16_t therm_trip_count);
 bool GetTelemetryTagValid(uint16_t tag);
 uint32_t GetTelemetryTag(uint16_t tag);
+uint32_t CopyTelemetry(uint32_t *data, uint32_t *timestamp);
 
 #endif
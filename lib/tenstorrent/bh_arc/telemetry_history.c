@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "cm2dm_msg.h"
+#include "telemetry_history.h"
+#include "telemetry_internal.h"
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/clock_control/clock_control_tt_bh.h>
+#include <zephyr/drivers/clock_control.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+#define NUM_SAMPLES CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_SAMPLES
+
+static const struct device *const pll_dev_0 = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(pll0));
+
+/*
+ * Ring of samples in CSM. Its address is published in the TAG_TELEM_HISTORY_ADDR telemetry tag.
+ *
+ * Sample n is stored at samples[n % num_samples] and count is incremented after each sample is
+ * written. A host that reads count (c0), then the samples, then count again (c1) has valid copies
+ * of samples max(c0, c1 + 1) - num_samples to c0 - 1.
+ */
+struct telemetry_history {
+	uint32_t version;
+	uint32_t sample_size;
+	uint32_t num_samples;
+	uint32_t period_ms;
+	uint32_t count;
+	struct telemetry_history_sample samples[NUM_SAMPLES];
+};
+
+static struct telemetry_history history = {
+	.version = TELEMETRY_HISTORY_VERSION,
+	.sample_size = sizeof(struct telemetry_history_sample),
+	.num_samples = NUM_SAMPLES,
+	.period_ms = CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_PERIOD_MS,
+};
+
+/* Keeps samples[count % num_samples] contiguous when count wraps */
+BUILD_ASSERT(IS_POWER_OF_TWO(NUM_SAMPLES), "history size must be a power of two");
+
+static uint32_t last_sample_time;
+
+STATIC void AppendTelemetryHistory(const struct telemetry_history_sample *sample)
+{
+	uint32_t count = history.count;
+
+	history.samples[count % NUM_SAMPLES] = *sample;
+	/* The sample must be visible before the count that covers it */
+	atomic_thread_fence(memory_order_seq_cst);
+	history.count = count + 1;
+}
+
+static uint16_t saturate_u16(float value)
+{
+	return CLAMP(value, 0.0f, (float)UINT16_MAX);
+}
+
+/**
+ * @brief Record a sample if the history period has elapsed since the last one.
+ *
+ * Called from the DVFS tick and from the telemetry update, which both run on the system work
+ * queue, so the DVFS rate bounds the resolution and samples continue when DVFS is disabled.
+ */
+void UpdateTelemetryHistory(void)
+{
+	uint32_t now = k_uptime_get_32();
+
+	if (history.count != 0 &&
+	    now - last_sample_time < CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_PERIOD_MS) {
+		return;
+	}
+	last_sample_time = now;
+
+	TelemetryInternalData data;
+	uint32_t aiclk = 0;
+
+	ReadTelemetryInternal(1, &data);
+	clock_control_get_rate(pll_dev_0, (clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK,
+			       &aiclk);
+
+	struct telemetry_history_sample sample = {
+		.timestamp = now,
+		.vcore = saturate_u16(data.vcore_voltage),
+		.tdp = saturate_u16(data.vcore_power),
+		.tdc = saturate_u16(data.vcore_current),
+		.asic_temperature = CLAMP(data.asic_temperature * 256.0f, INT16_MIN, INT16_MAX),
+		.aiclk = MIN(aiclk, UINT16_MAX),
+		.input_power = GetInputPower(),
+	};
+
+	AppendTelemetryHistory(&sample);
+}
+
+uint32_t GetTelemetryHistoryAddr(void)
+{
+	return (uint32_t)(uintptr_t)&history;
+}
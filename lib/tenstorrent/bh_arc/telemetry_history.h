@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TELEMETRY_HISTORY_H
+#define TELEMETRY_HISTORY_H
+
+#include <stdint.h>
+
+#define TELEMETRY_HISTORY_VERSION 1
+
+/* One sample of the power and thermal values, 16 bytes */
+struct telemetry_history_sample {
+	uint32_t timestamp;       /* uptime in ms */
+	uint16_t vcore;           /* mV */
+	uint16_t tdp;             /* W */
+	uint16_t tdc;             /* A */
+	int16_t asic_temperature; /* degC, signed 8.8 fixed point */
+	uint16_t aiclk;           /* MHz */
+	uint16_t input_power;     /* W */
+};
+
+#ifdef CONFIG_TT_BH_ARC_TELEMETRY_HISTORY
+void UpdateTelemetryHistory(void);
+uint32_t GetTelemetryHistoryAddr(void);
+#else
+static inline void UpdateTelemetryHistory(void)
+{
+}
+static inline uint32_t GetTelemetryHistoryAddr(void)
+{
+	return 0;
+}
+#endif
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "pcie_dma.h"
+#include "telemetry.h"
+#include "telemetry_stream.h"
+#include "util.h"
+
+#include <stdint.h>
+
+#include <tenstorrent/msgqueue.h>
+#include <tenstorrent/smc_msg.h>
+#include <zephyr/kernel.h>
+
+#define TELEMETRY_STREAM_VERSION 1
+
+/**
+ * @brief Telemetry block copied to the host buffer on every stream transfer.
+ *
+ * The MSI written after each transfer carries the low 8 bits of @ref sequence.
+ */
+struct telemetry_stream_block {
+	/** @brief Layout version, TELEMETRY_STREAM_VERSION */
+	uint32_t version;
+	/** @brief Transfer number, starting from 0 when streaming is (re)started */
+	uint32_t sequence;
+	/** @brief Telemetry publication generation the data was copied from */
+	uint32_t generation;
+	/** @brief Uptime in ms when the data was copied */
+	uint32_t timestamp;
+	/** @brief Transfers skipped because the DMA write channel was busy */
+	uint32_t dropped;
+	/** @brief Number of entries in @ref telemetry and @ref tag_timestamp */
+	uint32_t num_tags;
+	/** @brief Telemetry values, indexed by tag */
+	uint32_t telemetry[TAG_COUNT];
+	/** @brief Uptime in ms at which each value was last refreshed */
+	uint32_t tag_timestamp[TAG_COUNT];
+};
+
+static struct {
+	uint64_t host_addr;
+	uint64_t msi_addr;
+	uint32_t period_ms;
+	uint32_t last_transfer;
+	uint32_t sequence;
+	uint32_t dropped;
+} stream;
+
+static struct k_spinlock stream_lock;
+
+/* A transfer may still be reading one block while the next is prepared in the other */
+static struct telemetry_stream_block blocks[2];
+
+/**
+ * @brief Push the telemetry block to the registered host buffer if the stream period has elapsed.
+ *
+ * Called from the telemetry update work after each publication.
+ */
+void UpdateTelemetryStream(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stream_lock);
+	uint32_t now = k_uptime_get_32();
+	uint32_t update_interval = GetTelemetryTag(TAG_UPDATE_TELEM_SPEED);
+
+	/* Allow half an update interval of slack so that jitter does not skip an interval */
+	if (stream.period_ms == 0 ||
+	    now - stream.last_transfer + update_interval / 2 < stream.period_ms) {
+		k_spin_unlock(&stream_lock, key);
+		return;
+	}
+	stream.last_transfer = now;
+
+	struct telemetry_stream_block *block = &blocks[stream.sequence % ARRAY_SIZE(blocks)];
+
+	block->version = TELEMETRY_STREAM_VERSION;
+	block->sequence = stream.sequence;
+	block->generation = CopyTelemetry(block->telemetry, block->tag_timestamp);
+	block->timestamp = now;
+	block->dropped = stream.dropped;
+	block->num_tags = TAG_COUNT;
+
+	if (PcieDmaWriteTransfer((uintptr_t)block, stream.host_addr, sizeof(*block),
+				 stream.msi_addr, stream.sequence & 0xFF)) {
+		stream.sequence++;
+	} else {
+		stream.dropped++;
+	}
+
+	k_spin_unlock(&stream_lock, key);
+}
+
+/**
+ * @brief Handler for @ref TT_SMC_MSG_TELEMETRY_STREAM messages
+ *
+ * @details Registers a host buffer that the telemetry block is pushed to every
+ *          @ref telemetry_stream_rqst::period_ms, or stops streaming if the period is 0.
+ *          Restarting the stream resets the sequence number.
+ *
+ * @param request Pointer to the host request message to be processed
+ * @param response Pointer to the response message to be sent back to host. data[1] is set to
+ *                 the size of the telemetry block in bytes.
+ *
+ * @return 0 on success, EINVAL if the host buffer is too small, or if it or the MSI address is
+ *         not a valid host address in the PCIe outbound window
+ *
+ * @see telemetry_stream_rqst
+ */
+static uint8_t telemetry_stream_handler(const union request *request, struct response *response)
+{
+	const struct telemetry_stream_rqst *rqst = &request->telemetry_stream;
+	uint64_t host_addr = ((uint64_t)rqst->host_addr_hi << 32) | rqst->host_addr_lo;
+	uint64_t msi_addr = ((uint64_t)rqst->msi_addr_hi << 32) | rqst->msi_addr_lo;
+
+	response->data[1] = sizeof(struct telemetry_stream_block);
+
+	/* The MSI data goes to msi_addr on completion and to the next word on abort */
+	if (rqst->period_ms != 0 &&
+	    (rqst->buffer_size < sizeof(struct telemetry_stream_block) ||
+	     !PcieDmaHostRangeValid(host_addr, sizeof(struct telemetry_stream_block)) ||
+	     !IS_ALIGNED(msi_addr, sizeof(uint32_t)) ||
+	     !PcieDmaHostRangeValid(msi_addr, 2 * sizeof(uint32_t)))) {
+		return EINVAL;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&stream_lock);
+
+	stream.host_addr = host_addr;
+	stream.msi_addr = msi_addr;
+	stream.period_ms = rqst->period_ms;
+	/* Send the first block on the next telemetry update */
+	stream.last_transfer = k_uptime_get_32() - rqst->period_ms;
+	stream.sequence = 0;
+	stream.dropped = 0;
+
+	k_spin_unlock(&stream_lock, key);
+
+	return 0;
+}
+
+REGISTER_MESSAGE(TT_SMC_MSG_TELEMETRY_STREAM, telemetry_stream_handler);
@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef TELEMETRY_STREAM_H
+#define TELEMETRY_STREAM_H
+
+#ifdef CONFIG_TT_BH_ARC_TELEMETRY_STREAM
+void UpdateTelemetryStream(void);
+#else
+static inline void UpdateTelemetryStream(void)
+{
+}
+#endif
+
+#endif
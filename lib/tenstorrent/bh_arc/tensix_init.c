@@ -5,6 +5,7 @@
  */
 
 #include "noc2axi.h"
+#include "noc_dma.h"
 #include "noc_init.h"
 
 #include <stdint.h>
@@ -12,8 +13,6 @@
 #include <tenstorrent/post_code.h>
 #include <tenstorrent/sys_init_defines.h>
 #include <zephyr/drivers/misc/bh_fwtable.h>
-#include <zephyr/drivers/dma.h>
-#include <zephyr/drivers/dma/dma_tt_bh_noc.h>
 #include <zephyr/init.h>
 
 #define ARC_NOC0_X 8
@@ -21,8 +20,9 @@
 
 #define TENSIX_L1_SIZE (1536 * 1024)
 
+#define TENSIX_CG_TLB 6
+
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
-static const struct device *const dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 
 /* Enable CG_CTRL_EN in each non-harvested Tensix node and set CG hystersis to 2. */
 /* This requires NOC init so that broadcast is set up properly. */
@@ -49,7 +49,7 @@ static const struct device *const dma_noc = DEVICE_DT_GET(DT_NODELABEL(dma1));
 static void EnableTensixCG(void)
 {
 	uint8_t ring = 0;
-	uint8_t noc_tlb = 0;
+	uint8_t noc_tlb = TENSIX_CG_TLB;
 
 	/* CG hysteresis for the blocks. (Some share a field.) */
 	/* Set them all to 2. */
@@ -91,55 +91,32 @@ static void wipe_l1(void)
 	/* wipe SCRATCHPAD_SIZE of the chosen tensix */
 	memset(sram_buffer, 0, sizeof(sram_buffer));
 
-	struct tt_bh_dma_noc_coords coords =
-		tt_bh_dma_noc_coords_init(tensix_x, tensix_y, ARC_NOC0_X, ARC_NOC0_Y);
-
-	struct dma_block_config block = {
-		.source_address = addr,
-		.dest_address = (uintptr_t)sram_buffer,
-		.block_size = sizeof(sram_buffer),
-	};
-
-	struct dma_config config = {
-		.channel_direction = MEMORY_TO_PERIPHERAL,
-		.source_data_size = 1,
-		.dest_data_size = 1,
-		.source_burst_length = 1,
-		.dest_burst_length = 1,
-		.block_count = 1,
-		.head_block = &block,
-		.user_data = &coords,
+	const struct noc_dma_dest arc_buffer = {
+		.x = ARC_NOC0_X,
+		.y = ARC_NOC0_Y,
+		.addr = (uintptr_t)sram_buffer,
 	};
 
-	dma_config(dma_noc, 1, &config);
-	dma_start(dma_noc, 1);
+	NocDmaRead(tensix_x, tensix_y, addr, &arc_buffer, sizeof(sram_buffer));
 
-	/* wipe entire L1 of the chosen tensix */
+	/* wipe entire L1 of the chosen tensix, each copy reading what the previous ones zeroed */
 	uint32_t offset = sizeof(sram_buffer);
 
 	while (offset < TENSIX_L1_SIZE) {
 		uint32_t size = MIN(offset, TENSIX_L1_SIZE - offset);
+		const struct noc_dma_dest dest = {
+			.x = tensix_x,
+			.y = tensix_y,
+			.addr = offset,
+		};
 
-		config.channel_direction = PERIPHERAL_TO_MEMORY;
-		coords.dest_x = tensix_x;
-		coords.dest_y = tensix_y;
-		block.dest_address = offset;
-		block.block_size = size;
-
-		dma_config(dma_noc, 1, &config);
-		dma_start(dma_noc, 1);
+		NocDmaCopy(tensix_x, tensix_y, addr, &dest, 1, size);
 
 		offset += offset;
 	}
 
 	/* clear all remaining tensix L1 using the already-cleared L1 as a source */
-	config.channel_direction = TT_BH_DMA_NOC_CHANNEL_DIRECTION_BROADCAST;
-	block.source_address = addr;
-	block.dest_address = addr;
-	block.block_size = TENSIX_L1_SIZE;
-
-	dma_config(dma_noc, 1, &config);
-	dma_start(dma_noc, 1);
+	NocDmaBroadcastTensix(tensix_x, tensix_y, addr, TENSIX_L1_SIZE);
 }
 
 void TensixInit(void)
@@ -11,12 +11,19 @@
 #include "throttler.h"
 #include "aiclk_ppm.h"
 #include "cm2dm_msg.h"
+#include "dvfs.h"
 #include <zephyr/drivers/misc/bh_fwtable.h>
 #include "telemetry_internal.h"
 #include "telemetry.h"
 #include "noc2axi.h"
 #include "tensix_state_msg.h"
 
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
+
 static uint32_t power_limit;
 
 static bool doppler;
@@ -25,24 +32,13 @@ static bool doppler_t2;
 static bool doppler_t3;
 static const bool thermal_throttling = true;
 
-#define kThrottlerAiclkScaleFactor 500.0F
+#define kThrottlerAiclkScaleFactor DVFS_NUM(500)
 #define DEFAULT_BOARD_POWER_LIMIT  150
 
 LOG_MODULE_REGISTER(throttler);
 
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
 
-typedef enum {
-	kThrottlerTDP,
-	kThrottlerFastTDC,
-	kThrottlerTDC,
-	kThrottlerThm,
-	kThrottlerBoardPower,
-	kThrottlerGDDRThm,
-	kThrottlerDopplerSlow,
-	kThrottlerCount,
-} ThrottlerId;
-
 typedef struct {
 	float min;
 	float max;
@@ -63,20 +59,21 @@ static const ThrottlerLimitRange throttler_limit_ranges[kThrottlerCount] = {
 /* clang-format on */
 
 typedef struct {
-	float alpha_filter;
-	float p_gain;
-	float d_gain;
+	dvfs_num_t alpha_filter;
+	dvfs_num_t p_gain;
+	dvfs_num_t d_gain;
 } ThrottlerParams;
 
 typedef struct {
 	const AiclkArbMax arb_max; /* The arbiter associated with this throttler */
 
 	const ThrottlerParams params;
-	float limit;
-	float value;
-	float error;
-	float prev_error;
-	float output;
+	dvfs_num_t limit;
+	dvfs_recip_t limit_recip; /* 1 / limit, so that the tick does not divide */
+	dvfs_num_t value;
+	dvfs_num_t error;
+	dvfs_num_t prev_error;
+	dvfs_num_t output;
 } Throttler;
 
 /* clang-format off */
@@ -84,69 +81,70 @@ static Throttler throttler[kThrottlerCount] = {
 	[kThrottlerTDP] = {
 			.arb_max = kAiclkArbMaxTDP,
 			.params = {
-					.alpha_filter = 1.0,
-					.p_gain = 0.2,
-					.d_gain = 0,
+					.alpha_filter = DVFS_NUM(1.0),
+					.p_gain = DVFS_NUM(0.2),
+					.d_gain = DVFS_NUM(0),
 				},
 		},
 	[kThrottlerFastTDC] = {
 			.arb_max = kAiclkArbMaxFastTDC,
 			.params = {
-					.alpha_filter = 1.0,
-					.p_gain = 0.5,
-					.d_gain = 0,
+					.alpha_filter = DVFS_NUM(1.0),
+					.p_gain = DVFS_NUM(0.5),
+					.d_gain = DVFS_NUM(0),
 				},
 		},
 	[kThrottlerTDC] = {
 			.arb_max = kAiclkArbMaxTDC,
 			.params = {
-					.alpha_filter = 0.1,
-					.p_gain = 0.2,
-					.d_gain = 0,
+					.alpha_filter = DVFS_NUM(0.1),
+					.p_gain = DVFS_NUM(0.2),
+					.d_gain = DVFS_NUM(0),
 				},
 		},
 	[kThrottlerThm] = {
 			.arb_max = kAiclkArbMaxThm,
 			.params = {
-					.alpha_filter = 1.0,
-					.p_gain = 0.2,
-					.d_gain = 0,
+					.alpha_filter = DVFS_NUM(1.0),
+					.p_gain = DVFS_NUM(0.2),
+					.d_gain = DVFS_NUM(0),
 				},
 		},
 	[kThrottlerBoardPower] = {
 			.arb_max = kAiclkArbMaxBoardPower,
 			.params = {
-					.alpha_filter = 1.0,
-					.p_gain = 0.1,
-					.d_gain = 0.1,
+					.alpha_filter = DVFS_NUM(1.0),
+					.p_gain = DVFS_NUM(0.1),
+					.d_gain = DVFS_NUM(0.1),
 				},
 		},
 	[kThrottlerGDDRThm] = {
 			.arb_max = kAiclkArbMaxGDDRThm,
 			.params = {
-					.alpha_filter = 1.0,
-					.p_gain = 0.2,
-					.d_gain = 0,
+					.alpha_filter = DVFS_NUM(1.0),
+					.p_gain = DVFS_NUM(0.2),
+					.d_gain = DVFS_NUM(0),
 				},
 		},
 	[kThrottlerDopplerSlow] = {
 			.arb_max = kAiclkArbMaxDopplerSlow,
 			.params = {
-					.alpha_filter = 1.0,
-					.p_gain = 0.0025,
-					.d_gain = 0.3,
+					.alpha_filter = DVFS_NUM(1.0),
+					.p_gain = DVFS_NUM(0.0025),
+					.d_gain = DVFS_NUM(0.3),
 				},
 		},
 };
 /* clang-format on */
 
-static void SetThrottlerLimit(ThrottlerId id, float limit)
+STATIC void SetThrottlerLimit(ThrottlerId id, float limit)
 {
 	float clamped_limit =
 		CLAMP(limit, throttler_limit_ranges[id].min, throttler_limit_ranges[id].max);
 
 	LOG_INF("Throttler %d limit set to %d", id, (uint32_t)clamped_limit);
-	throttler[id].limit = clamped_limit;
+	throttler[id].limit = DVFS_NUM_FROM_FLOAT(clamped_limit);
+	throttler[id].limit_recip = DVFS_RECIP(throttler[id].limit);
 }
 
 static uint32_t throttle_counter;
@@ -156,7 +154,7 @@ static bool tensixes_enabled = true;
 static void BroadcastKernelThrottleState(void)
 {
 	const uint8_t kNocRing = 0;
-	const uint8_t kNocTlb = 1;
+	const uint8_t kNocTlb = 15;
 
 	if (tensixes_enabled) {
 		NOC2AXITensixBroadcastTlbSetup(kNocRing, kNocTlb, kKernelThrottleAddress,
@@ -232,27 +230,32 @@ void InitThrottlers(void)
 
 	EnableArbMax(throttler[kThrottlerDopplerSlow].arb_max, doppler_slow);
 
-	SetAiclkArbMax(kAiclkArbMaxDopplerCritical, GetAiclkFmin());
+	SetAiclkArbMax(kAiclkArbMaxDopplerCritical, DVFS_NUM_FROM_INT(GetAiclkFmin()));
 	EnableArbMax(kAiclkArbMaxDopplerCritical, false); /* enabled when limit triggered */
 }
 
-static void UpdateThrottler(ThrottlerId id, float value)
+STATIC void UpdateThrottler(ThrottlerId id, dvfs_num_t value)
 {
 	Throttler *t = &throttler[id];
 
-	t->value = t->params.alpha_filter * value + (1 - t->params.alpha_filter) * t->value;
-	t->error = (t->limit - t->value) / t->limit;
-	t->output = t->params.p_gain * t->error + t->params.d_gain * (t->error - t->prev_error);
+	/* Round to nearest rather than down, so that an error of either sign just inside the
+	 * limit moves the arbiter by the same amount instead of always creeping downwards.
+	 */
+	t->value = DVFS_MUL_ROUND(t->params.alpha_filter, value) +
+		   DVFS_MUL_ROUND(DVFS_NUM(1) - t->params.alpha_filter, t->value);
+	t->error = DVFS_MUL_RECIP(t->limit - t->value, t->limit_recip);
+	t->output = DVFS_MUL_ROUND(t->params.p_gain, t->error) +
+		    DVFS_MUL_ROUND(t->params.d_gain, t->error - t->prev_error);
 	t->prev_error = t->error;
 }
 
-static void UpdateThrottlerArb(ThrottlerId id)
+STATIC void UpdateThrottlerArb(ThrottlerId id)
 {
 	Throttler *t = &throttler[id];
 
-	float arb_val = GetThrottlerArbMax(t->arb_max);
+	dvfs_num_t arb_val = GetThrottlerArbMax(t->arb_max);
 
-	arb_val += t->output * kThrottlerAiclkScaleFactor;
+	arb_val += DVFS_MUL_ROUND(t->output, kThrottlerAiclkScaleFactor);
 
 	SetAiclkArbMax(t->arb_max, arb_val);
 }
@@ -291,7 +294,7 @@ static void UpdateDoppler(const TelemetryInternalData *telemetry)
 	uint16_t current_power = GetInputPower();
 	uint16_t average_power = UpdateMovingAveragePower(current_power);
 
-	UpdateThrottler(kThrottlerDopplerSlow, average_power);
+	UpdateThrottler(kThrottlerDopplerSlow, DVFS_NUM_FROM_INT(average_power));
 
 	/* Doppler T2 throttler: 2x power limit for 10 consecutive samples */
 	uint32_t t2_power_limit = power_limit * 2;
@@ -345,14 +348,19 @@ void CalculateThrottlers(void)
 	if (DopplerActive()) {
 		UpdateDoppler(&telemetry_internal_data);
 	} else {
-		UpdateThrottler(kThrottlerTDP, telemetry_internal_data.vcore_power);
-		UpdateThrottler(kThrottlerFastTDC, telemetry_internal_data.vcore_current);
-		UpdateThrottler(kThrottlerTDC, telemetry_internal_data.vcore_current);
-		UpdateThrottler(kThrottlerBoardPower, GetInputPower());
+		dvfs_num_t vcore_current =
+			DVFS_NUM_FROM_FLOAT(telemetry_internal_data.vcore_current);
+
+		UpdateThrottler(kThrottlerTDP,
+				DVFS_NUM_FROM_FLOAT(telemetry_internal_data.vcore_power));
+		UpdateThrottler(kThrottlerFastTDC, vcore_current);
+		UpdateThrottler(kThrottlerTDC, vcore_current);
+		UpdateThrottler(kThrottlerBoardPower, DVFS_NUM_FROM_INT(GetInputPower()));
 	}
 
-	UpdateThrottler(kThrottlerThm, telemetry_internal_data.asic_temperature);
-	UpdateThrottler(kThrottlerGDDRThm, GetMaxGDDRTemp());
+	UpdateThrottler(kThrottlerThm,
+			DVFS_NUM_FROM_FLOAT(telemetry_internal_data.asic_temperature));
+	UpdateThrottler(kThrottlerGDDRThm, DVFS_NUM_FROM_INT(GetMaxGDDRTemp()));
 
 	for (ThrottlerId i = 0; i < kThrottlerCount; i++) {
 		UpdateThrottlerArb(i);
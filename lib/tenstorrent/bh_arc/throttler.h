@@ -6,6 +6,19 @@
 #ifndef THROTTLER_H
 #define THROTTLER_H
 
+#include <stdint.h>
+
+typedef enum {
+	kThrottlerTDP,
+	kThrottlerFastTDC,
+	kThrottlerTDC,
+	kThrottlerThm,
+	kThrottlerBoardPower,
+	kThrottlerGDDRThm,
+	kThrottlerDopplerSlow,
+	kThrottlerCount,
+} ThrottlerId;
+
 void InitThrottlers(void);
 void CalculateThrottlers(void);
 int32_t Dm2CmSetBoardPowerLimit(const uint8_t *data, uint8_t size);
@@ -4,12 +4,27 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <math.h>
+#include <string.h>
+
 #include <zephyr/sys/util.h>
 #include "aiclk_ppm.h"
 #include "vf_curve.h"
+#include "voltage.h"
+#include <zephyr/drivers/flash.h>
 #include <zephyr/drivers/misc/bh_fwtable.h>
+#include <zephyr/logging/log.h>
 #include <tenstorrent/msgqueue.h>
 #include <tenstorrent/smc_msg.h>
+#include <tenstorrent/tt_boot_fs.h>
+
+LOG_MODULE_REGISTER(vf_curve, CONFIG_TT_APP_LOG_LEVEL);
+
+#ifdef CONFIG_ZTEST
+#define STATIC
+#else
+#define STATIC static
+#endif
 
 /* Bounds checks for frequency and voltage margin */
 #define FREQ_MARGIN_MAX    300.0F
@@ -17,6 +32,8 @@
 #define VOLTAGE_MARGIN_MAX 150.0F
 #define VOLTAGE_MARGIN_MIN -150.0F
 
+#define VF_CURVE_TAG "vfcurve"
+
 static const float vf_quadratic_coeff = 0.00031395F;
 static const float vf_linear_coeff = -0.43953F;
 static const float vf_constant = 828.83F;
@@ -24,7 +41,152 @@ static const float vf_constant = 828.83F;
 static float freq_margin_mhz = FREQ_MARGIN_MAX;
 static float voltage_margin_mv = VOLTAGE_MARGIN_MAX;
 
+/* Characterised curve from boot-FS, used instead of the quadratic if num_pwl_points != 0 */
+static struct vf_curve_point pwl_points[VF_CURVE_MAX_POINTS];
+static uint32_t num_pwl_points;
+
 static const struct device *const fwtable_dev = DEVICE_DT_GET(DT_NODELABEL(fwtable));
+static const struct device *const flash = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(spi_flash));
+
+#ifdef CONFIG_TT_BH_ARC_DVFS_FIXED_POINT
+/* Voltage at every VF_LUT_STEP_MHZ from 0 to VF_LUT_MAX_MHZ, linearly interpolated in between.
+ * The interpolation error of the quadratic is below 0.03 mV.
+ */
+#define VF_LUT_STEP_LOG2 4
+#define VF_LUT_STEP_MHZ  BIT(VF_LUT_STEP_LOG2)
+#define VF_LUT_MAX_MHZ   2048
+#define VF_LUT_SIZE      (VF_LUT_MAX_MHZ / VF_LUT_STEP_MHZ + 1)
+
+static q16_16_t vf_lut[VF_LUT_SIZE];
+#endif
+
+/* Maximum frequency in [fmin, fmax] for every voltage from fv_lut_min_mv, in 1 mV steps.
+ * FV_LUT_SIZE mV comfortably covers the voltage swing of any curve over the AICLK range.
+ */
+#define FV_LUT_SIZE 1024
+
+static uint16_t fv_lut[FV_LUT_SIZE];
+static int32_t fv_lut_min_mv;
+
+static bool vf_tables_valid;
+
+/* Voltage from the precomputed table in the fixed-point build, or the model in the float build */
+static dvfs_num_t VFLookup(uint32_t freq_mhz)
+{
+#ifdef CONFIG_TT_BH_ARC_DVFS_FIXED_POINT
+	uint32_t freq = MIN(freq_mhz, VF_LUT_MAX_MHZ);
+	uint32_t i = freq >> VF_LUT_STEP_LOG2;
+	uint32_t frac = freq & (VF_LUT_STEP_MHZ - 1);
+
+	if (frac == 0) {
+		return vf_lut[i];
+	}
+
+	return vf_lut[i] + (((vf_lut[i + 1] - vf_lut[i]) * (int32_t)frac) >> VF_LUT_STEP_LOG2);
+#else
+	return VFCurveReference(freq_mhz);
+#endif
+}
+
+/* Smallest whole mV that is at least voltage_mv */
+static int32_t CeilMv(dvfs_num_t voltage_mv)
+{
+#ifdef CONFIG_TT_BH_ARC_DVFS_FIXED_POINT
+	return q16_16_to_int(voltage_mv + Q16_16_ONE - 1);
+#else
+	return (int32_t)ceilf(voltage_mv);
+#endif
+}
+
+static void BuildVFTables(void)
+{
+#ifdef CONFIG_TT_BH_ARC_DVFS_FIXED_POINT
+	for (uint32_t i = 0; i < VF_LUT_SIZE; i++) {
+		vf_lut[i] = q16_16_from_float(VFCurveReference(i * VF_LUT_STEP_MHZ));
+	}
+#endif
+
+	uint32_t fmin = GetAiclkFmin();
+	uint32_t fmax = GetAiclkFmax();
+
+	fv_lut_min_mv = INT32_MAX;
+	for (uint32_t freq = fmin; freq <= fmax; freq++) {
+		fv_lut_min_mv = MIN(fv_lut_min_mv, CeilMv(VFLookup(freq)));
+	}
+
+	/* Walking down from fmax, each frequency is the answer for every voltage from its own
+	 * up to the lowest voltage already answered by a higher frequency. The curve need not be
+	 * monotonic.
+	 */
+	uint32_t answered = FV_LUT_SIZE;
+
+	for (uint32_t freq = fmax + 1; freq-- > fmin;) {
+		uint32_t index = CeilMv(VFLookup(freq)) - fv_lut_min_mv;
+
+		while (answered > index) {
+			fv_lut[--answered] = freq;
+		}
+	}
+
+	vf_tables_valid = true;
+}
+
+/* Use a characterised curve of (frequency, voltage) points instead of the quadratic.
+ * Returns 0 on success, -EINVAL if the curve is malformed, or -ERANGE if a voltage is outside
+ * what the VDD regulator can supply. A rejected curve leaves the current one in place.
+ */
+STATIC int LoadVFCurvePoints(const struct vf_curve_file *file)
+{
+	if (file->version != VF_CURVE_VERSION ||
+	    !IN_RANGE(file->num_points, 2, VF_CURVE_MAX_POINTS)) {
+		return -EINVAL;
+	}
+
+	for (uint32_t i = 0; i < file->num_points; i++) {
+		if (!IN_RANGE(file->points[i].voltage_mv, VDD_MIN, VDD_MAX)) {
+			return -ERANGE;
+		}
+	}
+
+	for (uint32_t i = 1; i < file->num_points; i++) {
+		if (file->points[i].freq_mhz <= file->points[i - 1].freq_mhz ||
+		    file->points[i].voltage_mv < file->points[i - 1].voltage_mv) {
+			return -EINVAL;
+		}
+	}
+
+	memcpy(pwl_points, file->points, file->num_points * sizeof(pwl_points[0]));
+	num_pwl_points = file->num_points;
+	vf_tables_valid = false;
+
+	return 0;
+}
+
+static void LoadVFCurveFromBootFs(void)
+{
+	tt_boot_fs_fd fd;
+	struct vf_curve_file file = {0};
+
+	if (flash == NULL || tt_boot_fs_find_fd_by_tag(flash, VF_CURVE_TAG, &fd) < 0) {
+		return;
+	}
+
+	int rc = flash_read(flash, fd.spi_addr, &file,
+			    MIN(fd.flags.f.image_size, sizeof(struct vf_curve_file)));
+
+	if (rc < 0) {
+		LOG_ERR("%s() failed: %d", "flash_read", rc);
+		return;
+	}
+
+	rc = LoadVFCurvePoints(&file);
+	if (rc < 0) {
+		LOG_ERR("Ignoring %s, using the built-in curve: %d", VF_CURVE_TAG, rc);
+		return;
+	}
+
+	LOG_INF("Using %u point V/F curve from %s", num_pwl_points, VF_CURVE_TAG);
+}
 
 void InitVFCurve(void)
 {
@@ -34,16 +196,86 @@ void InitVFCurve(void)
 	voltage_margin_mv =
 		CLAMP(tt_bh_fwtable_get_fw_table(fwtable_dev)->chip_limits.voltage_margin,
 		      VOLTAGE_MARGIN_MIN, VOLTAGE_MARGIN_MAX);
+
+	num_pwl_points = 0;
+	if (IS_ENABLED(CONFIG_TT_BH_ARC_VF_CURVE_BOOT_FS)) {
+		LoadVFCurveFromBootFs();
+	}
+
+	BuildVFTables();
 }
 
 /**
  * @brief Calculate the voltage based on the frequency
  *
+ * In the fixed-point build this is a lookup in a table precomputed from
+ * @ref VFCurveReference by InitVFCurve().
+ *
  * @param freq_mhz The frequency in MHz
  * @return The voltage in mV
  */
-float VFCurve(float freq_mhz)
+dvfs_num_t VFCurve(uint32_t freq_mhz)
+{
+	if (!vf_tables_valid) {
+		BuildVFTables();
+	}
+
+	return VFLookup(freq_mhz);
+}
+
+/**
+ * @brief Find the highest frequency that runs at or below a voltage
+ *
+ * A lookup in a table precomputed by InitVFCurve().
+ *
+ * @param voltage_mv The voltage in mV
+ * @return The highest frequency in [Fmin, Fmax] whose voltage does not exceed @p voltage_mv, or
+ *         Fmin - 1 if there is none
+ */
+uint32_t VFCurveMaxFreq(uint32_t voltage_mv)
 {
+	if (!vf_tables_valid) {
+		BuildVFTables();
+	}
+
+	if ((int32_t)voltage_mv < fv_lut_min_mv) {
+		return GetAiclkFmin() - 1;
+	}
+
+	return fv_lut[MIN(voltage_mv - fv_lut_min_mv, FV_LUT_SIZE - 1)];
+}
+
+/* Piecewise-linear interpolation of the characterised curve, extrapolating the end segments */
+static float PwlCurve(float freq_mhz)
+{
+	uint32_t i = 1;
+
+	while (i < num_pwl_points - 1 && freq_mhz > pwl_points[i].freq_mhz) {
+		i++;
+	}
+
+	const struct vf_curve_point *lo = &pwl_points[i - 1];
+	const struct vf_curve_point *hi = &pwl_points[i];
+
+	return lo->voltage_mv + (freq_mhz - lo->freq_mhz) * (hi->voltage_mv - lo->voltage_mv) /
+					(hi->freq_mhz - lo->freq_mhz);
+}
+
+/**
+ * @brief Calculate the voltage based on the frequency with the floating point model
+ *
+ * The model is the characterised curve from boot-FS if there is one, otherwise the default
+ * quadratic with the frequency and voltage margins from the fw table.
+ *
+ * @param freq_mhz The frequency in MHz
+ * @return The voltage in mV
+ */
+float VFCurveReference(float freq_mhz)
+{
+	if (num_pwl_points != 0) {
+		return PwlCurve(freq_mhz);
+	}
+
 	float freq_with_margin_mhz = freq_mhz + freq_margin_mhz;
 	float voltage_mv = vf_quadratic_coeff * freq_with_margin_mhz * freq_with_margin_mhz +
 			   vf_linear_coeff * freq_with_margin_mhz + vf_constant;
@@ -54,13 +286,13 @@ float VFCurve(float freq_mhz)
 static uint8_t get_voltage_curve_from_freq_handler(const union request *request,
 						   struct response *response)
 {
-	float input_freq_mhz = (float)request->get_voltage_curve_from_freq.input_freq_mhz;
-	float voltage_mv = VFCurve(input_freq_mhz);
+	uint32_t input_freq_mhz = request->get_voltage_curve_from_freq.input_freq_mhz;
+	dvfs_num_t voltage_mv = VFCurve(input_freq_mhz);
 
-	if (voltage_mv < 0.0F) {
+	if (voltage_mv < DVFS_NUM(0)) {
 		response->data[1] = 0U;
 	} else {
-		response->data[1] = (uint32_t)(voltage_mv);
+		response->data[1] = DVFS_NUM_TO_INT(voltage_mv);
 	}
 
 	return 0;
@@ -6,6 +6,27 @@
 #ifndef VF_CURVE_H
 #define VF_CURVE_H
 
+#include <stdint.h>
+
+#include "dvfs.h"
+
+#define VF_CURVE_VERSION    1
+#define VF_CURVE_MAX_POINTS 32
+
+/* Characterised V/F curve, loaded from the "vfcurve" boot-FS image if present */
+struct vf_curve_point {
+	uint16_t freq_mhz;
+	uint16_t voltage_mv;
+};
+
+struct vf_curve_file {
+	uint32_t version;
+	uint32_t num_points; /* 2 to VF_CURVE_MAX_POINTS, with increasing frequency */
+	struct vf_curve_point points[VF_CURVE_MAX_POINTS];
+};
+
 void InitVFCurve(void);
-float VFCurve(float freq_mhz);
+dvfs_num_t VFCurve(uint32_t freq_mhz);
+uint32_t VFCurveMaxFreq(uint32_t voltage_mv);
+float VFCurveReference(float freq_mhz);
 #endif
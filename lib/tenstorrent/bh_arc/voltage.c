@@ -12,9 +12,7 @@
 #include "regulator.h"
 #include "dvfs.h"
 
-/* TODO: Get these from SPI parameters */
-#define VDD_MIN  700
-#define VDD_MAX  900
+/* TODO: Get this from SPI parameters */
 #define VDD_BOOT 750
 
 VoltageArbiter voltage_arbiter;
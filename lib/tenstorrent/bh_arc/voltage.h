@@ -8,6 +8,10 @@
 
 #include <stdint.h>
 
+/* Range of the VDD regulator, in mV. TODO: Get these from SPI parameters */
+#define VDD_MIN 700
+#define VDD_MAX 900
+
 typedef enum {
 	VoltageReqAiclk,
 	VoltageReqL2CPU,
@@ -4,18 +4,22 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #include <tenstorrent/tt_boot_fs.h>
-#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/crc.h>
 #include <zephyr/sys/util.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/flash.h>
 #include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 
 LOG_MODULE_REGISTER(tt_boot_fs, CONFIG_TT_APP_LOG_LEVEL);
 
+#define TT_BOOT_FS_READ_CHUNK_SIZE 4096
+
 tt_boot_fs boot_fs_data;
 static tt_boot_fs_fd boot_fs_cache[16];
 
@@ -85,42 +89,62 @@ int tt_boot_fs_add_file(const tt_boot_fs *tt_boot_fs, tt_boot_fs_fd fd,
 	return TT_BOOT_FS_OK;
 }
 
-uint32_t tt_boot_fs_cksum(uint32_t cksum, const uint8_t *data, size_t num_bytes)
+/* Sum of little-endian 32-bit words, the checksum that the boot ROM uses. A partial last word is
+ * zero-padded, as tt_boot_fs.py does.
+ */
+static uint32_t tt_boot_fs_sum(uint32_t cksum, const uint8_t *data, size_t num_bytes)
 {
-	if (num_bytes == 0 || data == NULL) {
-		return 0;
+	const uint32_t *data_as_dwords = (const uint32_t *)data;
+	const size_t num_dwords = num_bytes / sizeof(uint32_t);
+	size_t i = 0;
+
+	/* Independent accumulators, so that consecutive loads and adds do not wait on each other */
+	uint32_t sum[4] = {cksum, 0, 0, 0};
+
+	for (; i + ARRAY_SIZE(sum) <= num_dwords; i += ARRAY_SIZE(sum)) {
+		sum[0] += data_as_dwords[i];
+		sum[1] += data_as_dwords[i + 1];
+		sum[2] += data_as_dwords[i + 2];
+		sum[3] += data_as_dwords[i + 3];
 	}
 
-	/* Always read 1 fewer word, and handle the 4 possible alignment cases outside the loop */
-	const uint32_t num_dwords = num_bytes / sizeof(uint32_t) - 1;
-	uint32_t *data_as_dwords = (uint32_t *)data;
+	for (; i < num_dwords; i++) {
+		sum[0] += data_as_dwords[i];
+	}
 
-	for (uint32_t i = 0; i < num_dwords; i++) {
-		cksum += *data_as_dwords++;
+	if (num_bytes % sizeof(uint32_t) != 0) {
+		uint32_t tail = 0;
+
+		memcpy(&tail, &data_as_dwords[num_dwords], num_bytes % sizeof(uint32_t));
+		sum[0] += tail;
 	}
 
-	switch (num_bytes % 4) {
-	case 0:
-		cksum += *data_as_dwords & 0xffffffff;
-		break;
-	default:
-		__ASSERT(false, "size %zu is not a multiple of 4", num_bytes);
-		break;
+	return sum[0] + sum[1] + sum[2] + sum[3];
+}
+
+uint32_t tt_boot_fs_cksum(uint32_t cksum, const uint8_t *data, size_t num_bytes)
+{
+	if (num_bytes == 0 || data == NULL) {
+		return cksum;
+	}
+
+	if (IS_ENABLED(CONFIG_TT_BOOT_FS_CHECKSUM_CRC32)) {
+		return crc32_ieee_update(cksum, data, num_bytes);
 	}
 
-	return cksum;
+	return tt_boot_fs_sum(cksum, data, num_bytes);
 }
 
-static tt_checksum_res_t calculate_and_compare_checksum(uint8_t *data, size_t num_bytes,
-							uint32_t expected, bool skip_checksum)
+uint32_t tt_boot_fs_fd_cksum(const tt_boot_fs_fd *fd)
 {
-	uint32_t calculated_checksum;
+	/* The boot ROM walks the descriptors too, so they keep its checksum whatever images use */
+	return tt_boot_fs_sum(0, (const uint8_t *)fd, offsetof(tt_boot_fs_fd, fd_crc));
+}
 
-	if (!skip_checksum) {
-		calculated_checksum = tt_boot_fs_cksum(0, data, num_bytes);
-		if (calculated_checksum != expected) {
-			return TT_BOOT_FS_CHK_FAIL;
-		}
+static tt_checksum_res_t calculate_and_compare_checksum(const tt_boot_fs_fd *fd)
+{
+	if (tt_boot_fs_fd_cksum(fd) != fd->fd_crc) {
+		return TT_BOOT_FS_CHK_FAIL;
 	}
 
 	return TT_BOOT_FS_CHK_OK;
@@ -137,9 +161,7 @@ static int find_fd_by_tag(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, tt_b
 			continue;
 		}
 
-		tt_checksum_res_t chk_res = calculate_and_compare_checksum(
-			(uint8_t *)&boot_fs_cache[i], sizeof(tt_boot_fs_fd) - sizeof(uint32_t),
-			boot_fs_cache[i].fd_crc, false);
+		tt_checksum_res_t chk_res = calculate_and_compare_checksum(&boot_fs_cache[i]);
 
 		if (chk_res == TT_BOOT_FS_CHK_FAIL) {
 			continue;
@@ -172,9 +194,17 @@ int tt_boot_fs_get_file(const tt_boot_fs *tt_boot_fs, const uint8_t *tag, uint8_
 	}
 	*file_size = fd_data.flags.f.image_size;
 
-	tt_boot_fs->hal_spi_read_f(fd_data.spi_addr, fd_data.flags.f.image_size, buf);
-	if (calculate_and_compare_checksum(buf, fd_data.flags.f.image_size, fd_data.data_crc,
-					   false) != TT_BOOT_FS_CHK_OK) {
+	/* Checksum each chunk right after reading it, while it is still in cache */
+	uint32_t cksum = 0;
+
+	for (size_t offset = 0, len; offset < *file_size; offset += len) {
+		len = MIN(TT_BOOT_FS_READ_CHUNK_SIZE, *file_size - offset);
+
+		tt_boot_fs->hal_spi_read_f(fd_data.spi_addr + offset, len, buf + offset);
+		cksum = tt_boot_fs_cksum(cksum, buf + offset, len);
+	}
+
+	if (cksum != fd_data.data_crc) {
 		return TT_BOOT_FS_ERR;
 	}
 
@@ -210,8 +240,7 @@ int tt_boot_fs_ls(const struct device *dev, tt_boot_fs_fd *fds, size_t nfds, siz
 			break;
 		}
 
-		ret = calculate_and_compare_checksum(
-			(uint8_t *)&fd, sizeof(tt_boot_fs_fd) - sizeof(uint32_t), fd.fd_crc, false);
+		ret = calculate_and_compare_checksum(&fd);
 		if (ret != TT_BOOT_FS_CHK_OK) {
 			return -ENXIO;
 		}
@@ -232,33 +261,137 @@ int tt_boot_fs_ls(const struct device *dev, tt_boot_fs_fd *fds, size_t nfds, siz
 	return found;
 }
 
-int tt_boot_fs_find_fd_by_tag(const struct device *flash_dev, const uint8_t *tag, tt_boot_fs_fd *fd)
+/* Open-addressed table of fd indices, keyed by tag hash, at most half full */
+#define TT_BOOT_FS_INDEX_SLOTS  (2 * BIT(LOG2CEIL(CONFIG_TT_BOOT_FS_IMAGE_COUNT_MAX)))
+#define TT_BOOT_FS_INDEX_EMPTY  UINT8_MAX
+#define TT_BOOT_FS_FNV1A_OFFSET 0x811c9dc5u
+#define TT_BOOT_FS_FNV1A_PRIME  0x01000193u
+
+BUILD_ASSERT(CONFIG_TT_BOOT_FS_IMAGE_COUNT_MAX < TT_BOOT_FS_INDEX_EMPTY);
+
+/* Descriptors of the boot filesystem on one flash device, read once and kept until invalidated */
+static struct tt_boot_fs_index {
+	const struct device *dev; /* NULL when there is no index */
+	size_t nfds;
+	tt_boot_fs_fd fds[CONFIG_TT_BOOT_FS_IMAGE_COUNT_MAX];
+	uint8_t slots[TT_BOOT_FS_INDEX_SLOTS];
+} boot_fs_index;
+
+static K_MUTEX_DEFINE(boot_fs_index_mutex);
+
+/* Tags are NUL-padded, and callers may pass shorter strings, so only hash up to the first NUL */
+static uint32_t tt_boot_fs_tag_hash(const uint8_t *tag)
 {
-	if (tag == NULL) {
-		return -EINVAL;
+	uint32_t hash = TT_BOOT_FS_FNV1A_OFFSET;
+
+	for (size_t i = 0; i < TT_BOOT_FS_IMAGE_TAG_SIZE && tag[i] != '\0'; i++) {
+		hash = (hash ^ tag[i]) * TT_BOOT_FS_FNV1A_PRIME;
 	}
 
-	int ret;
+	return hash;
+}
 
-	tt_boot_fs_fd fds[CONFIG_TT_BOOT_FS_IMAGE_COUNT_MAX];
+static int tt_boot_fs_index_build(const struct device *dev)
+{
+	struct tt_boot_fs_index *index = &boot_fs_index;
+	int ret;
 
-	ret = tt_boot_fs_ls(flash_dev, fds, ARRAY_SIZE(fds), 0);
+	index->dev = NULL;
 
+	ret = tt_boot_fs_ls(dev, index->fds, ARRAY_SIZE(index->fds), 0);
 	if (ret < 0) {
 		return ret;
 	}
 
-	ARRAY_FOR_EACH(fds, i) {
-		if (i >= ret) {
-			break;
-		}
+	index->nfds = ret;
+	memset(index->slots, TT_BOOT_FS_INDEX_EMPTY, sizeof(index->slots));
+
+	for (size_t i = 0; i < index->nfds; i++) {
+		uint32_t slot = tt_boot_fs_tag_hash(index->fds[i].image_tag);
+
+		/* The first descriptor with a tag wins, so later duplicates are not indexed */
+		while (true) {
+			slot %= ARRAY_SIZE(index->slots);
 
-		if (strncmp(tag, fds[i].image_tag, sizeof(fds[i].image_tag)) == 0) {
-			if (fd != NULL) {
-				*fd = fds[i];
+			uint8_t j = index->slots[slot];
+
+			if (j == TT_BOOT_FS_INDEX_EMPTY) {
+				index->slots[slot] = i;
+				break;
+			}
+			if (strncmp(index->fds[j].image_tag, index->fds[i].image_tag,
+				    TT_BOOT_FS_IMAGE_TAG_SIZE) == 0) {
+				break;
 			}
-			return 0;
+			slot++;
 		}
 	}
-	return -ENOENT;
+
+	index->dev = dev;
+
+	return 0;
+}
+
+static const tt_boot_fs_fd *tt_boot_fs_index_find(const uint8_t *tag)
+{
+	struct tt_boot_fs_index *index = &boot_fs_index;
+	uint32_t slot = tt_boot_fs_tag_hash(tag);
+
+	while (true) {
+		slot %= ARRAY_SIZE(index->slots);
+
+		uint8_t i = index->slots[slot];
+
+		if (i == TT_BOOT_FS_INDEX_EMPTY) {
+			return NULL;
+		}
+		if (strncmp(tag, index->fds[i].image_tag, TT_BOOT_FS_IMAGE_TAG_SIZE) == 0) {
+			return &index->fds[i];
+		}
+		slot++;
+	}
+}
+
+void tt_boot_fs_invalidate(const struct device *flash_dev)
+{
+	k_mutex_lock(&boot_fs_index_mutex, K_FOREVER);
+
+	if (flash_dev == NULL || boot_fs_index.dev == flash_dev) {
+		boot_fs_index.dev = NULL;
+	}
+
+	k_mutex_unlock(&boot_fs_index_mutex);
+}
+
+int tt_boot_fs_find_fd_by_tag(const struct device *flash_dev, const uint8_t *tag, tt_boot_fs_fd *fd)
+{
+	if (tag == NULL) {
+		return -EINVAL;
+	}
+
+	if (!flash_dev || !device_is_ready(flash_dev)) {
+		return -ENXIO;
+	}
+
+	int ret = 0;
+
+	k_mutex_lock(&boot_fs_index_mutex, K_FOREVER);
+
+	if (boot_fs_index.dev != flash_dev) {
+		ret = tt_boot_fs_index_build(flash_dev);
+	}
+
+	if (ret == 0) {
+		const tt_boot_fs_fd *found = tt_boot_fs_index_find(tag);
+
+		if (found == NULL) {
+			ret = -ENOENT;
+		} else if (fd != NULL) {
+			*fd = *found;
+		}
+	}
+
+	k_mutex_unlock(&boot_fs_index_mutex);
+
+	return ret;
 }
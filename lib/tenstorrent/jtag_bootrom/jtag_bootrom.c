@@ -83,7 +83,8 @@ void gpio_asic_reset_callback(const struct device *port, struct gpio_callback *c
 static struct gpio_callback preset_cb_data;
 #endif /* IS_ENABLED(CONFIG_JTAG_LOAD_ON_PRESET) */
 
-int jtag_bootrom_reset_asic(struct bh_chip *chip)
+/* Hold the ASIC in reset with the JTAG pins driven */
+static int jtag_bootrom_reset_asic_start(struct bh_chip *chip)
 {
 	/* Only check for pgood if we aren't emulating */
 #if !DT_HAS_COMPAT_STATUS_OKAY(zephyr_gpio_emul)
@@ -97,7 +98,45 @@ int jtag_bootrom_reset_asic(struct bh_chip *chip)
 	bh_chip_assert_asic_reset(chip);
 	bh_chip_assert_spi_reset(chip);
 
-	int ret = jtag_setup(chip->config.jtag);
+	return jtag_setup(chip->config.jtag);
+}
+
+/* Release the ASIC from reset with the straps applied */
+static void jtag_bootrom_reset_asic_release(struct bh_chip *chip)
+{
+	bh_chip_set_straps(chip);
+
+	bh_chip_deassert_asic_reset(chip);
+	bh_chip_deassert_spi_reset(chip);
+}
+
+/* One non-blocking round of jtag_bitbang_wait_for_id() and jtag_axiwait() */
+static bool jtag_bootrom_asic_ready(struct bh_chip *chip)
+{
+#if !DT_HAS_COMPAT_STATUS_OKAY(zephyr_gpio_emul)
+	uint32_t reset_id = 0;
+
+	jtag_reset(chip->config.jtag);
+	jtag_read_id(chip->config.jtag, &reset_id);
+
+	if (reset_id != 0x138A5) {
+		return false;
+	}
+#endif
+
+	return jtag_axiwait(chip->config.jtag, STATUS_POST_CODE_REG_ADDR);
+}
+
+static void jtag_bootrom_reset_asic_finish(struct bh_chip *chip)
+{
+	jtag_reset(chip->config.jtag);
+
+	bh_chip_unset_straps(chip);
+}
+
+int jtag_bootrom_reset_asic(struct bh_chip *chip)
+{
+	int ret = jtag_bootrom_reset_asic_start(chip);
 
 	if (ret) {
 		return ret;
@@ -106,10 +145,7 @@ int jtag_bootrom_reset_asic(struct bh_chip *chip)
 	/* k_sleep(K_MSEC(1)); */
 	k_busy_wait(1000);
 
-	bh_chip_set_straps(chip);
-
-	bh_chip_deassert_asic_reset(chip);
-	bh_chip_deassert_spi_reset(chip);
+	jtag_bootrom_reset_asic_release(chip);
 
 	/* k_sleep(K_MSEC(2)); */
 	k_busy_wait(2000);
@@ -126,13 +162,62 @@ int jtag_bootrom_reset_asic(struct bh_chip *chip)
 		k_yield();
 	}
 
-	jtag_reset(chip->config.jtag);
-
-	bh_chip_unset_straps(chip);
+	jtag_bootrom_reset_asic_finish(chip);
 
 	return 0;
 }
 
+int jtag_bootrom_reset_asic_all(struct bh_chip *chips, size_t count, int *rets)
+{
+	size_t pending = 0;
+
+	/* Every chip shares the reset hold and release delays */
+	for (size_t i = 0; i < count; i++) {
+		rets[i] = jtag_bootrom_reset_asic_start(&chips[i]);
+	}
+
+	k_busy_wait(1000);
+
+	for (size_t i = 0; i < count; i++) {
+		if (rets[i] == 0) {
+			jtag_bootrom_reset_asic_release(&chips[i]);
+			rets[i] = -EAGAIN;
+			pending++;
+		}
+	}
+
+	k_busy_wait(2000);
+
+	/* Poll the chips in turn, so that one that never comes up does not hold back the others */
+	int64_t timeout = k_uptime_get() + CONFIG_JTAG_READY_TIMEOUT_MS;
+
+	while (pending > 0 && k_uptime_get() < timeout) {
+		for (size_t i = 0; i < count; i++) {
+			if (rets[i] == -EAGAIN && jtag_bootrom_asic_ready(&chips[i])) {
+				jtag_bootrom_reset_asic_finish(&chips[i]);
+				rets[i] = 0;
+				pending--;
+			}
+		}
+		k_yield();
+	}
+
+	int ret = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (rets[i] == -EAGAIN) {
+			jtag_teardown(chips[i].config.jtag);
+			bh_chip_unset_straps(&chips[i]);
+			rets[i] = -ETIMEDOUT;
+		}
+		if (ret == 0) {
+			ret = rets[i];
+		}
+	}
+
+	return ret;
+}
+
 int jtag_bootrom_init(struct bh_chip *chip)
 {
 	int ret = false;
@@ -188,10 +273,10 @@ int jtag_bootrom_init(struct bh_chip *chip)
 	return 0;
 }
 
-int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_t patch_len,
-			      const uint32_t start_addr)
-{
 #ifdef CONFIG_JTAG_LOAD_BOOTROM
+/* Halt the ARC and get the chip ready for the patch to be written */
+static void jtag_bootrom_patch_start(struct bh_chip *chip)
+{
 	const struct device *dev = chip->config.jtag;
 
 	jtag_reset(dev);
@@ -213,18 +298,80 @@ int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_
 
 	/* Write to postcode */
 	jtag_axi_write32(dev, STATUS_POST_CODE_REG_ADDR, 0xF2);
+}
 
-	jtag_axi_block_write(dev, start_addr, patch, patch_len);
-
-	jtag_axi_write32(dev, STATUS_POST_CODE_REG_ADDR, 0xF3);
+static void jtag_bootrom_patch_done(struct bh_chip *chip)
+{
+	jtag_axi_write32(chip->config.jtag, STATUS_POST_CODE_REG_ADDR, 0xF3);
 
 	chip->data.workaround_applied = true;
+}
+#endif
+
+int jtag_bootrom_patch_offset(struct bh_chip *chip, const uint32_t *patch, size_t patch_len,
+			      const uint32_t start_addr)
+{
+#ifdef CONFIG_JTAG_LOAD_BOOTROM
+	jtag_bootrom_patch_start(chip);
+
+	if (jtag_axi_block_write(chip->config.jtag, start_addr, patch, patch_len) != 0) {
+		printk("Bootcode AXI write failed\n");
+		return -EIO;
+	}
+
+	jtag_bootrom_patch_done(chip);
 #endif
 
 	return 0;
 }
 
-int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch, size_t patch_len)
+int jtag_bootrom_patch_offset_all(struct bh_chip *chips, size_t count, const uint32_t *patch,
+				  size_t patch_len, const uint32_t start_addr, int *rets)
+{
+	int ret = 0;
+
+#ifdef CONFIG_JTAG_LOAD_BOOTROM
+	const struct device *devs[JTAG_BOOTROM_PATCH_GANG_MAX];
+	size_t idx[JTAG_BOOTROM_PATCH_GANG_MAX];
+	int dev_rets[JTAG_BOOTROM_PATCH_GANG_MAX];
+	size_t next = 0;
+
+	while (next < count) {
+		size_t n = 0;
+
+		/* Gather the next group of chips that are up */
+		for (; next < count && n < ARRAY_SIZE(devs); next++) {
+			if (rets[next] == 0) {
+				jtag_bootrom_patch_start(&chips[next]);
+				devs[n] = chips[next].config.jtag;
+				idx[n] = next;
+				n++;
+			}
+		}
+
+		(void)jtag_axi_block_write_multi(devs, n, start_addr, patch, patch_len, dev_rets);
+
+		for (size_t i = 0; i < n; i++) {
+			if (dev_rets[i] != 0) {
+				/* Half a patch is not worth running, so the ARC is not started */
+				printk("Bootcode AXI write failed\n");
+				jtag_bootrom_teardown(&chips[idx[i]]);
+				rets[idx[i]] = -EIO;
+				if (ret == 0) {
+					ret = -EIO;
+				}
+			} else {
+				jtag_bootrom_patch_done(&chips[idx[i]]);
+			}
+		}
+	}
+#endif
+
+	return ret;
+}
+
+int jtag_bootrom_verify_offset(const struct device *dev, const uint32_t *patch, size_t patch_len,
+			       const uint32_t start_addr)
 {
 	if (!IS_ENABLED(CONFIG_JTAG_VERIFY_WRITE)) {
 		return 0;
@@ -232,18 +379,18 @@ int jtag_bootrom_verify(const struct device *dev, const uint32_t *patch, size_t
 
 	/* Confirmed matching */
 	for (int i = 0; i < patch_len; ++i) {
-		/* ICCM start addr is 0 */
+		uint32_t addr = start_addr + i * 4;
 		uint32_t readback = 0;
 #ifdef CONFIG_JTAG_EMUL
-		jtag_emul_axi_read32(dev, i * 4, &readback);
+		jtag_emul_axi_read32(dev, addr, &readback);
 #else
-		jtag_axi_read32(dev, i * 4, &readback);
+		jtag_axi_read32(dev, addr, &readback);
 #endif
 
 		if (patch[i] != readback) {
 			printk("Bootcode mismatch at %03x. expected: %08x actual: %08x "
 			       "¯\\_(ツ)_/¯\n",
-			       i * 4, patch[i], readback);
+			       addr, patch[i], readback);
 
 			jtag_axi_write32(dev, STATUS_POST_CODE_REG_ADDR, 0x6);
 			return 1;
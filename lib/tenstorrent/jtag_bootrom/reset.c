@@ -12,6 +12,8 @@
 
 LOG_MODULE_REGISTER(jtag_bootrom, CONFIG_TT_JTAG_BOOTROM_LOG_LEVEL);
 
+#define BOOTCODE_START_ADDR 0x80
+
 __aligned(sizeof(uint32_t)) static const uint8_t bootcode[] = {
 #include "bootcode.h"
 };
@@ -29,56 +31,140 @@ const size_t get_bootcode_len(void)
 	return sizeof(bootcode) / sizeof(uint32_t);
 }
 
-int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset)
+/* Verify the patch on a chip it has been written to, then start its ARC */
+static int jtag_bootrom_start(struct bh_chip *chip)
 {
 	const uint32_t *const patch = (const uint32_t *)bootcode;
 	const size_t patch_len = get_bootcode_len();
+	int ret = jtag_bootrom_verify_offset(chip->config.jtag, patch, patch_len,
+					     BOOTCODE_START_ADDR);
 
+	if (ret != 0) {
+		printk("Bootrom verification failed\n");
+		/* As with a failed load, a patch that does not read back is not worth running. The
+		 * ARC stays in reset until the next reset sequence.
+		 */
 #ifdef CONFIG_JTAG_LOAD_ON_PRESET
-	if (force_reset) {
-		chip->data.trigger_reset = true;
+		chip->data.trigger_reset = false;
+#endif
+		jtag_bootrom_teardown(chip);
+		return -EIO;
 	}
+
+	int64_t start = k_uptime_get();
+
+#ifdef CONFIG_JTAG_LOAD_ON_PRESET
+	if (chip->data.trigger_reset) {
+		jtag_bootrom_soft_reset_arc(chip);
+		chip->data.trigger_reset = false;
+	}
+#else
+	jtag_bootrom_soft_reset_arc(chip);
 #endif
 
+	jtag_bootrom_teardown(chip);
+
+	volatile int64_t end = k_uptime_delta(&start);
+
+	LOG_DBG("jtag bootrom reset took %lld ms", end);
+
+	return 0;
+}
+
+/* Load and verify the patch on a chip that is out of reset, then start its ARC */
+static int jtag_bootrom_load(struct bh_chip *chip)
+{
+	const uint32_t *const patch = (const uint32_t *)bootcode;
+	const size_t patch_len = get_bootcode_len();
 	int64_t start = k_uptime_get();
 
+	int ret = jtag_bootrom_patch_offset(chip, patch, patch_len, BOOTCODE_START_ADDR);
+
+	volatile int64_t end = k_uptime_delta(&start);
+
+	LOG_DBG("jtag bootrom load took %lld ms", end);
+
+	if (ret != 0) {
+		/* As with several chips, half a patch is not worth running */
+		jtag_bootrom_teardown(chip);
+		return ret;
+	}
+
+	return jtag_bootrom_start(chip);
+}
+
+int jtag_bootrom_reset_sequence(struct bh_chip *chip, bool force_reset)
+{
+#ifdef CONFIG_JTAG_LOAD_ON_PRESET
+	if (force_reset) {
+		chip->data.trigger_reset = true;
+	}
+#endif
+
 	/* Need to be able to send an i2c transaction to set the straps on the p300 */
 	bh_chip_cancel_bus_transfer_clear(chip);
 	int ret = jtag_bootrom_reset_asic(chip);
 
 	if (ret) {
+		chip->data.bringup_failed = true;
 		return ret;
 	}
 
 	if (DT_HAS_COMPAT_STATUS_OKAY(zephyr_gpio_emul) && IS_ENABLED(CONFIG_JTAG_VERIFY_WRITE)) {
-		jtag_bootrom_emul_setup((uint32_t *)sram, patch_len);
+		jtag_bootrom_emul_setup((uint32_t *)sram, get_bootcode_len());
 	}
 
-	jtag_bootrom_patch_offset(chip, patch, patch_len, 0x80);
+	ret = jtag_bootrom_load(chip);
+	chip->data.bringup_failed = (ret != 0);
 
-	volatile int64_t end = k_uptime_delta(&start);
-
-	LOG_DBG("jtag bootrom load took %lld ms", end);
+	return ret;
+}
 
-	if (jtag_bootrom_verify(chip->config.jtag, patch, patch_len) != 0) {
-		printk("Bootrom verification failed\n");
+int jtag_bootrom_reset_sequence_all(struct bh_chip *chips, size_t count, bool force_reset,
+				    int *rets)
+{
+	for (size_t i = 0; i < count; i++) {
+#ifdef CONFIG_JTAG_LOAD_ON_PRESET
+		if (force_reset) {
+			chips[i].data.trigger_reset = true;
+		}
+#endif
+		/* Need to be able to send an i2c transaction to set the straps on the p300 */
+		bh_chip_cancel_bus_transfer_clear(&chips[i]);
 	}
 
-	start = k_uptime_get();
+	int64_t start = k_uptime_get();
 
-#ifdef CONFIG_JTAG_LOAD_ON_PRESET
-	if (chip->data.trigger_reset) {
-		jtag_bootrom_soft_reset_arc(chip);
-		chip->data.trigger_reset = false;
-	}
-#else
-	jtag_bootrom_soft_reset_arc(chip);
-#endif
+	jtag_bootrom_reset_asic_all(chips, count, rets);
 
-	jtag_bootrom_teardown(chip);
+	volatile int64_t end = k_uptime_delta(&start);
+
+	LOG_DBG("jtag bootrom reset of %zu chips took %lld ms", count, end);
+
+	/* With the chips running, the patch goes out over all of their JTAG ports together */
+	start = k_uptime_get();
+
+	(void)jtag_bootrom_patch_offset_all(chips, count, (const uint32_t *)bootcode,
+					    get_bootcode_len(), BOOTCODE_START_ADDR, rets);
 
 	end = k_uptime_delta(&start);
-	LOG_DBG("jtag bootrom reset took %lld ms", end);
 
-	return 0;
+	LOG_DBG("jtag bootrom load of %zu chips took %lld ms", count, end);
+
+	int ret = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		if (rets[i] == 0) {
+			rets[i] = jtag_bootrom_start(&chips[i]);
+		}
+		chips[i].data.bringup_failed = (rets[i] != 0);
+		if (rets[i] != 0) {
+			LOG_ERR("Chip %zu bring-up failed: %d", i, rets[i]);
+			if (ret == 0) {
+				ret = rets[i];
+			}
+		}
+	}
+
+	return ret;
 }
@@ -16,6 +16,7 @@ import pykwalify.core
 import struct
 from typing import Any, Callable, cast, Iterable, Optional, Tuple
 import yaml
+import zlib
 import argparse
 import sys
 import json
@@ -206,6 +207,8 @@ class FsEntry:
     spi_addr: int
     load_addr: int
     executable: bool
+    # Image checksum is CRC-32, for firmware built with CONFIG_TT_BOOT_FS_CHECKSUM_CRC32
+    crc32: bool = False
 
     def get_descriptor(self) -> tt_boot_fs_fd:
         image_tag = [0] * MAX_TAG_LEN
@@ -222,7 +225,7 @@ class FsEntry:
             spi_addr=self.spi_addr,
             copy_dest=self.load_addr,
             image_tag=(ctypes.c_uint8 * MAX_TAG_LEN)(*image_tag),
-            data_crc=cksum(self.data),
+            data_crc=cksum(self.data, self.crc32),
             flags=fd_flags_u(
                 f=fd_flags(
                     image_size=len(self.data),
@@ -231,6 +234,7 @@ class FsEntry:
                 )
             ),
         )
+        # The boot ROM checks descriptors with the additive checksum, whatever the image uses
         fd.fd_crc = cksum(bytes(fd))
         return fd
 
@@ -296,7 +300,7 @@ class BootImage:
                 )
             binary += bytes(padto - len(binary))
         # We always need to pad binaries to 4 byte offsets for checksum verification
-        binary += bytes((len(binary) % 4))
+        binary += bytes(-len(binary) % 4)
 
         if len(tag) > MAX_TAG_LEN:
             raise ValueError(f"{tag} is longer than the maximum allowed tag size (8).")
@@ -505,7 +509,11 @@ class BootFs:
 
     @staticmethod
     def check_entry(
-        tag: str, fd: tt_boot_fs_fd, data: bytes, alignment: int = 0x1000
+        tag: str,
+        fd: tt_boot_fs_fd,
+        data: bytes,
+        alignment: int = 0x1000,
+        crc32: bool = False,
     ) -> FsEntry:
         data_offs = fd.spi_addr
         if data_offs % alignment != 0:
@@ -519,7 +527,7 @@ class BootFs:
             )
         image_data = data[data_offs : data_offs + image_size]
         data_offs += image_size
-        actual_image_cksum = cksum(image_data)
+        actual_image_cksum = cksum(image_data, crc32)
 
         expected_image_cksum = fd.data_crc
         if expected_image_cksum != actual_image_cksum:
@@ -539,10 +547,13 @@ class BootFs:
             spi_addr=fd.spi_addr,
             load_addr=fd.copy_dest,
             executable=fd.flags.f.executable,
+            crc32=crc32,
         )
 
     @staticmethod
-    def from_binary(data: bytes, alignment: int = 0x1000) -> BootFs:
+    def from_binary(
+        data: bytes, alignment: int = 0x1000, crc32: bool = False
+    ) -> BootFs:
         data_offs = 0
         order: list[str] = []
         entries: dict[str, FsEntry] = {}
@@ -578,8 +589,10 @@ class BootFs:
             raise ValueError(f"spi rx training data not found at 0x{SPI_RX_ADDR:x}")
 
         for tag in order:
-            entries[tag] = BootFs.check_entry(tag, fds[tag], data, alignment)
-        failover = BootFs.check_entry("failover", failover_fd, data, alignment)
+            entries[tag] = BootFs.check_entry(tag, fds[tag], data, alignment, crc32)
+        failover = BootFs.check_entry(
+            "failover", failover_fd, data, alignment, crc32
+        )
 
         return BootFs(order, entries, failover)
 
@@ -637,7 +650,7 @@ class FileImage:
             failover=BootImage.loads("", data["fail_over_image"], alignment, env),
         )
 
-    def to_boot_fs(self):
+    def to_boot_fs(self, crc32: bool = False):
         # We need to
         # - Load all binaries
         # - Place all binaries that have given addresses at the given locations
@@ -691,6 +704,7 @@ class FileImage:
                 spi_addr=addr,
                 load_addr=image.load_addr,
                 executable=image.executable,
+                crc32=crc32,
             )
 
             if image.tag not in tag_order:
@@ -713,39 +727,47 @@ class FileImage:
                 spi_addr=failover_spi_addr,
                 load_addr=self.failover.load_addr,
                 executable=True,
+                crc32=crc32,
             ),
         )
 
 
-def cksum(data: bytes):
-    calculated_checksum = 0
-
-    if len(data) < 4:
-        return 0
+def cksum(data: bytes, crc32: bool = False):
+    # crc32 must match CONFIG_TT_BOOT_FS_CHECKSUM_CRC32 in the firmware. It only applies to image
+    # checksums: descriptors always use the additive checksum that the boot ROM checks.
+    if crc32:
+        return zlib.crc32(bytes(data))
 
-    for i in range(0, len(data), 4):
-        value = int.from_bytes(data[i:][:4], "little")
-        calculated_checksum += value
+    # Unpack all whole words at once and let sum() add them, instead of a Python loop per word
+    num_words = len(data) // 4
+    calculated_checksum = sum(struct.unpack_from(f"<{num_words}I", bytes(data)))
+    calculated_checksum += int.from_bytes(data[num_words * 4 :], "little")
 
     calculated_checksum &= 0xFFFFFFFF
 
     return calculated_checksum
 
 
-def mkfs(path: Path, env={"$ROOT": str(ROOT)}, hex=False, all_sections=False) -> bytes:
+def mkfs(
+    path: Path,
+    env={"$ROOT": str(ROOT)},
+    hex=False,
+    all_sections=False,
+    crc32: bool = False,
+) -> bytes:
     fi = None
     try:
         fi = FileImage.load(path, env)
         if hex:
-            return fi.to_boot_fs().to_intel_hex(all_sections)
+            return fi.to_boot_fs(crc32).to_intel_hex(all_sections)
         else:
-            return fi.to_boot_fs().to_binary(all_sections)
+            return fi.to_boot_fs(crc32).to_binary(all_sections)
     except Exception as e:
         _logger.error(f"Exception: {e}")
     return None
 
 
-def fsck(path: Path, alignment: int = 0x1000) -> bool:
+def fsck(path: Path, alignment: int = 0x1000, crc32: bool = False) -> bool:
     fs = None
     try:
         if path.suffix == ".hex":
@@ -754,7 +776,7 @@ def fsck(path: Path, alignment: int = 0x1000) -> bool:
             data = ih.tobinarray()
         else:
             data = open(path, "rb").read()
-        fs = BootFs.from_binary(data, alignment=alignment)
+        fs = BootFs.from_binary(data, alignment=alignment, crc32=crc32)
     except Exception as e:
         _logger.error(f"Exception: {e}")
     return fs is not None
@@ -796,7 +818,11 @@ def hexdump(start_addr: int, data: bytes, checksum: bool = False):
 
 
 def ls(
-    bootfs: Path, verbose: int = 0, output_json: bool = False, input_base64=False
+    bootfs: Path,
+    verbose: int = 0,
+    output_json: bool = False,
+    input_base64=False,
+    crc32: bool = False,
 ) -> bool:
     fds = []
 
@@ -820,7 +846,7 @@ def ls(
             data = ih.tobinarray()
         else:
             data = open(bootfs, "rb").read()
-        fs = BootFs.from_binary(data)
+        fs = BootFs.from_binary(data, crc32=crc32)
 
         if verbose >= 0 and not output_json:
             hdr = "spi_addr\timage_tag\tsize\tcopy_dest\tdata_crc\tflags\t\tfd_crc\t\tdigest"
@@ -888,7 +914,9 @@ def ls(
     return fds
 
 
-def extract(bootfs: Path, tag: str, output: Path, input_base64=False):
+def extract(
+    bootfs: Path, tag: str, output: Path, input_base64=False, crc32: bool = False
+):
     try:
         if input_base64:
             data = bytes(0)
@@ -909,7 +937,7 @@ def extract(bootfs: Path, tag: str, output: Path, input_base64=False):
             data = ih.tobinarray()
         else:
             data = open(bootfs, "rb").read()
-        fs = BootFs.from_binary(data)
+        fs = BootFs.from_binary(data, crc32=crc32)
 
         entry_data = None
         for t, entry in fs.entries.items():
@@ -1082,9 +1110,11 @@ def invoke_mkfs(args):
         return os.EX_DATAERR
     if args.build_dir and args.build_dir.exists():
         env = {"$ROOT": str(ROOT), "$BUILD_DIR": str(args.build_dir)}
-        data = mkfs(args.specification, env, args.hex, args.all)
+        data = mkfs(args.specification, env, args.hex, args.all, args.crc32)
     else:
-        data = mkfs(args.specification, hex=args.hex, all_sections=args.all)
+        data = mkfs(
+            args.specification, hex=args.hex, all_sections=args.all, crc32=args.crc32
+        )
     if data is None:
         return os.EX_DATAERR
     with open(args.output_file, "wb") as file:
@@ -1097,24 +1127,31 @@ def invoke_fsck(args):
     if not args.filesystem.exists():
         print(f"File {args.filesystem} doesn't exist")
         return os.EX_DATAERR
-    valid = fsck(args.filesystem)
+    valid = fsck(args.filesystem, crc32=args.crc32)
     print(f"Filesystem {args.filesystem} is {'valid' if valid else 'invalid'}")
     return os.EX_OK
 
 
 def invoke_ls(args):
-    ls(args.bootfs, args.verbose - args.quiet, args.json, args.base64)
+    ls(args.bootfs, args.verbose - args.quiet, args.json, args.base64, args.crc32)
     return os.EX_OK
 
 
 def invoke_extract(args):
-    extract(args.bootfs, args.tag, args.output, args.base64)
+    extract(args.bootfs, args.tag, args.output, args.base64, args.crc32)
 
 
 def parse_args():
     parser = argparse.ArgumentParser(
         description="Utility to manage tt_boot_fs binaries", allow_abbrev=False
     )
+    parser.add_argument(
+        "--crc32",
+        help="use CRC-32 image checksums, for firmware built with "
+        "CONFIG_TT_BOOT_FS_CHECKSUM_CRC32",
+        default=False,
+        action="store_true",
+    )
     subparsers = parser.add_subparsers()
 
     generate_bootfs_parser = subparsers.add_parser(
@@ -120,3 +120,187 @@ ZTEST(clock_control_config, test_configure_bypass_succeeds)
 }
 
 ZTEST_SUITE(clock_control_config, NULL, NULL, NULL, NULL, NULL);
+
+/* Planned against the glide-table in app.overlay: <160 8 400 255 2 150> */
+struct clock_control_tt_bh_config;
+uint32_t clock_control_tt_bh_glide_step(const struct clock_control_tt_bh_config *config,
+					uint32_t fbdiv, uint32_t target, uint32_t *settle_ns);
+
+static uint32_t glide_step(uint32_t fbdiv, uint32_t target, uint32_t *settle_ns)
+{
+	const struct device *pll = DEVICE_DT_GET(DT_NODELABEL(pll0));
+
+	return clock_control_tt_bh_glide_step(pll->config, fbdiv, target, settle_ns);
+}
+
+ZTEST(clock_control_glide, test_step_up)
+{
+	uint32_t settle_ns;
+
+	zassert_equal(glide_step(100, 140, &settle_ns), 108);
+	zassert_equal(settle_ns, 400);
+
+	zassert_equal(glide_step(200, 240, &settle_ns), 202);
+	zassert_equal(settle_ns, 150);
+}
+
+ZTEST(clock_control_glide, test_step_down)
+{
+	uint32_t settle_ns;
+
+	zassert_equal(glide_step(140, 100, &settle_ns), 132);
+	zassert_equal(settle_ns, 400);
+
+	/* Limited by the entry of the higher fbdiv, which is where the step starts */
+	zassert_equal(glide_step(200, 100, &settle_ns), 198);
+	zassert_equal(settle_ns, 150);
+}
+
+ZTEST(clock_control_glide, test_step_zero_length)
+{
+	uint32_t settle_ns;
+
+	zassert_equal(glide_step(128, 128, &settle_ns), 128);
+	zassert_equal(settle_ns, 400);
+
+	zassert_equal(glide_step(200, 200, &settle_ns), 200);
+	zassert_equal(settle_ns, 150);
+}
+
+ZTEST(clock_control_glide, test_step_lands_on_target)
+{
+	uint32_t settle_ns;
+
+	zassert_equal(glide_step(100, 103, &settle_ns), 103);
+	zassert_equal(glide_step(103, 100, &settle_ns), 100);
+	zassert_equal(glide_step(201, 200, &settle_ns), 200);
+	zassert_equal(settle_ns, 150);
+}
+
+ZTEST(clock_control_glide, test_step_across_entries)
+{
+	uint32_t settle_ns;
+
+	/* Stepping up into the smaller steps above 160 stops short of the boundary */
+	zassert_equal(glide_step(156, 200, &settle_ns), 158);
+	zassert_equal(settle_ns, 400);
+
+	/* The boundary belongs to the lower entry */
+	zassert_equal(glide_step(158, 200, &settle_ns), 160);
+	zassert_equal(settle_ns, 400);
+	zassert_equal(glide_step(160, 200, &settle_ns), 162);
+	zassert_equal(settle_ns, 150);
+
+	zassert_equal(glide_step(160, 100, &settle_ns), 152);
+	zassert_equal(settle_ns, 400);
+	zassert_equal(glide_step(162, 100, &settle_ns), 160);
+	zassert_equal(settle_ns, 150);
+}
+
+ZTEST(clock_control_glide, test_step_above_table)
+{
+	uint32_t settle_ns;
+
+	/* The last entry also covers fbdivs above it */
+	zassert_equal(glide_step(300, 400, &settle_ns), 302);
+	zassert_equal(settle_ns, 150);
+	zassert_equal(glide_step(300, 200, &settle_ns), 298);
+	zassert_equal(settle_ns, 150);
+}
+
+struct glide_result {
+	struct k_sem done;
+	int status;
+	int calls;
+};
+
+static void glide_cb(const struct device *dev, int status, void *user_data)
+{
+	struct glide_result *result = user_data;
+
+	result->status = status;
+	result->calls++;
+	k_sem_give(&result->done);
+}
+
+ZTEST(clock_control_glide, test_set_rate_async)
+{
+	const struct device *pll = DEVICE_DT_GET(DT_NODELABEL(pll0));
+	const uint32_t target_rate = CONFIG_CLOCK_CTRL_AICLK_MAX_RATE;
+	struct glide_result result = {0};
+	uint32_t new_rate;
+	int ret;
+
+	clock_control_subsys_t aiclk_subsys =
+		(clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK;
+
+	k_sem_init(&result.done, 0, 1);
+
+	ret = clock_control_set_rate(pll, aiclk_subsys,
+				     (clock_control_subsys_rate_t)CONFIG_CLOCK_CTRL_AICLK_MIN_RATE);
+	zassert_ok(ret, "set_rate for AICLK failed with %d", ret);
+
+	ret = clock_control_tt_bh_set_rate_async(pll, aiclk_subsys,
+						 (clock_control_subsys_rate_t)target_rate,
+						 glide_cb, &result);
+	zassert_ok(ret, "set_rate_async for AICLK failed with %d", ret);
+
+	zassert_ok(k_sem_take(&result.done, K_SECONDS(1)), "glide did not finish");
+	zassert_equal(result.status, 0, "glide finished with %d", result.status);
+	zassert_equal(result.calls, 1);
+
+	ret = clock_control_get_rate(pll, aiclk_subsys, &new_rate);
+	zassert_ok(ret, "get_rate for AICLK failed with %d", ret);
+	zassert_within(new_rate, target_rate,
+		       new_rate / 100.f * CONFIG_CLOCK_CTRL_TOLERANCE_PERCENT,
+		       "Expected ~%d Hz but got %d Hz", target_rate, new_rate);
+}
+
+ZTEST(clock_control_glide, test_set_rate_async_retarget)
+{
+	const struct device *pll = DEVICE_DT_GET(DT_NODELABEL(pll0));
+	const uint32_t first_rate = CONFIG_CLOCK_CTRL_AICLK_MAX_RATE;
+	const uint32_t second_rate = CONFIG_CLOCK_CTRL_AICLK_MIN_RATE + 100;
+	struct glide_result first = {0};
+	struct glide_result second = {0};
+	uint32_t new_rate;
+	int ret;
+
+	clock_control_subsys_t aiclk_subsys =
+		(clock_control_subsys_t)CLOCK_CONTROL_TT_BH_CLOCK_AICLK;
+
+	k_sem_init(&first.done, 0, 1);
+	k_sem_init(&second.done, 0, 1);
+
+	ret = clock_control_set_rate(pll, aiclk_subsys,
+				     (clock_control_subsys_rate_t)CONFIG_CLOCK_CTRL_AICLK_MIN_RATE);
+	zassert_ok(ret, "set_rate for AICLK failed with %d", ret);
+
+	/* Retarget before the glide work has had a chance to run */
+	k_sched_lock();
+	ret = clock_control_tt_bh_set_rate_async(pll, aiclk_subsys,
+						 (clock_control_subsys_rate_t)first_rate, glide_cb,
+						 &first);
+	zassert_ok(ret, "first set_rate_async failed with %d", ret);
+	ret = clock_control_tt_bh_set_rate_async(pll, aiclk_subsys,
+						 (clock_control_subsys_rate_t)second_rate,
+						 glide_cb, &second);
+	k_sched_unlock();
+	zassert_ok(ret, "second set_rate_async failed with %d", ret);
+
+	zassert_equal(first.calls, 1);
+	zassert_equal(first.status, -ECANCELED, "superseded glide got %d", first.status);
+
+	zassert_ok(k_sem_take(&second.done, K_SECONDS(1)), "glide did not finish");
+	zassert_equal(second.status, 0, "glide finished with %d", second.status);
+	zassert_equal(second.calls, 1);
+	zassert_equal(first.calls, 1, "superseded callback ran again");
+
+	ret = clock_control_get_rate(pll, aiclk_subsys, &new_rate);
+	zassert_ok(ret, "get_rate for AICLK failed with %d", ret);
+	zassert_within(new_rate, second_rate,
+		       new_rate / 100.f * CONFIG_CLOCK_CTRL_TOLERANCE_PERCENT,
+		       "Expected ~%d Hz but got %d Hz", second_rate, new_rate);
+}
+
+ZTEST_SUITE(clock_control_glide, NULL, NULL, NULL, NULL, NULL);
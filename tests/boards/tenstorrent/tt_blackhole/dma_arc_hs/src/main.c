@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/dma.h>
+#include <zephyr/drivers/dma/dma_arc_hs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#define TEST_CHANNEL 0
+/* Expected to finish sooner than CONFIG_DMA_ARC_HS_POLL_MIN_US, so it is busy waited for */
+#define SHORT_LEN    256
+/* Expected to take longer than CONFIG_DMA_ARC_HS_POLL_MIN_US, so the caller sleeps and polls */
+#define LONG_LEN     4096
+
+BUILD_ASSERT(DIV_ROUND_UP(SHORT_LEN, CONFIG_DMA_ARC_HS_BYTES_PER_US) <
+	     CONFIG_DMA_ARC_HS_POLL_MIN_US);
+BUILD_ASSERT(DIV_ROUND_UP(LONG_LEN, CONFIG_DMA_ARC_HS_BYTES_PER_US) >
+	     CONFIG_DMA_ARC_HS_POLL_MIN_US);
+
+#define NUM_CHANNELS      DT_PROP(DT_NODELABEL(dma0), dma_channels)
+#define MAX_TRANSFER_LEN  DMA_ARC_HS_MAX_TRANSFER_LEN(DT_NODELABEL(dma0))
+/* Each channel copies its own slice of the buffers */
+#define CONCURRENT_LEN    (LONG_LEN / NUM_CHANNELS)
+
+BUILD_ASSERT(CONCURRENT_LEN % 4 == 0);
+
+static const struct device *const dma_dev = DEVICE_DT_GET(DT_NODELABEL(dma0));
+
+static uint8_t src_buf[LONG_LEN] __aligned(4);
+static uint8_t dst_buf[LONG_LEN] __aligned(4);
+
+static void fill_buffers(size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		src_buf[i] = (uint8_t)(i * 7 + 3);
+	}
+	memset(dst_buf, 0, sizeof(dst_buf));
+}
+
+static void check_copy(size_t len)
+{
+	zassert_mem_equal(dst_buf, src_buf, len);
+	for (size_t i = len; i < sizeof(dst_buf); i++) {
+		zassert_equal(dst_buf[i], 0, "byte %zu written past the end of the transfer", i);
+	}
+}
+
+static void check_transfer(size_t len)
+{
+	struct dma_arc_hs_stats before, after;
+
+	fill_buffers(len);
+	zassert_ok(dma_arc_hs_get_stats(dma_dev, TEST_CHANNEL, &before));
+	zassert_ok(dma_arc_hs_transfer(dma_dev, TEST_CHANNEL, src_buf, dst_buf, len, K_MSEC(100)));
+	zassert_ok(dma_arc_hs_get_stats(dma_dev, TEST_CHANNEL, &after));
+
+	check_copy(len);
+	zassert_equal(after.transfers, before.transfers + 1);
+	zassert_equal(after.bytes, before.bytes + len);
+	zassert_false(after.active);
+}
+
+ZTEST(dma_arc_hs, test_transfer_busy_wait)
+{
+	check_transfer(SHORT_LEN);
+}
+
+ZTEST(dma_arc_hs, test_transfer_poll)
+{
+	check_transfer(LONG_LEN);
+}
+
+struct workq_transfer {
+	struct k_work work;
+	struct k_sem done;
+	int rc;
+};
+
+static void workq_transfer_handler(struct k_work *work)
+{
+	struct workq_transfer *xfer = CONTAINER_OF(work, struct workq_transfer, work);
+
+	xfer->rc = dma_arc_hs_transfer(dma_dev, TEST_CHANNEL, src_buf, dst_buf, LONG_LEN,
+				       K_MSEC(100));
+	k_sem_give(&xfer->done);
+}
+
+/* Telemetry and other work items copy with DMA from the system workqueue, which also runs the
+ * driver's completion work. A blocking transfer there must not wait on that work.
+ */
+ZTEST(dma_arc_hs, test_transfer_from_system_workqueue)
+{
+	struct workq_transfer xfer = {.rc = -EINPROGRESS};
+
+	fill_buffers(LONG_LEN);
+	k_sem_init(&xfer.done, 0, 1);
+	k_work_init(&xfer.work, workq_transfer_handler);
+
+	zassert_true(k_work_submit(&xfer.work) >= 0);
+	zassert_ok(k_sem_take(&xfer.done, K_SECONDS(1)));
+	zassert_ok(xfer.rc);
+	check_copy(LONG_LEN);
+}
+
+struct async_transfer {
+	struct k_sem done;
+	uint32_t channel;
+	int status;
+};
+
+static void async_transfer_done(const struct device *dev, void *user_data, uint32_t channel,
+				int status)
+{
+	struct async_transfer *xfer = user_data;
+
+	ARG_UNUSED(dev);
+
+	xfer->channel = channel;
+	xfer->status = status;
+	k_sem_give(&xfer->done);
+}
+
+/* Without a status poll from the caller, the completion work must finish the transfer */
+ZTEST(dma_arc_hs, test_transfer_async)
+{
+	struct async_transfer xfer = {.status = -EINPROGRESS};
+
+	fill_buffers(LONG_LEN);
+	k_sem_init(&xfer.done, 0, 1);
+
+	zassert_ok(dma_arc_hs_transfer_async(dma_dev, TEST_CHANNEL, src_buf, dst_buf, LONG_LEN,
+					     async_transfer_done, &xfer));
+	zassert_ok(k_sem_take(&xfer.done, K_SECONDS(1)));
+	zassert_equal(xfer.channel, TEST_CHANNEL);
+	zassert_ok(xfer.status);
+	check_copy(LONG_LEN);
+}
+
+ZTEST(dma_arc_hs, test_transfer_zero_length)
+{
+	zassert_ok(dma_arc_hs_transfer(dma_dev, TEST_CHANNEL, src_buf, dst_buf, 0, K_MSEC(100)));
+	zassert_equal(dma_arc_hs_transfer_async(dma_dev, TEST_CHANNEL, src_buf, dst_buf, 0, NULL,
+						NULL),
+		      -EINVAL);
+}
+
+/* Too long for the channel's descriptors. Rejected before the buffers are touched, so they
+ * need not be that large.
+ */
+ZTEST(dma_arc_hs, test_transfer_too_long)
+{
+	zassert_equal(dma_arc_hs_transfer(dma_dev, TEST_CHANNEL, src_buf, dst_buf,
+					  MAX_TRANSFER_LEN + 4, K_MSEC(100)),
+		      -E2BIG);
+	zassert_equal(dma_arc_hs_transfer_async(dma_dev, TEST_CHANNEL, src_buf, dst_buf,
+						SIZE_MAX & ~3, NULL, NULL),
+		      -E2BIG);
+}
+
+/* Every channel has a ring of descriptors of its own, so all of them can be busy at once */
+ZTEST(dma_arc_hs, test_transfer_concurrent_channels)
+{
+	struct async_transfer xfers[NUM_CHANNELS];
+
+	fill_buffers(LONG_LEN);
+
+	for (uint32_t channel = 0; channel < NUM_CHANNELS; channel++) {
+		size_t offset = channel * CONCURRENT_LEN;
+
+		xfers[channel].status = -EINPROGRESS;
+		k_sem_init(&xfers[channel].done, 0, 1);
+		zassert_ok(dma_arc_hs_transfer_async(dma_dev, channel, &src_buf[offset],
+						     &dst_buf[offset], CONCURRENT_LEN,
+						     async_transfer_done, &xfers[channel]));
+	}
+
+	for (uint32_t channel = 0; channel < NUM_CHANNELS; channel++) {
+		zassert_ok(k_sem_take(&xfers[channel].done, K_SECONDS(1)));
+		zassert_equal(xfers[channel].channel, channel);
+		zassert_ok(xfers[channel].status);
+	}
+
+	check_copy(LONG_LEN);
+}
+
+static void *dma_arc_hs_setup(void)
+{
+	zassert_true(device_is_ready(dma_dev), "ARC DMA device not ready");
+
+	return NULL;
+}
+
+ZTEST_SUITE(dma_arc_hs, NULL, dma_arc_hs_setup, NULL, NULL, NULL);
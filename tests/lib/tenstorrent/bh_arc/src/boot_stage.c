@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <tenstorrent/sys_init_defines.h>
+
+#include "boot_stage.h"
+
+extern void RunBootStages(const struct boot_stage *stages, size_t num_stages);
+
+static char trace[16];
+static size_t trace_len;
+
+static void Trace(char c)
+{
+	trace[trace_len++] = c;
+}
+
+static int StageA(void)
+{
+	Trace('A');
+	/* Blocks, so that another thread can run stage B in the meantime */
+	k_msleep(10);
+	Trace('a');
+	return 0;
+}
+
+static int StageB(void)
+{
+	Trace('B');
+	Trace('b');
+	return 0;
+}
+
+static int StageC(void)
+{
+	Trace('C');
+	Trace('c');
+	return -EIO;
+}
+
+static int StageD(void)
+{
+	Trace('D');
+	Trace('d');
+	return 0;
+}
+
+ZTEST(boot_stage, test_boot_stage_order)
+{
+	/* Stage 4 does not exist and counts as finished */
+	const struct boot_stage stages[] = {
+		{.init = StageD, .name = "D", .id = 5, .deps = BIT(2) | BIT(4)},
+		{.init = StageC, .name = "C", .id = 2, .deps = BIT(0) | BIT(1)},
+		{.init = StageB, .name = "B", .id = 1, .deps = 0},
+		{.init = StageA, .name = "A", .id = 0, .deps = 0},
+	};
+
+	memset(trace, 0, sizeof(trace));
+	trace_len = 0;
+
+	RunBootStages(stages, ARRAY_SIZE(stages));
+
+	if (CONFIG_TT_BH_ARC_BOOT_STAGE_THREADS > 1) {
+		zassert_str_equal(trace, "ABbaCcDd");
+	} else {
+		zassert_str_equal(trace, "AaBbCcDd");
+	}
+
+	const struct boot_stage_time *times = GetBootStageTimes();
+
+	zassert_equal(times[4].start, 0);
+	zassert_equal(times[4].end, 0);
+
+	/* Stage C failed, and its dependents still ran */
+	zassert_equal(GetFailedBootStages(), BIT(2));
+}
+
+ZTEST_SUITE(boot_stage, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include "aiclk_ppm.h"
+#include "dvfs.h"
+#include "fixed_point.h"
+#include "throttler.h"
+
+ZTEST(fixed_point, test_q16_16_conversions)
+{
+	zassert_equal(Q16_16(1.0), Q16_16_ONE);
+	zassert_equal(Q16_16(-0.5), -Q16_16_ONE / 2);
+	zassert_equal(q16_16_from_int(1400), 1400 * Q16_16_ONE);
+	zassert_equal(q16_16_from_int(-3), -3 * Q16_16_ONE);
+	zassert_equal(q16_16_to_int(Q16_16(812.75)), 812);
+	zassert_equal(q16_16_to_int(Q16_16(-1.25)), -2);
+	zassert_equal(Q16_16(0.00001), 1);
+	zassert_equal(q16_16_from_float(0.00001f), 0); /* truncated, not rounded */
+	zassert_within(q16_16_to_float(Q16_16(0.0025)), 0.0025f, 1.0f / Q16_16_ONE);
+}
+
+ZTEST(fixed_point, test_q16_16_arithmetic)
+{
+	zassert_equal(q16_16_mul(Q16_16(1.5), Q16_16(-2)), Q16_16(-3));
+	zassert_equal(q16_16_mul(Q16_16(0.2), q16_16_from_int(500)), Q16_16(100) - 100);
+	zassert_equal(q16_16_div(Q16_16(3), Q16_16(-2)), Q16_16(-1.5));
+	zassert_equal(q16_16_div(Q16_16(150) - Q16_16(180), Q16_16(150)), Q16_16(-0.2));
+
+	/* Products and quotients larger than 16 bits are kept in 64 bits until shifted back */
+	zassert_equal(q16_16_mul(q16_16_from_int(1000), q16_16_from_int(20)),
+		      q16_16_from_int(20000));
+	zassert_equal(q16_16_div(q16_16_from_int(20000), q16_16_from_int(1000)),
+		      q16_16_from_int(20));
+}
+
+ZTEST(fixed_point, test_q16_16_symmetric_rounding)
+{
+	/* q16_16_mul() rounds towards negative infinity, so tiny negative products become -1 LSB */
+	zassert_equal(q16_16_mul(Q16_16(0.2), -1), -1);
+	zassert_equal(q16_16_mul(Q16_16(0.2), 1), 0);
+
+	zassert_equal(q16_16_mul_round(Q16_16(0.2), -1), 0);
+	zassert_equal(q16_16_mul_round(Q16_16(0.2), 1), 0);
+	zassert_equal(q16_16_mul_round(Q16_16(0.75), -1), -1);
+	zassert_equal(q16_16_mul_round(Q16_16(0.75), 1), 1);
+	zassert_equal(q16_16_mul_round(Q16_16(1.5), Q16_16(-2)), Q16_16(-3));
+
+	zassert_equal(q16_16_recip(Q16_16(-2)), -q16_16_recip(Q16_16(2)));
+	zassert_equal(q16_16_mul_recip(Q16_16(-30), q16_16_recip(Q16_16(150))), Q16_16(-0.2));
+	zassert_equal(q16_16_mul_recip(Q16_16(30), q16_16_recip(Q16_16(150))), Q16_16(0.2));
+	zassert_equal(q16_16_mul_recip(q16_16_from_int(20000), q16_16_recip(q16_16_from_int(1000))),
+		      q16_16_from_int(20));
+}
+
+void SetThrottlerLimit(ThrottlerId id, float limit);
+void UpdateThrottler(ThrottlerId id, dvfs_num_t value);
+void UpdateThrottlerArb(ThrottlerId id);
+
+/*
+ * Run the throttler PD update of UpdateThrottler() and UpdateThrottlerArb() next to a float
+ * reference, over inputs sweeping from 0 to twice the limit. The AICLK arbiter step must stay
+ * within 1/32 MHz of the reference per tick.
+ */
+ZTEST(fixed_point, test_throttler_step_matches_float)
+{
+	/* Must match the arbiters and gains in throttler[] */
+	static const struct {
+		AiclkArbMax arb_max;
+		float alpha, p, d;
+	} throttlers[kThrottlerCount] = {
+		[kThrottlerTDP] = {kAiclkArbMaxTDP, 1.0f, 0.2f, 0.0f},
+		[kThrottlerFastTDC] = {kAiclkArbMaxFastTDC, 1.0f, 0.5f, 0.0f},
+		[kThrottlerTDC] = {kAiclkArbMaxTDC, 0.1f, 0.2f, 0.0f},
+		[kThrottlerThm] = {kAiclkArbMaxThm, 1.0f, 0.2f, 0.0f},
+		[kThrottlerBoardPower] = {kAiclkArbMaxBoardPower, 1.0f, 0.1f, 0.1f},
+		[kThrottlerGDDRThm] = {kAiclkArbMaxGDDRThm, 1.0f, 0.2f, 0.0f},
+		[kThrottlerDopplerSlow] = {kAiclkArbMaxDopplerSlow, 1.0f, 0.0025f, 0.3f},
+	};
+	/* Within the allowed limit range of every throttler */
+	static const float limits[] = {50.0f, 87.5f, 100.0f};
+	const float mhz_tol = 1.0f / 32;
+	/* Far enough from fmin and fmax that the arbiter is never clamped */
+	const dvfs_num_t arb_mid = DVFS_NUM_FROM_INT((GetAiclkFmin() + GetAiclkFmax()) / 2);
+
+	for (ThrottlerId id = 0; id < kThrottlerCount; id++) {
+		AiclkArbMax arb_max = throttlers[id].arb_max;
+		dvfs_num_t saved_arb = GetThrottlerArbMax(arb_max);
+
+		ARRAY_FOR_EACH(limits, l) {
+			float input = 0.37f;
+			float ref_value = input;
+			float ref_prev_error = (limits[l] - ref_value) / limits[l];
+
+			SetThrottlerLimit(id, limits[l]);
+
+			/* Settle the filter and the previous error on the first input */
+			for (int i = 0; i < 300; i++) {
+				UpdateThrottler(id, DVFS_NUM_FROM_FLOAT(input));
+			}
+
+			for (int i = 1; i <= 256; i++) {
+				input = 2.0f * limits[l] * i / 256 + 0.37f;
+
+				SetAiclkArbMax(arb_max, arb_mid);
+				UpdateThrottler(id, DVFS_NUM_FROM_FLOAT(input));
+				UpdateThrottlerArb(id);
+
+				dvfs_num_t step = GetThrottlerArbMax(arb_max) - arb_mid;
+
+				ref_value = throttlers[id].alpha * input +
+					    (1.0f - throttlers[id].alpha) * ref_value;
+				float ref_error = (limits[l] - ref_value) / limits[l];
+				float ref_output = throttlers[id].p * ref_error +
+						   throttlers[id].d * (ref_error - ref_prev_error);
+
+				ref_prev_error = ref_error;
+
+				zassert_within(DVFS_NUM_TO_FLOAT(step), ref_output * 500, mhz_tol,
+					       "throttler %d limit %zu input %d", id, l, i);
+			}
+		}
+
+		SetAiclkArbMax(arb_max, saved_arb);
+	}
+}
+
+ZTEST_SUITE(fixed_point, NULL, NULL, NULL, NULL, NULL);
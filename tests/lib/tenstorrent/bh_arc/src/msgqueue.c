@@ -13,6 +13,8 @@
 #include "asic_state.h"
 #include "clock_wave.h"
 #include "noc_init.h"
+#include "status_reg.h"
+#include "timer.h"
 
 #include "reg_mock.h"
 
@@ -28,6 +30,7 @@ static uint8_t i2c_write_buf_idx;
 
 static uint32_t clock_wave_value;
 static uint32_t noc_2_axi_last_write;
+static uint32_t msg_q_info_addr;
 
 static uint32_t ReadReg_msgqueue_fake(uint32_t addr)
 {
@@ -73,6 +76,10 @@ static void WriteReg_msgqueue_fake(uint32_t addr, uint32_t value)
 	if (addr == 0xC0000000) {
 		noc_2_axi_last_write = value;
 	}
+
+	if (addr == STATUS_MSG_Q_INFO_REG_ADDR) {
+		msg_q_info_addr = value;
+	}
 }
 
 static uint8_t msgqueue_handler_73(const union request *req, struct response *rsp)
@@ -97,6 +104,347 @@ ZTEST(msgqueue, test_msgqueue_register_handler)
 	zassert_equal(rsp.data[1], 0x73737373);
 }
 
+static uint32_t msgqueue_handler_74_order[NUM_MSG_QUEUES * MSG_QUEUE_SIZE];
+static uint32_t msgqueue_handler_74_count;
+
+static uint8_t msgqueue_handler_74(const union request *req, struct response *rsp)
+{
+	msgqueue_handler_74_order[msgqueue_handler_74_count++] = req->data[1];
+	rsp->data[1] = req->data[1];
+	return 0;
+}
+
+ZTEST(msgqueue, test_msgqueue_full_queue)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	msgqueue_register_handler(0x74, msgqueue_handler_74);
+	msgqueue_handler_74_count = 0;
+
+	req.data[0] = 0x74;
+	for (uint32_t i = 0; i < MSG_QUEUE_SIZE; i++) {
+		req.data[1] = i;
+		msgqueue_request_push(0, &req);
+	}
+	process_message_queues();
+
+	zassert_equal(msgqueue_handler_74_count, MSG_QUEUE_SIZE);
+	for (uint32_t i = 0; i < MSG_QUEUE_SIZE; i++) {
+		msgqueue_response_pop(0, &rsp);
+		zassert_equal(rsp.data[0], 0);
+		zassert_equal(rsp.data[1], i);
+	}
+}
+
+ZTEST(msgqueue, test_msgqueue_priority)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	if (NUM_MSG_QUEUES < 2) {
+		ztest_test_skip();
+	}
+
+	msgqueue_register_handler(0x74, msgqueue_handler_74);
+	msgqueue_handler_74_count = 0;
+	zassert_equal(msgqueue_set_priority(0, 1), 0);
+	zassert_equal(msgqueue_set_priority(1, 0), 0);
+	zassert_equal(msgqueue_set_priority(NUM_MSG_QUEUES, 0), -1);
+
+	req.data[0] = 0x74;
+	req.data[1] = 0;
+	msgqueue_request_push(0, &req);
+	req.data[1] = 1;
+	msgqueue_request_push(1, &req);
+	process_message_queues();
+
+	/* queue 1 has the higher priority, so it must be drained first */
+	zassert_equal(msgqueue_handler_74_count, 2);
+	zassert_equal(msgqueue_handler_74_order[0], 1);
+	zassert_equal(msgqueue_handler_74_order[1], 0);
+
+	msgqueue_response_pop(0, &rsp);
+	zassert_equal(rsp.data[1], 0);
+	msgqueue_response_pop(1, &rsp);
+	zassert_equal(rsp.data[1], 1);
+
+	msgqueue_set_priority(0, 0);
+	msgqueue_set_priority(1, 1);
+}
+
+static uint8_t msgqueue_handler_75(const union request *req, struct response *rsp)
+{
+	/* Burn through the handler deadline */
+	timer_counter += CONFIG_TT_BH_ARC_MSGQUEUE_HANDLER_DEADLINE_US * WAIT_1US + 1;
+	return msgqueue_handler_74(req, rsp);
+}
+
+ZTEST(msgqueue, test_msgqueue_handler_deadline)
+{
+	union request req = {0};
+	struct response rsp = {0};
+	uint16_t overruns = msgqueue_handler_overrun_count(0x75);
+
+	if (NUM_MSG_QUEUES < 2) {
+		ztest_test_skip();
+	}
+
+	msgqueue_register_handler(0x74, msgqueue_handler_74);
+	msgqueue_register_handler(0x75, msgqueue_handler_75);
+	msgqueue_handler_74_count = 0;
+	msgqueue_set_priority(0, 0);
+	msgqueue_set_priority(1, 1);
+
+	req.data[0] = 0x75;
+	req.data[1] = 0;
+	msgqueue_request_push(0, &req);
+	req.data[1] = 1;
+	msgqueue_request_push(0, &req);
+	req.data[0] = 0x74;
+	req.data[1] = 2;
+	msgqueue_request_push(1, &req);
+	process_message_queues();
+
+	/* The slow handler on queue 0 must let queue 1 run before the rest of queue 0 */
+	zassert_equal(msgqueue_handler_74_count, 3);
+	zassert_equal(msgqueue_handler_74_order[0], 0);
+	zassert_equal(msgqueue_handler_74_order[1], 2);
+	zassert_equal(msgqueue_handler_74_order[2], 1);
+	zassert_equal(msgqueue_handler_overrun_count(0x75), overruns + 2);
+
+	msgqueue_response_pop(0, &rsp);
+	msgqueue_response_pop(0, &rsp);
+	msgqueue_response_pop(1, &rsp);
+}
+
+static msgqueue_token_t msgqueue_handler_76_token;
+
+static int msgqueue_handler_76(const union request *req, struct response *rsp,
+			       msgqueue_token_t token)
+{
+	msgqueue_handler_76_token = token;
+	return -EINPROGRESS;
+}
+
+ZTEST(msgqueue, test_msgqueue_async_handler)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	msgqueue_register_handler(0x74, msgqueue_handler_74);
+	msgqueue_register_async_handler(0x76, msgqueue_handler_76);
+	msgqueue_handler_74_count = 0;
+
+	req.data[0] = 0x76;
+	msgqueue_request_push(0, &req);
+	req.data[0] = 0x74;
+	req.data[1] = 0x1234;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+
+	/* The request behind the pending one must still run */
+	zassert_equal(msgqueue_handler_74_count, 1);
+
+	rsp.data[1] = 0x5678;
+	zassert_equal(msgqueue_complete(msgqueue_handler_76_token, &rsp, 3), 0);
+	zassert_equal(msgqueue_complete(msgqueue_handler_76_token, &rsp, 3), -EINVAL);
+	process_message_queues();
+
+	/* Responses are returned in request order */
+	msgqueue_response_pop(0, &rsp);
+	zassert_equal(rsp.data[0], 3);
+	zassert_equal(rsp.data[1], 0x5678);
+	msgqueue_response_pop(0, &rsp);
+	zassert_equal(rsp.data[0], 0);
+	zassert_equal(rsp.data[1], 0x1234);
+}
+
+/* Spends req->data[1] refclk cycles and returns req->data[2] as the exit code */
+static uint8_t msgqueue_handler_77(const union request *req, struct response *rsp)
+{
+	timer_counter += req->data[1];
+	return req->data[2];
+}
+
+static uint8_t send_msg(uint32_t msg_code, uint32_t cycles, uint8_t exit_code)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	req.data[0] = msg_code;
+	req.data[1] = cycles;
+	req.data[2] = exit_code;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	return rsp.data[0] & 0xff;
+}
+
+/* Message stats table, found through the message queue info block like the host does */
+static const struct msgqueue_stats *get_msg_stats(void)
+{
+	const uint32_t *info = (const uint32_t *)(uintptr_t)msg_q_info_addr;
+
+	zassert_not_null(info);
+	zassert_equal(info[1], MSG_QUEUE_SIZE | (NUM_MSG_QUEUES << 8));
+	zassert_not_equal(info[2], 0);
+
+	return (const struct msgqueue_stats *)(uintptr_t)info[2];
+}
+
+static const struct msgqueue_stats_entry *find_msg_stats(const struct msgqueue_stats *stats,
+							  uint32_t msg_code)
+{
+	const struct msgqueue_stats_entry *entries = (const void *)(stats + 1);
+
+	for (uint32_t i = 0; i < stats->num_entries; i++) {
+		if (entries[i].count != 0 && entries[i].msg_code == msg_code) {
+			return &entries[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void check_msg_stats_header(const struct msgqueue_stats *stats)
+{
+	zassert_equal(stats->version, MSG_STATS_VERSION);
+	zassert_equal(stats->num_entries, CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES);
+	zassert_equal(stats->hist_buckets, MSG_STATS_HIST_BUCKETS);
+	zassert_equal(stats->hist_min_log2, MSG_STATS_HIST_MIN_LOG2);
+	zassert_equal(stats->dropped, 0);
+}
+
+ZTEST(msgqueue, test_msg_type_reset_msg_stats)
+{
+	const struct msgqueue_stats *stats;
+	const struct msgqueue_stats_entry *entry;
+	const struct msgqueue_stats_entry *entries;
+
+	if (CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES == 0) {
+		ztest_test_skip();
+	}
+
+	/* Publishes the info block and starts from empty stats */
+	msg_q_info_addr = 0;
+	init_msgqueue();
+	stats = get_msg_stats();
+	check_msg_stats_header(stats);
+	zassert_is_null(find_msg_stats(stats, 0x77));
+
+	msgqueue_register_handler(0x77, msgqueue_handler_77);
+
+	/* Each handler run takes one cycle more than it spends, for the timestamp read */
+	zassert_equal(send_msg(0x77, 31, 0), 0);
+	zassert_equal(send_msg(0x77, 1023, 5), 5);
+	zassert_equal(send_msg(0x77, 31, 0), 0);
+	/* No handler is registered for 0x7f */
+	zassert_equal(send_msg(0x7f, 0, 0), 0xff);
+
+	entry = find_msg_stats(stats, 0x77);
+	zassert_not_null(entry);
+	zassert_equal(entry->count, 3);
+	zassert_equal(entry->errors, 1);
+	zassert_equal(entry->max_cycles, 1024);
+	for (uint32_t i = 0; i < MSG_STATS_HIST_BUCKETS; i++) {
+		/* 32 cycles land in bucket 1, 1024 cycles in bucket 6 */
+		uint32_t expect = (i == 1) ? 2 : (i == 6) ? 1 : 0;
+
+		zassert_equal(entry->hist[i], expect, "bucket %u: %u", i, entry->hist[i]);
+	}
+
+	entry = find_msg_stats(stats, 0x7f);
+	zassert_not_null(entry);
+	zassert_equal(entry->count, 1);
+	zassert_equal(entry->errors, 1);
+	zassert_equal(entry->max_cycles, 0);
+	zassert_equal(entry->hist[0], 1);
+
+	zassert_equal(send_msg(TT_SMC_MSG_RESET_MSG_STATS, 0, 0), 0);
+
+	/* Only the reset message itself has been counted since */
+	check_msg_stats_header(stats);
+	entries = (const void *)(stats + 1);
+	zassert_equal(entries[0].msg_code, TT_SMC_MSG_RESET_MSG_STATS);
+	zassert_equal(entries[0].count, 1);
+	zassert_equal(entries[0].errors, 0);
+	for (uint32_t i = 1; i < stats->num_entries; i++) {
+		zassert_equal(entries[i].msg_code, 0);
+		zassert_equal(entries[i].count, 0);
+		zassert_equal(entries[i].errors, 0);
+		zassert_equal(entries[i].max_cycles, 0);
+		for (uint32_t j = 0; j < MSG_STATS_HIST_BUCKETS; j++) {
+			zassert_equal(entries[i].hist[j], 0);
+		}
+	}
+}
+
+ZTEST(msgqueue, test_msgqueue_async_handler_stats)
+{
+	union request req = {0};
+	struct response rsp = {0};
+	const struct msgqueue_stats *stats;
+	const struct msgqueue_stats_entry *entry;
+
+	if (CONFIG_TT_BH_ARC_MSG_STATS_ENTRIES == 0) {
+		ztest_test_skip();
+	}
+
+	init_msgqueue();
+	stats = get_msg_stats();
+	msgqueue_register_async_handler(0x76, msgqueue_handler_76);
+
+	req.data[0] = 0x76;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+
+	/* Nothing is recorded while the request is pending */
+	zassert_is_null(find_msg_stats(stats, 0x76));
+
+	timer_counter += 1000;
+	zassert_equal(msgqueue_complete(msgqueue_handler_76_token, NULL, 3), 0);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+	zassert_equal(rsp.data[0], 3);
+
+	/* The exit code and latency are those of the completion, not of the dispatch */
+	entry = find_msg_stats(stats, 0x76);
+	zassert_not_null(entry);
+	zassert_equal(entry->count, 1);
+	zassert_equal(entry->errors, 1);
+	zassert_true(entry->max_cycles > 1000, "max_cycles %u", entry->max_cycles);
+}
+
+ZTEST(msgqueue, test_msg_type_telemetry_stream)
+{
+	union request req = {0};
+	struct response rsp = {0};
+
+	/* A buffer too small for the telemetry block is rejected, and its size is returned */
+	req.telemetry_stream.command_code = TT_SMC_MSG_TELEMETRY_STREAM;
+	req.telemetry_stream.period_ms = 100;
+	req.telemetry_stream.buffer_size = 4;
+	req.telemetry_stream.host_addr_lo = 0x1000;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[0], EINVAL);
+	zassert_true(rsp.data[1] > req.telemetry_stream.buffer_size);
+
+	/* Stopping the stream needs no buffer */
+	req.telemetry_stream.period_ms = 0;
+	req.telemetry_stream.buffer_size = 0;
+	req.telemetry_stream.host_addr_lo = 0;
+	msgqueue_request_push(0, &req);
+	process_message_queues();
+	msgqueue_response_pop(0, &rsp);
+
+	zassert_equal(rsp.data[0], 0);
+}
+
 ZTEST(msgqueue, test_msgqueue_power_settings_cmd)
 {
 	const struct device *pll4 = DEVICE_DT_GET_OR_NULL(DT_NODELABEL(pll4));
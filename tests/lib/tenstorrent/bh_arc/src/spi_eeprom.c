@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <zephyr/drivers/flash.h>
+#include <zephyr/ztest.h>
+
+#define TEST_SECTORS    3
+#define SPI_SECTOR_SIZE 4096
+#define SPI_PAGE_SIZE   256
+
+void EepromSetup(void);
+uint32_t SpiDiffPages(uint32_t off, const uint8_t *old, const uint8_t *new, uint32_t len,
+		      bool *erase);
+int SpiWriteSectors(uint32_t addr, const uint8_t *data, uint32_t num_sectors);
+int SpiSmartWrite(uint32_t address, const uint8_t *data, uint32_t num_bytes);
+
+static const struct device *flash = DEVICE_DT_GET(DT_NODELABEL(spi_flash));
+
+static uint8_t old_data[TEST_SECTORS * SPI_SECTOR_SIZE];
+static uint8_t new_data[TEST_SECTORS * SPI_SECTOR_SIZE];
+static uint8_t expected[TEST_SECTORS * SPI_SECTOR_SIZE];
+static uint8_t read_back[TEST_SECTORS * SPI_SECTOR_SIZE];
+static uint32_t test_addr;
+
+static void fill(uint8_t *buf, uint32_t len, uint8_t seed)
+{
+	for (uint32_t i = 0; i < len; i++) {
+		buf[i] = (uint8_t)(i * 7 + seed);
+	}
+}
+
+static void *spi_eeprom_setup(void)
+{
+	struct flash_pages_info info;
+
+	zassert_true(device_is_ready(flash));
+	EepromSetup();
+
+	zassert_ok(flash_get_page_info_by_offs(flash, 0, &info));
+	zassert_equal(info.size, SPI_SECTOR_SIZE, "unexpected sector size %zu", info.size);
+
+	/* Stay clear of the boot filesystem at the start of flash */
+	test_addr = (flash_get_page_count(flash) - TEST_SECTORS) * SPI_SECTOR_SIZE;
+
+	return NULL;
+}
+
+static void spi_eeprom_before(void *fixture)
+{
+	zassert_ok(flash_erase(flash, test_addr, sizeof(read_back)));
+}
+
+static void check_flash(const uint8_t *want, uint32_t len)
+{
+	zassert_ok(flash_read(flash, test_addr, read_back, len));
+	zassert_mem_equal(read_back, want, len);
+}
+
+ZTEST(spi_eeprom, test_diff_pages)
+{
+	bool erase = false;
+
+	memset(old_data, 0xFF, SPI_SECTOR_SIZE);
+	memcpy(new_data, old_data, SPI_SECTOR_SIZE);
+
+	zassert_equal(SpiDiffPages(0, old_data, new_data, SPI_SECTOR_SIZE, &erase), 0);
+	zassert_false(erase);
+
+	/* Clearing bits only needs the page to be programmed */
+	new_data[2 * SPI_PAGE_SIZE + 5] = 0x0F;
+	new_data[7 * SPI_PAGE_SIZE] = 0x00;
+	zassert_equal(SpiDiffPages(0, old_data, new_data, SPI_SECTOR_SIZE, &erase),
+		      BIT(2) | BIT(7));
+	zassert_false(erase);
+
+	/* Setting a bit that flash has cleared needs an erase */
+	old_data[9 * SPI_PAGE_SIZE + 1] = 0xF0;
+	new_data[9 * SPI_PAGE_SIZE + 1] = 0xF1;
+	zassert_equal(SpiDiffPages(0, old_data, new_data, SPI_SECTOR_SIZE, &erase),
+		      BIT(2) | BIT(7) | BIT(9));
+	zassert_true(erase);
+
+	/* Pages are numbered from the start of the sector, not of the range */
+	erase = false;
+	zassert_equal(SpiDiffPages(SPI_PAGE_SIZE + 10, &old_data[SPI_PAGE_SIZE + 10],
+				   &new_data[SPI_PAGE_SIZE + 10], 2 * SPI_PAGE_SIZE, &erase),
+		      BIT(2));
+	zassert_false(erase);
+}
+
+ZTEST(spi_eeprom, test_write_sectors_aligned)
+{
+	fill(old_data, sizeof(old_data), 1);
+	zassert_ok(SpiWriteSectors(test_addr, old_data, TEST_SECTORS));
+	check_flash(old_data, sizeof(old_data));
+
+	/* Sets bits in every sector, so all of them are erased first */
+	fill(new_data, sizeof(new_data), 2);
+	zassert_ok(SpiWriteSectors(test_addr, new_data, TEST_SECTORS));
+	check_flash(new_data, sizeof(new_data));
+
+	/* Rewriting the same data is a no-op */
+	zassert_ok(SpiWriteSectors(test_addr, new_data, TEST_SECTORS));
+	check_flash(new_data, sizeof(new_data));
+}
+
+ZTEST(spi_eeprom, test_write_sectors_skips_erase)
+{
+	fill(old_data, sizeof(old_data), 3);
+	zassert_ok(SpiWriteSectors(test_addr, old_data, TEST_SECTORS));
+
+	/* Only clear bits, in one page of the first sector and the whole of the last one */
+	memcpy(new_data, old_data, sizeof(new_data));
+	for (uint32_t i = SPI_PAGE_SIZE; i < 2 * SPI_PAGE_SIZE; i++) {
+		new_data[i] &= 0x55;
+	}
+	for (uint32_t i = 2 * SPI_SECTOR_SIZE; i < sizeof(new_data); i++) {
+		new_data[i] &= 0xAA;
+	}
+
+	/* No sector needs an erase, see test_diff_pages. The flash simulator only clears bits when
+	 * programming, as NOR flash does, so the changed pages are programmed over the old data.
+	 */
+	zassert_ok(SpiWriteSectors(test_addr, new_data, TEST_SECTORS));
+	check_flash(new_data, sizeof(new_data));
+}
+
+ZTEST(spi_eeprom, test_smart_write_unaligned)
+{
+	const uint32_t head = 100;
+	const uint32_t len = 2 * SPI_SECTOR_SIZE;
+
+	fill(old_data, sizeof(old_data), 4);
+	zassert_ok(SpiSmartWrite(test_addr, old_data, sizeof(old_data)));
+	check_flash(old_data, sizeof(old_data));
+
+	/* A partial head sector, a whole sector and a partial tail sector */
+	fill(new_data, len, 5);
+	zassert_ok(SpiSmartWrite(test_addr + head, new_data, len));
+
+	memcpy(expected, old_data, sizeof(old_data));
+	memcpy(&expected[head], new_data, len);
+	check_flash(expected, sizeof(old_data));
+}
+
+ZTEST(spi_eeprom, test_smart_write_within_sector)
+{
+	const uint32_t off = SPI_PAGE_SIZE - 10;
+	const uint32_t len = 20;
+
+	fill(old_data, SPI_SECTOR_SIZE, 6);
+	zassert_ok(SpiSmartWrite(test_addr, old_data, SPI_SECTOR_SIZE));
+
+	/* Straddles two pages, and both head and tail of the write are unaligned */
+	fill(new_data, len, 7);
+	zassert_ok(SpiSmartWrite(test_addr + off, new_data, len));
+
+	memcpy(expected, old_data, SPI_SECTOR_SIZE);
+	memcpy(&expected[off], new_data, len);
+	check_flash(expected, SPI_SECTOR_SIZE);
+}
+
+ZTEST_SUITE(spi_eeprom, NULL, spi_eeprom_setup, spi_eeprom_before, NULL, NULL);
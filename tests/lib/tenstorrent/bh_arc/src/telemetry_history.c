@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 Tenstorrent AI ULC
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#include "telemetry_history.h"
+
+/* Header words of the history descriptor, as seen by the host */
+enum {
+	HISTORY_VERSION,
+	HISTORY_SAMPLE_SIZE,
+	HISTORY_NUM_SAMPLES,
+	HISTORY_PERIOD_MS,
+	HISTORY_COUNT,
+	HISTORY_HEADER_WORDS,
+};
+
+extern void AppendTelemetryHistory(const struct telemetry_history_sample *sample);
+
+ZTEST(telemetry_history, test_telemetry_history_wrap)
+{
+	volatile uint32_t *header = (uint32_t *)GetTelemetryHistoryAddr();
+	struct telemetry_history_sample *samples =
+		(struct telemetry_history_sample *)&header[HISTORY_HEADER_WORDS];
+	uint32_t num_samples = header[HISTORY_NUM_SAMPLES];
+	uint32_t start = header[HISTORY_COUNT];
+
+	zassert_equal(header[HISTORY_VERSION], TELEMETRY_HISTORY_VERSION);
+	zassert_equal(header[HISTORY_SAMPLE_SIZE], sizeof(struct telemetry_history_sample));
+	zassert_equal(num_samples, CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_SAMPLES);
+	zassert_equal(header[HISTORY_PERIOD_MS], CONFIG_TT_BH_ARC_TELEMETRY_HISTORY_PERIOD_MS);
+
+	/* Overrun the ring so that the oldest samples are overwritten */
+	for (uint32_t i = 0; i < num_samples + 3; i++) {
+		struct telemetry_history_sample sample = {
+			.timestamp = start + i,
+			.vcore = i & 0xFFFF,
+		};
+
+		AppendTelemetryHistory(&sample);
+	}
+
+	zassert_equal(header[HISTORY_COUNT], start + num_samples + 3);
+
+	for (uint32_t n = start + 3; n < start + num_samples + 3; n++) {
+		zassert_equal(samples[n % num_samples].timestamp, n);
+		zassert_equal(samples[n % num_samples].vcore, (n - start) & 0xFFFF);
+	}
+}
+
+ZTEST_SUITE(telemetry_history, NULL, NULL, NULL, NULL, NULL);
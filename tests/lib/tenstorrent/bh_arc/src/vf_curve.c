@@ -9,6 +9,12 @@
 #include <tenstorrent/msgqueue.h>
 #include <stdlib.h>
 
+#include "aiclk_ppm.h"
+#include "vf_curve.h"
+#include "voltage.h"
+
+int LoadVFCurvePoints(const struct vf_curve_file *file);
+
 ZTEST(vf_curve, test_get_freq_curve_from_voltage_handler)
 {
 	union request req = {0};
@@ -79,4 +85,115 @@ ZTEST(vf_curve, test_voltage_frequency_roundtrip)
 	zassert_true(abs(freq_diff) < 50, "Roundtrip frequency error too large: %d", freq_diff);
 }
 
+ZTEST(vf_curve, test_vf_curve_matches_reference)
+{
+	/* The fixed-point lookup table must track the float quadratic across the AICLK range */
+	for (uint32_t freq = 200; freq <= 1400; freq++) {
+		float voltage = DVFS_NUM_TO_FLOAT(VFCurve(freq));
+		float reference = VFCurveReference(freq);
+
+		zassert_within(voltage, reference, 0.05f, "%u MHz: %d mV vs %d mV", freq,
+			       (int)voltage, (int)reference);
+	}
+}
+
+ZTEST(vf_curve, test_max_aiclk_for_voltage_matches_search)
+{
+	uint32_t fmin = GetAiclkFmin();
+	uint32_t fmax = GetAiclkFmax();
+
+	/* The F/V table must give the highest frequency whose voltage fits, for every voltage */
+	for (uint32_t voltage = 500; voltage <= 1100; voltage++) {
+		uint32_t expected = fmin - 1;
+
+		for (uint32_t freq = fmin; freq <= fmax; freq++) {
+			if (VFCurve(freq) <= DVFS_NUM_FROM_INT(voltage)) {
+				expected = freq;
+			}
+		}
+
+		zassert_equal(GetMaxAiclkForVoltage(voltage), expected, "%u mV", voltage);
+	}
+}
+
 ZTEST_SUITE(vf_curve, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(vf_curve_pwl, test_load_rejects_malformed_curve)
+{
+	struct vf_curve_file file = {
+		.version = VF_CURVE_VERSION,
+		.num_points = 3,
+		.points = {{400, 700}, {800, 750}, {800, 800}},
+	};
+
+	zassert_equal(LoadVFCurvePoints(&file), -EINVAL, "duplicate frequency accepted");
+
+	file.points[2] = (struct vf_curve_point){1200, 740};
+	zassert_equal(LoadVFCurvePoints(&file), -EINVAL, "decreasing voltage accepted");
+
+	file.points[2] = (struct vf_curve_point){1200, 900};
+	file.num_points = 1;
+	zassert_equal(LoadVFCurvePoints(&file), -EINVAL, "single point accepted");
+
+	file.num_points = VF_CURVE_MAX_POINTS + 1;
+	zassert_equal(LoadVFCurvePoints(&file), -EINVAL, "too many points accepted");
+
+	file.num_points = 3;
+	file.version = VF_CURVE_VERSION + 1;
+	zassert_equal(LoadVFCurvePoints(&file), -EINVAL, "unknown version accepted");
+}
+
+ZTEST(vf_curve_pwl, test_load_rejects_out_of_range_voltage)
+{
+	struct vf_curve_file file = {
+		.version = VF_CURVE_VERSION,
+		.num_points = 3,
+		.points = {{400, VDD_MIN - 1}, {800, 750}, {1200, 800}},
+	};
+	dvfs_num_t builtin_mv = VFCurve(800);
+
+	zassert_equal(LoadVFCurvePoints(&file), -ERANGE, "voltage below VDD_MIN accepted");
+
+	file.points[0].voltage_mv = VDD_MIN;
+	file.points[2].voltage_mv = VDD_MAX + 1;
+	zassert_equal(LoadVFCurvePoints(&file), -ERANGE, "voltage above VDD_MAX accepted");
+
+	/* The built-in curve is still in use */
+	zassert_equal(VFCurve(800), builtin_mv);
+
+	file.points[2].voltage_mv = VDD_MAX;
+	zassert_ok(LoadVFCurvePoints(&file), "voltages at the regulator limits rejected");
+}
+
+ZTEST(vf_curve_pwl, test_load_piecewise_linear_curve)
+{
+	struct vf_curve_file file = {
+		.version = VF_CURVE_VERSION,
+		.num_points = 3,
+		.points = {{400, 700}, {800, 750}, {1200, 900}},
+	};
+
+	zassert_ok(LoadVFCurvePoints(&file));
+
+	/* Interpolated within the segments and extrapolated beyond the end points */
+	zassert_within(DVFS_NUM_TO_FLOAT(VFCurve(400)), 700.0f, 0.05f);
+	zassert_within(DVFS_NUM_TO_FLOAT(VFCurve(600)), 725.0f, 0.05f);
+	zassert_within(DVFS_NUM_TO_FLOAT(VFCurve(1000)), 825.0f, 0.05f);
+	zassert_within(DVFS_NUM_TO_FLOAT(VFCurve(200)), 675.0f, 0.05f);
+	zassert_within(DVFS_NUM_TO_FLOAT(VFCurve(1400)), 975.0f, 0.05f);
+
+	zassert_equal(GetMaxAiclkForVoltage(750), 800);
+	zassert_equal(GetMaxAiclkForVoltage(825), 1000);
+	zassert_equal(GetMaxAiclkForVoltage(2000), GetAiclkFmax());
+	zassert_equal(GetMaxAiclkForVoltage(600), GetAiclkFmin() - 1);
+}
+
+static void vf_curve_pwl_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Back to the default quadratic for the other suites */
+	InitVFCurve();
+}
+
+ZTEST_SUITE(vf_curve_pwl, NULL, NULL, NULL, vf_curve_pwl_after, NULL);
@@ -18,6 +18,21 @@ static struct bh_chip test_chip = {.config = {
 					   .pgood = GPIO_DT_SPEC_GET(DT_PATH(pgood), gpios),
 				   }};
 
+static struct bh_chip test_chips[] = {
+	{.config = {
+		 .jtag = DEVICE_DT_GET(DT_PATH(jtag)),
+		 .asic_reset = GPIO_DT_SPEC_GET(DT_PATH(mcureset), gpios),
+		 .spi_reset = GPIO_DT_SPEC_GET(DT_PATH(spireset), gpios),
+		 .pgood = GPIO_DT_SPEC_GET(DT_PATH(pgood), gpios),
+	 }},
+	{.config = {
+		 .jtag = DEVICE_DT_GET(DT_PATH(jtag1)),
+		 .asic_reset = GPIO_DT_SPEC_GET(DT_PATH(mcureset1), gpios),
+		 .spi_reset = GPIO_DT_SPEC_GET(DT_PATH(spireset1), gpios),
+		 .pgood = GPIO_DT_SPEC_GET(DT_PATH(pgood1), gpios),
+	 }},
+};
+
 ZTEST(jtag_bootrom, test_jtag_bootrom)
 {
 	const uint32_t *const patch = (const uint32_t *)get_bootcode();
@@ -27,6 +42,143 @@ ZTEST(jtag_bootrom, test_jtag_bootrom)
 	zassert_ok(jtag_bootrom_verify(test_chip.config.jtag, patch, patch_len));
 }
 
+ZTEST(jtag_bootrom, test_jtag_bootrom_throughput)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_JTAG_EMUL);
+
+	const struct device *jtag = test_chip.config.jtag;
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+	size_t tcks = jtag_emul_tck_count(jtag);
+	uint32_t writes = jtag_emul_gpio_writes();
+	uint32_t start = k_cycle_get_32();
+
+	zassert_ok(jtag_bootrom_patch(&test_chip, patch, patch_len));
+
+	uint32_t us = MAX(k_cyc_to_us_floor32(k_cycle_get_32() - start), 1);
+
+	tcks = jtag_emul_tck_count(jtag) - tcks;
+	writes = jtag_emul_gpio_writes() - writes;
+	zassert_true(tcks > 0);
+
+	TC_PRINT("%s: %zu TCK cycles, %u GPIO writes in %u us, %llu kHz\n",
+		 IS_ENABLED(CONFIG_JTAG_BITBANG_BATCHED) ? "batched" : "per pin", tcks, writes, us,
+		 (uint64_t)tcks * 1000 / us);
+
+	/* Per pin, each bit writes TMS, TDI and both edges of TCK. Batched, it takes two port
+	 * writes, plus one to leave TCK low after each TMS or shift sequence.
+	 */
+	if (IS_ENABLED(CONFIG_JTAG_BITBANG_BATCHED)) {
+		zassert_true(writes >= 2 * tcks && writes < 3 * tcks, "%u writes for %zu TCKs",
+			     writes, tcks);
+	} else {
+		zassert_true(writes >= 4 * tcks, "%u writes for %zu TCKs", writes, tcks);
+	}
+}
+
+ZTEST(jtag_bootrom, test_jtag_axi_block_write_failure)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_JTAG_EMUL);
+
+	const struct device *jtag = test_chip.config.jtag;
+	const uint32_t fail_idx = 5;
+	uint32_t sram[16] = {0};
+	uint32_t block[12];
+	uint32_t value = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(block); i++) {
+		block[i] = 0x1000 + i;
+	}
+
+	jtag_emul_setup(jtag, sram, ARRAY_SIZE(sram));
+	jtag_emul_fail_axi_write(jtag, fail_idx * sizeof(uint32_t));
+
+	zassert_not_ok(jtag_axi_block_write(jtag, 0, block, ARRAY_SIZE(block)));
+	zassert_mem_equal(sram, block, fail_idx * sizeof(uint32_t));
+	zassert_equal(sram[fail_idx], 0);
+
+	/* The TAP is left ready for the next access */
+	zassert_ok(jtag_axi_write32(jtag, 14 * sizeof(uint32_t), 0xdeadbeef));
+	zassert_equal(sram[14], 0xdeadbeef);
+	zassert_ok(jtag_axi_read32(jtag, 2 * sizeof(uint32_t), &value));
+	zassert_equal(value, block[2]);
+
+	jtag_emul_setup(jtag, NULL, 0);
+}
+
+ZTEST(jtag_bootrom, test_jtag_axi_block_write_multi)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_JTAG_EMUL);
+
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+	const struct device *devs[ARRAY_SIZE(test_chips)];
+	uint32_t *sram[ARRAY_SIZE(test_chips)];
+	int rets[ARRAY_SIZE(test_chips)];
+
+	for (size_t i = 0; i < ARRAY_SIZE(test_chips); i++) {
+		devs[i] = test_chips[i].config.jtag;
+		sram[i] = calloc(patch_len, sizeof(uint32_t));
+		zassert_not_null(sram[i]);
+
+		zassert_ok(jtag_setup(devs[i]));
+		zassert_ok(jtag_reset(devs[i]));
+		jtag_emul_setup(devs[i], sram[i], patch_len);
+	}
+
+	/* Both chips share a GPIO port, so with batching they are clocked together */
+	zassert_ok(jtag_axi_block_write_multi(devs, ARRAY_SIZE(devs), 0, patch, patch_len, rets));
+
+	for (size_t i = 0; i < ARRAY_SIZE(test_chips); i++) {
+		zassert_ok(rets[i]);
+		zassert_mem_equal(sram[i], patch, patch_len * sizeof(uint32_t));
+		zassert_equal(jtag_emul_tck_count(devs[i]), jtag_emul_tck_count(devs[0]));
+
+		jtag_emul_setup(devs[i], NULL, 0);
+		jtag_teardown(devs[i]);
+		free(sram[i]);
+	}
+}
+
+ZTEST(jtag_bootrom, test_jtag_bootrom_reset_sequence_all)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_JTAG_EMUL);
+	Z_TEST_SKIP_IFNDEF(CONFIG_JTAG_VERIFY_WRITE);
+
+	const uint32_t *const patch = (const uint32_t *)get_bootcode();
+	const size_t patch_len = get_bootcode_len();
+	/* The reset sequence loads the bootcode at 0x80 */
+	const size_t offset = 0x80 / sizeof(uint32_t);
+	/* The second chip is too small to hold all of it, so that its verification fails */
+	const size_t sram_len[] = {offset + patch_len, offset + patch_len / 2};
+	uint32_t *sram[ARRAY_SIZE(test_chips)];
+	int rets[ARRAY_SIZE(test_chips)];
+
+	for (size_t i = 0; i < ARRAY_SIZE(test_chips); i++) {
+		sram[i] = calloc(sram_len[i], sizeof(uint32_t));
+		zassert_not_null(sram[i]);
+
+		zassert_ok(jtag_bootrom_init(&test_chips[i]));
+		jtag_emul_setup(test_chips[i].config.jtag, sram[i], sram_len[i]);
+	}
+
+	zassert_equal(jtag_bootrom_reset_sequence_all(test_chips, ARRAY_SIZE(test_chips), false,
+						      rets),
+		      -EIO);
+
+	/* The failure of the second chip does not affect the first */
+	zassert_ok(rets[0]);
+	zassert_mem_equal(&sram[0][offset], patch, patch_len * sizeof(uint32_t));
+	zassert_false(test_chips[0].data.bringup_failed);
+	zassert_equal(rets[1], -EIO);
+	zassert_true(test_chips[1].data.bringup_failed);
+
+	for (size_t i = 0; i < ARRAY_SIZE(test_chips); i++) {
+		jtag_emul_setup(test_chips[i].config.jtag, NULL, 0);
+		free(sram[i]);
+	}
+}
+
 static void before(void *arg)
 {
 	ARG_UNUSED(arg);
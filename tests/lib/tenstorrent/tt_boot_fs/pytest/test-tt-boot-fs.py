@@ -7,9 +7,11 @@ import logging
 import os
 import pykwalify.core
 import requests
+import struct
 import sys
 import tarfile
 import yaml
+import zlib
 
 from pathlib import Path
 from urllib.request import urlretrieve
@@ -263,6 +265,60 @@ def test_tt_boot_fs_cksum():
         assert tt_boot_fs.cksum(it[1]) == it[0]
 
 
+def test_tt_boot_fs_crc32_descriptors():
+    """
+    Test that a tt_boot_fs with CRC-32 image checksums round-trips, and that its descriptors keep
+    the additive checksum that the boot ROM checks them with.
+    """
+
+    image_A = b"\x73\x73\x42\x42"
+    image_B = b"\x73\x73\x42\x42\x37\x37\x24\x24"
+    entries = {
+        "imageA": tt_boot_fs.FsEntry(
+            False, "imageA", image_A, tt_boot_fs.IMAGE_ADDR, 0x1000000, True, crc32=True
+        ),
+        "imageB": tt_boot_fs.FsEntry(
+            False,
+            "imageB",
+            image_B,
+            tt_boot_fs.IMAGE_ADDR + TEST_ALIGNMENT,
+            0,
+            False,
+            crc32=True,
+        ),
+    }
+    failover = tt_boot_fs.FsEntry(
+        False,
+        "failover",
+        image_A,
+        tt_boot_fs.IMAGE_ADDR + 2 * TEST_ALIGNMENT,
+        0x1000000,
+        True,
+        crc32=True,
+    )
+    data = tt_boot_fs.BootFs(["imageA", "imageB"], entries, failover).to_binary(True)
+
+    fd_addrs = [0, tt_boot_fs.FD_SIZE, tt_boot_fs.FAILOVER_HEAD_ADDR]
+    for addr, image in zip(fd_addrs, [image_A, image_B, image_A]):
+        words = struct.unpack_from(f"<{tt_boot_fs.FD_SIZE // 4}I", data, addr)
+        # What the boot ROM checks: the sum of every word before fd_crc
+        assert words[-1] == sum(words[:-1]) & 0xFFFFFFFF
+        fd = tt_boot_fs.read_fd(lambda a, n: data[a : a + n], addr)
+        assert fd.data_crc == zlib.crc32(image)
+
+    fs = tt_boot_fs.BootFs.from_binary(data, crc32=True)
+    assert fs.entries["imageA"].data == image_A
+    assert fs.entries["imageB"].data == image_B
+    assert fs.to_binary(True) == data
+
+    # Images checksummed with CRC-32 do not pass the additive check
+    try:
+        tt_boot_fs.BootFs.from_binary(data)
+        assert False, "CRC-32 images passed the additive checksum"
+    except ValueError:
+        pass
+
+
 def test_tt_boot_fs_ls(tmp_path: Path):
     """
     Test the ability to list a tt_boot_fs.
@@ -61,8 +61,7 @@ static void *setup_bootfs(void)
 		 sizeof(image_C));
 
 	for (size_t i = 0; i < 3; ++i) {
-		fds[i].fd_crc = tt_boot_fs_cksum(0, (uint8_t *)&fds[i],
-						 sizeof(tt_boot_fs_fd) - sizeof(fds[i].fd_crc));
+		fds[i].fd_crc = tt_boot_fs_fd_cksum(&fds[i]);
 	}
 
 	uint32_t erase_size =
@@ -83,8 +82,7 @@ static void *setup_bootfs(void)
 	tt_boot_fs_fd invalid_fd = {0};
 
 	invalid_fd.flags.f.invalid = 1;
-	invalid_fd.fd_crc = tt_boot_fs_cksum(0, (uint8_t *)&invalid_fd,
-					     sizeof(tt_boot_fs_fd) - sizeof(invalid_fd.fd_crc));
+	invalid_fd.fd_crc = tt_boot_fs_fd_cksum(&invalid_fd);
 	rc = flash_write(FLASH_DEVICE, TT_BOOT_FS_FD_HEAD_ADDR + 3 * sizeof(tt_boot_fs_fd),
 			 &invalid_fd, sizeof(tt_boot_fs_fd));
 	zassert_equal(rc, 0, "Failed to write invalid FD to flash");
@@ -99,37 +97,35 @@ static void *setup_bootfs(void)
 	return NULL;
 }
 
-/* all input must be aligned to a 4-byte boundary and be a multiple of 4 bytes */
+/* all input must be aligned to a 4-byte boundary. A partial last word is zero-padded. */
 __aligned(sizeof(uint32_t)) static const uint8_t one_byte[] = {0x42};
-/*
- * __aligned(sizeof(uint32_t)) static const uint8_t two_bytes[] = {
- *   0x42,
- *   0x42,
- * };
- * __aligned(sizeof(uint32_t)) static const uint8_t three_bytes[] = {
- *   0x73,
- *   0x42,
- *   0x42,
- * };
- */
+__aligned(sizeof(uint32_t)) static const uint8_t two_bytes[] = {
+	0x42,
+	0x42,
+};
+__aligned(sizeof(uint32_t)) static const uint8_t three_bytes[] = {
+	0x73,
+	0x42,
+	0x42,
+};
 static const uint32_t four_bytes = 0x42427373;
-/*
- * __aligned(sizeof(uint32_t)) static const uint8_t five_bytes[] = {
- *   0x73, 0x73, 0x42, 0x42, 0x37,
- * };
- * __aligned(sizeof(uint32_t)) static const uint8_t six_bytes[] = {
- *   0x73, 0x73, 0x42, 0x42, 0x37, 0x37,
- * };
- * __aligned(sizeof(uint32_t)) static const uint8_t seven_bytes[] = {
- *   0x73, 0x73, 0x42, 0x42, 0x37, 0x37, 0x24,
- * };
- */
+__aligned(sizeof(uint32_t)) static const uint8_t five_bytes[] = {
+	0x73, 0x73, 0x42, 0x42, 0x37,
+};
+__aligned(sizeof(uint32_t)) static const uint8_t six_bytes[] = {
+	0x73, 0x73, 0x42, 0x42, 0x37, 0x37,
+};
+__aligned(sizeof(uint32_t)) static const uint8_t seven_bytes[] = {
+	0x73, 0x73, 0x42, 0x42, 0x37, 0x37, 0x24,
+};
 static const uint64_t eight_bytes = 0x2424373742427373;
 
 ZTEST(tt_boot_fs, test_tt_boot_fs_cksum)
 {
 	uint32_t cksum;
 
+	Z_TEST_SKIP_IFDEF(CONFIG_TT_BOOT_FS_CHECKSUM_CRC32);
+
 	static const struct harness_data {
 		uint32_t expect;
 		const uint8_t *data;
@@ -137,17 +133,13 @@ ZTEST(tt_boot_fs, test_tt_boot_fs_cksum)
 	} harness[] = {
 		{0, NULL, 0},
 		{0, one_byte, 0},
-		/*
-		 * {0x00000042, one_byte, 1},
-		 * {0x00004242, two_bytes, 2},
-		 * {0x00000073, three_bytes, 3},
-		 */
+		{0x00000042, one_byte, 1},
+		{0x00004242, two_bytes, 2},
+		{0x00424273, three_bytes, 3},
 		{0x42427373, (uint8_t *)&four_bytes, 4},
-		/*
-		 *{0x4284e6e6, five_bytes, 5},
-		 *{0x4242e6e6, six_bytes, 6},
-		 *{0x424273e6, seven_bytes, 7},
-		 */
+		{0x424273aa, five_bytes, 5},
+		{0x4242aaaa, six_bytes, 6},
+		{0x4266aaaa, seven_bytes, 7},
 		{0x6666aaaa, (uint8_t *)&eight_bytes, 8},
 	};
 
@@ -158,6 +150,58 @@ ZTEST(tt_boot_fs, test_tt_boot_fs_cksum)
 	}
 }
 
+ZTEST(tt_boot_fs, test_tt_boot_fs_cksum_incremental)
+{
+	/* 12 words, enough for the unrolled loop */
+	__aligned(sizeof(uint32_t)) static const uint8_t data[48] =
+		"0123456789abcdefghijklmnopqrstuvwxyz0123456789ab";
+	const uint32_t expect =
+		IS_ENABLED(CONFIG_TT_BOOT_FS_CHECKSUM_CRC32) ? 0x52fc96bd : 0x3c2fd5c6;
+	uint32_t cksum;
+
+	cksum = tt_boot_fs_cksum(0, data, sizeof(data));
+	zassert_equal(cksum, expect, "expected: %08x actual: %08x", expect, cksum);
+
+	/* Checksumming in chunks, as images are while they stream from flash, gives the same sum */
+	cksum = tt_boot_fs_cksum(0, data, 20);
+	cksum = tt_boot_fs_cksum(cksum, data + 20, 0);
+	cksum = tt_boot_fs_cksum(cksum, data + 20, sizeof(data) - 20);
+	zassert_equal(cksum, expect, "expected: %08x actual: %08x", expect, cksum);
+}
+
+static int bootfs_test_read(uint32_t addr, uint32_t size, uint8_t *dst)
+{
+	return flash_read(FLASH_DEVICE, addr, dst, size);
+}
+
+/* The boot ROM checks each descriptor against the plain sum of its words, so descriptors must
+ * keep that checksum even when images are checksummed with CRC-32.
+ */
+ZTEST(tt_boot_fs, test_tt_boot_fs_fd_cksum_rom)
+{
+	tt_boot_fs_fd fd;
+	uint32_t words[offsetof(tt_boot_fs_fd, fd_crc) / sizeof(uint32_t)];
+	uint32_t rom_cksum = 0;
+	uint8_t buf[8];
+	size_t file_size;
+
+	zassert_ok(flash_read(FLASH_DEVICE, TT_BOOT_FS_FD_HEAD_ADDR, &fd, sizeof(fd)));
+	zassert_equal(fd.flags.f.invalid, 0);
+
+	memcpy(words, &fd, sizeof(words));
+	for (size_t i = 0; i < ARRAY_SIZE(words); i++) {
+		rom_cksum += words[i];
+	}
+	zassert_equal(fd.fd_crc, rom_cksum, "expected: %08x actual: %08x", rom_cksum, fd.fd_crc);
+	zassert_equal(tt_boot_fs_fd_cksum(&fd), rom_cksum);
+
+	/* And the image behind it still checks out with the configured image checksum */
+	zassert_ok(tt_boot_fs_mount(&boot_fs_data, bootfs_test_read, NULL, NULL));
+	zassert_ok(tt_boot_fs_get_file(&boot_fs_data, fd.image_tag, buf, sizeof(buf),
+				       &file_size));
+	zassert_equal(tt_boot_fs_cksum(0, buf, file_size), fd.data_crc);
+}
+
 #define DECL_TEST_SPEC(d, f, n, o, e)                                                              \
 	(struct test_spec)                                                                         \
 	{                                                                                          \
@@ -255,4 +299,33 @@ ZTEST(tt_boot_fs, test_find_fd_by_tag)
 	}
 }
 
+ZTEST(tt_boot_fs, test_find_fd_by_tag_index)
+{
+	const uint8_t tag_a[8] = "imageA";
+	const uint8_t tag_b[8] = "imageB";
+	const uint8_t tag_failover[8] = "failover";
+	tt_boot_fs_fd fd;
+	int rc;
+
+	tt_boot_fs_invalidate(NULL);
+	zassert_ok(tt_boot_fs_find_fd_by_tag(FLASH_DEVICE, tag_b, &fd));
+	zassert_equal(fd.spi_addr, IMAGE_ADDR + TEST_ALIGNMENT);
+
+	/* Later lookups are served from the index without reading flash */
+	rc = flash_erase(FLASH_DEVICE, TT_BOOT_FS_FD_HEAD_ADDR, 4096);
+	zassert_ok(rc, "Failed to erase test bootfs descriptors");
+
+	zassert_ok(tt_boot_fs_find_fd_by_tag(FLASH_DEVICE, tag_b, &fd));
+	zassert_equal(fd.spi_addr, IMAGE_ADDR + TEST_ALIGNMENT);
+	zassert_ok(tt_boot_fs_find_fd_by_tag(FLASH_DEVICE, tag_failover, NULL));
+
+	/* Until the index is invalidated */
+	tt_boot_fs_invalidate(FLASH_DEVICE);
+	zassert_equal(tt_boot_fs_find_fd_by_tag(FLASH_DEVICE, tag_b, &fd), -ENOENT);
+
+	setup_bootfs();
+	tt_boot_fs_invalidate(FLASH_DEVICE);
+	zassert_ok(tt_boot_fs_find_fd_by_tag(FLASH_DEVICE, tag_a, &fd));
+}
+
 ZTEST_SUITE(tt_boot_fs, NULL, setup_bootfs, NULL, NULL, NULL);